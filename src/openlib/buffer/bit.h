@@ -24,9 +24,10 @@
 
 //-Supporting libraries
 #include "openlib/common.h"
+#include <stddef.h>
 
-#define BYTE2BIT(b) (b*8)
-#define BIT2BYTE(b) (b/8)
+#define BYTE2BIT(b) ((b)*8)
+#define BIT2BYTE(b) ((b)/8)
 
 namespace openlib
 {
@@ -63,6 +64,26 @@ namespace openlib
             return (buffer_ptr[byte_num_local] & (0x01 << bit_num_local)) >> bit_num_local;
         }
 
+        /**
+         * Counts the trailing zero bits of a value
+         * @param value The value (not 0)
+         * @return size_t containing the index of the lowest set bit
+         */
+        inline size_t count_trailing_zeros(uint64_t value)
+        {
+            #if defined(__GNUC__) || defined(__clang__)
+            return (size_t) __builtin_ctzll(value);
+            #else
+            size_t count = 0;
+            while (0 == (value & 0x01) && count < 64)
+            {
+                value >>= 1;
+                ++count;
+            }
+            return count;
+            #endif
+        }
+
     }; /*namespace bit*/
 }; /*namespace openlib*/
 
@@ -28,12 +28,15 @@
 #include "openlib/buffer/bit.h"
 #include "openlib/icd/data_descriptor.h"
 #include "openlib/icd/struct/icd_data_entry.h"
+#include "openlib/icd/struct/icd_field.h"
 #include <algorithm>
 #include <assert.h>
 #include <iomanip>
 #include <iostream>
 #include <stdint.h>
 #include <climits>
+#include <limits>
+#include <string.h>
 
 namespace openlib
 {
@@ -49,6 +52,7 @@ namespace openlib
             ERROR_NULL_PARAMETER	  = 2,   /**< ERROR_NULL_PARAMETER */
             ERROR_NOT_ENOUGH_DATA	  = 3,   /**< ERROR_NOT_ENOUGH_DATA */
             ERROR_CONTAINER_TOO_SMALL = 5,   /**< ERROR_CONTAINER_TOO_SMALL */
+            ERROR_INVALID_LAYOUT      = 6,   /**< ERROR_INVALID_LAYOUT */
         };
 
         /**
@@ -76,6 +80,34 @@ namespace openlib
         template <typename T>
         inline T swap_endian(T value)
         {
+            #if defined(__GNUC__) || defined(__clang__)
+            //-Use the byte swap intrinsics when available (folded at compile time)
+            if (sizeof(T) == sizeof(uint64_t))
+            {
+                uint64_t tmp;
+                memcpy(&tmp, &value, sizeof(tmp));
+                tmp = __builtin_bswap64(tmp);
+                memcpy(&value, &tmp, sizeof(tmp));
+                return value;
+            }
+            else if (sizeof(T) == sizeof(uint32_t))
+            {
+                uint32_t tmp;
+                memcpy(&tmp, &value, sizeof(tmp));
+                tmp = __builtin_bswap32(tmp);
+                memcpy(&value, &tmp, sizeof(tmp));
+                return value;
+            }
+            else if (sizeof(T) == sizeof(uint16_t))
+            {
+                uint16_t tmp;
+                memcpy(&tmp, &value, sizeof(tmp));
+                tmp = __builtin_bswap16(tmp);
+                memcpy(&value, &tmp, sizeof(tmp));
+                return value;
+            }
+            #endif
+
             union
             {
                 T value;
@@ -90,6 +122,231 @@ namespace openlib
             return dest.value;
         }
 
+        /**
+         * Returns a mask with the 'num_bits' least significant bits set
+         * @param num_bits The number of bits of the mask [0..64]
+         * @return uint64_t containing the mask
+         */
+        inline uint64_t low_mask(const size_t& num_bits)
+        {
+            return (num_bits >= 64) ? ~((uint64_t) 0) : ((((uint64_t) 1) << num_bits) - 1);
+        }
+
+        /**
+         * Loads the first 8 bytes of a byte array as a 64-bits window in wire (big-endian) order
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 8 bytes
+         * @param buffer The pointer to the first byte of the window
+         * @return uint64_t containing the window
+         */
+        inline uint64_t load_full_window(const uint8_t* buffer)
+        {
+            //-Unaligned load, single byte swap on little-endian systems
+            uint64_t window;
+            memcpy(&window, buffer, sizeof(uint64_t));
+            if (Endianess_LittleEndian == system_endianess())
+            {
+                window = swap_endian(window);
+            }
+            return window;
+        }
+
+        /**
+         * Loads the tail of a byte array (less than 8 bytes) as a 64-bits window in wire (big-endian) order,
+         * bytes beyond 'length' are read as 0. Kept apart from the full window load so the byte loop
+         * does not grow the inlined fast path
+         * IMPORTANT: NO NULL CHECKS!!!!!!!!
+         * @param buffer The pointer to the first byte of the window
+         * @param length The number of bytes available from 'buffer' (< 8)
+         * @return uint64_t containing the window
+         */
+        inline uint64_t load_tail_window(const uint8_t* buffer, const size_t& length)
+        {
+            uint64_t window = 0;
+            for (size_t i = 0; i < length; ++i)
+            {
+                window |= ((uint64_t) buffer[i]) << (56 - BYTE2BIT(i));
+            }
+            return window;
+        }
+
+        /**
+         * Loads a 64-bits window from a byte array in wire (big-endian) order, i.e. the first byte
+         * ends up on the most significant byte of the window. Bytes beyond 'length' are read as 0
+         * IMPORTANT: NO NULL CHECKS!!!!!!!!
+         * @param buffer The pointer to the first byte of the window
+         * @param length The number of bytes available from 'buffer'
+         * @return uint64_t containing the window
+         */
+        inline uint64_t load_window(const uint8_t* buffer, const size_t& length)
+        {
+            return (length >= sizeof(uint64_t)) ? load_full_window(buffer) : load_tail_window(buffer, length);
+        }
+
+        /**
+         * Stores a 64-bits window onto a byte array in wire (big-endian) order, the inverse of load_window.
+         * Bytes beyond 'length' are not written
+         * IMPORTANT: NO NULL CHECKS!!!!!!!!
+         * @param buffer The pointer to the first byte of the window
+         * @param length The number of bytes available from 'buffer'
+         * @param window The window to be stored
+         */
+        inline void store_window(uint8_t* buffer, const size_t& length, uint64_t window)
+        {
+            if (length >= sizeof(uint64_t))
+            {
+                //-Single byte swap on little-endian systems, unaligned store
+                if (Endianess_LittleEndian == system_endianess())
+                {
+                    window = swap_endian(window);
+                }
+                memcpy(buffer, &window, sizeof(uint64_t));
+            }
+            else
+            {
+                //-Tail of the buffer
+                for (size_t i = 0; i < length; ++i)
+                {
+                    buffer[i] = (uint8_t) (window >> (56 - BYTE2BIT(i)));
+                }
+            }
+        }
+
+        /**
+         * Extracts a field of up to 64 bits in wire order (right aligned, no endianess handling)
+         * IMPORTANT: NO CHECKS!!!!!!!! the field must lay within the buffer and 0 < bit_length <= 64
+         * @param buffer The buffer from where to extract the bits
+         * @param buffer_length The length of the buffer
+         * @param bit_offset The bit offset of the field from the start of the buffer
+         * @param bit_length The number of bits of the field
+         * @return uint64_t containing the field bits
+         */
+        inline uint64_t extract_raw(const uint8_t* buffer, const size_t& buffer_length, const size_t& bit_offset, const size_t& bit_length)
+        {
+            //-A field can span up to 9 bytes: 7 bits offset + 64 bits
+            const size_t first_byte = BIT2BYTE(bit_offset);
+            const uint8_t* buffer_ptr = buffer + first_byte;
+            const size_t window_bits = (bit_offset % 8) + bit_length;
+            if (buffer_length < first_byte + sizeof(uint64_t))
+            {
+                //-Short buffer, the field lays within the tail (less than 8 bytes)
+                return (load_tail_window(buffer_ptr, buffer_length - first_byte) >> (64 - window_bits)) & low_mask(bit_length);
+            }
+
+            //-Shift & mask once
+            const uint64_t window = load_full_window(buffer_ptr);
+            uint64_t raw;
+            if (window_bits <= 64)
+            {
+                raw = window >> (64 - window_bits);
+            }
+            else
+            {
+                raw = (window << (window_bits - 64)) | (buffer_ptr[sizeof(uint64_t)] >> (72 - window_bits));
+            }
+            return raw & low_mask(bit_length);
+        }
+
+        /**
+         * Inserts a field of up to 64 bits in wire order (right aligned, no endianess handling), with a
+         * single masked read-modify-write, bits outside the field are left untouched
+         * IMPORTANT: NO CHECKS!!!!!!!! the field must lay within the buffer and 0 < bit_length <= 64
+         * @param buffer The buffer where to insert the bits
+         * @param buffer_length The length of the buffer
+         * @param bit_offset The bit offset of the field from the start of the buffer
+         * @param bit_length The number of bits of the field
+         * @param raw The field bits (right aligned)
+         */
+        inline void insert_raw(uint8_t* buffer, const size_t& buffer_length, const size_t& bit_offset, const size_t& bit_length, uint64_t raw)
+        {
+            const size_t first_byte = BIT2BYTE(bit_offset);
+            uint8_t* buffer_ptr = buffer + first_byte;
+            const size_t available = buffer_length - first_byte;
+            const size_t window_bits = (bit_offset % 8) + bit_length;
+            raw &= low_mask(bit_length);
+
+            uint64_t window = load_window(buffer_ptr, available);
+            if (window_bits <= 64)
+            {
+                const size_t shift = 64 - window_bits;
+                const uint64_t mask = low_mask(bit_length) << shift;
+                window = (window & ~mask) | (raw << shift);
+            }
+            else
+            {
+                //-The first 8 bytes hold the most significant bits, the 9th byte the remaining ones
+                const size_t extra_bits = window_bits - 64;
+                const uint64_t mask = low_mask(bit_length - extra_bits);
+                window = (window & ~mask) | (raw >> extra_bits);
+
+                const uint8_t extra_mask = (uint8_t) (low_mask(extra_bits) << (8 - extra_bits));
+                buffer_ptr[sizeof(uint64_t)] = (uint8_t) ((buffer_ptr[sizeof(uint64_t)] & ~extra_mask) | ((raw << (8 - extra_bits)) & extra_mask));
+            }
+            store_window(buffer_ptr, available, window);
+        }
+
+        /**
+         * Checks the bytes of a value can be swapped: little-endian values wider than a byte shall span
+         * whole bytes, otherwise the swapped bits would land on the neighbouring fields
+         * @param bit_length The number of bits of the value
+         * @param buffer_endianess The endianess of the value on the buffer
+         * @return true if the layout is supported
+         */
+        inline bool is_valid_layout(const size_t& bit_length, const Endianess& buffer_endianess)
+        {
+            return Endianess_LittleEndian != buffer_endianess || bit_length <= 8 || 0 == bit_length % 8;
+        }
+
+        /**
+         * Converts field bits in wire order onto a value: swaps the bytes spanned by little-endian fields
+         * and sign extends signed values narrower than the container
+         * @tparam T Template type (integral type)
+         * @param raw The field bits (right aligned)
+         * @param bit_length The number of bits of the field (0 < bit_length <= 64)
+         * @param buffer_endianess The endianess of the value on the buffer
+         * @return T containing the value
+         */
+        template <typename T>
+        inline T raw_to_value(uint64_t raw, const size_t& bit_length, const Endianess& buffer_endianess)
+        {
+            //-Wire order is big-endian, swap the bytes spanned by the field if little-endian
+            const size_t num_bytes = (bit_length + 7) / 8;
+            if (Endianess_LittleEndian == buffer_endianess && num_bytes > 1)
+            {
+                raw = swap_endian(raw) >> (64 - BYTE2BIT(num_bytes));
+            }
+
+            //-Sign extend signed values narrower than the container
+            if (std::numeric_limits<T>::is_signed && bit_length < BYTE2BIT(sizeof(T)))
+            {
+                const uint64_t sign_bit = ((uint64_t) 1) << (bit_length - 1);
+                raw = (raw ^ sign_bit) - sign_bit;
+            }
+            return (T) raw;
+        }
+
+        /**
+         * Converts a value onto field bits in wire order, the inverse of raw_to_value
+         * @tparam T Template type (integral type)
+         * @param value The value to be converted
+         * @param bit_length The number of bits of the field (0 < bit_length <= 64)
+         * @param buffer_endianess The endianess of the value on the buffer
+         * @return uint64_t containing the field bits (right aligned)
+         */
+        template <typename T>
+        inline uint64_t value_to_raw(const T& value, const size_t& bit_length, const Endianess& buffer_endianess)
+        {
+            //-Keep the field bits only (no sign extension of narrow signed values)
+            uint64_t raw = ((uint64_t) value) & low_mask(bit_length);
+
+            //-Wire order is big-endian, swap the bytes spanned by the field if little-endian
+            const size_t num_bytes = (bit_length + 7) / 8;
+            if (Endianess_LittleEndian == buffer_endianess && num_bytes > 1)
+            {
+                raw = swap_endian(raw) >> (64 - BYTE2BIT(num_bytes));
+            }
+            return raw;
+        }
+
         /**
          * Extract an integral type from a byte array
          * @tparam T Template type (integral type)
@@ -127,27 +384,22 @@ namespace openlib
               return ERROR_CONTAINER_TOO_SMALL;
             }
 
-            //-Extract bits
-            *value =0;
-            const size_t bit_offset = BYTE2BIT(byte_idx) + bit_pos;
-            for (size_t bit_idx=0; bit_idx < bit_length; ++bit_idx)
+            //-Check layout (little-endian values span whole bytes)
+            if (!is_valid_layout(bit_length, buffer_endianess))
             {
-                //-Get the bit from the buffer
-                uint8_t bit_value = bit::get_bit_array(buffer, bit_offset + bit_idx);
-
-                //-Set the bit in the value
-                bit::set_bit_array(value, bit_idx, bit_value);
+                return ERROR_INVALID_LAYOUT;
             }
 
-            //-Shift if necessary
-            *value = *value >> (BYTE2BIT(sizeof(T))-bit_length);
-
-            //-Check endianess
-            if (buffer_endianess != system_endianess())
+            //-Empty field
+            if (0 == bit_length)
             {
-                *value = swap_endian(*value);
+                *value = 0;
+                return SUCCESS;
             }
 
+            //-Get the field bits
+            const uint64_t raw = extract_raw((const uint8_t*) buffer, buffer_length, BYTE2BIT(byte_idx) + bit_pos, bit_length);
+            *value = raw_to_value<T>(raw, bit_length, buffer_endianess);
             return SUCCESS;
 
         }
@@ -167,19 +419,77 @@ namespace openlib
         }
 
         /**
-         * Insert an integral type from a byte array
-         * @tparam T
-         * @param buffer
-         * @param buffer_length
-         * @param byte_idx
-         * @param bit_pos
-         * @param bit_length
-         * @param buffer_endianess
-         * @param value
+         * Extract a compile time field from a byte array
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least FieldType::min_buffer_length bytes
+         * @tparam FieldType The field type (@see openlib::icd::ICDField)
+         * @param buffer The buffer from where to extract the value
+         * @return The field value
+         */
+        template <typename FieldType>
+        inline typename FieldType::value_type extract_field(const void* buffer)
+        {
+            typedef typename FieldType::value_type T;
+            const uint8_t* buffer_ptr = ((const uint8_t*) buffer) + FieldType::byte_offset;
+
+            //-Byte aligned full width: plain load plus byte swap
+            if (FieldType::aligned)
+            {
+                T value;
+                memcpy(&value, buffer_ptr, sizeof(T));
+                if (FieldType::endianess != system_endianess())
+                {
+                    value = swap_endian(value);
+                }
+                return value;
+            }
+
+            //-Window over the (compile time sized) bytes spanned by the field
+            const uint64_t raw = extract_raw(buffer_ptr, FieldType::byte_length, FieldType::bit_offset, FieldType::num_bits);
+            return raw_to_value<T>(raw, FieldType::num_bits, FieldType::endianess);
+        }
+
+        /**
+         * Extract a compile time field from a byte array
+         * @param buffer The buffer from where to extract the value
+         * @param buffer_length The length of the buffer
+         * @param icd_field The field to be retrieved
+         * @return int containing the error code (@see Error, 0: SUCCESSS)
+         */
+        template <size_t BYTE_OFFSET, size_t BIT_OFFSET, size_t NUM_BITS, Endianess ENDIANESS, typename T>
+        inline int extract(const void* buffer, const size_t buffer_length, openlib::icd::ICDField<BYTE_OFFSET, BIT_OFFSET, NUM_BITS, ENDIANESS, T>& icd_field)
+        {
+            typedef openlib::icd::ICDField<BYTE_OFFSET, BIT_OFFSET, NUM_BITS, ENDIANESS, T> FieldType;
+
+            //-Check buffer
+            if (NULL == buffer)
+            {
+                return ERROR_NULL_PARAMETER;
+            }
+
+            //-Check length (container size and endianess are checked at compile time)
+            if (buffer_length < FieldType::min_buffer_length)
+            {
+                return ERROR_NOT_ENOUGH_DATA;
+            }
+
+            icd_field.value = extract_field<FieldType>(buffer);
+            return SUCCESS;
+        }
+
+        /**
+         * Insert an integral type onto a byte array (the inverse of extract), bits outside the field are untouched
+         * @tparam T Template type (integral type)
+         * @param buffer The buffer where to insert the value
+         * @param buffer_length The length of the buffer
+         * @param byte_idx The byte index (0 based) where to insert the value
+         * @param bit_pos The bit position where the value shall be inserted, assumes on the wire order bit 0 | bit 1 | bit 2... bit n
+         * @param bit_length The number of bits of the value (least significant bits of 'value')
+         * @param buffer_endianess The endianess of the value on the buffer
+         * @param value The input value
          * @return int containing the error code (@see Error, 0: SUCCESSS)
          */
         template <typename T>
-        inline int insert(void* buffer, const size_t buffer_length, const size_t& byte_idx, const size_t& bit_pos, const size_t& bit_length, const Endianess& buffer_endianess, T* value)
+        inline int insert(void* buffer, const size_t buffer_length, const size_t& byte_idx, const size_t& bit_pos, const size_t& bit_length, const Endianess& buffer_endianess, const T* value)
         {
             //-Check buffer
             if (NULL == buffer)
@@ -203,40 +513,93 @@ namespace openlib
                 return ERROR_CONTAINER_TOO_SMALL;
             }
 
-            //-Debug
-            #ifndef NDEBUG
-            std::cout << "Insert" << std::endl;
-            #endif
+            //-Check layout (little-endian values span whole bytes)
+            if (!is_valid_layout(bit_length, buffer_endianess))
+            {
+                return ERROR_INVALID_LAYOUT;
+            }
 
-            //-Check the buffer buffer_endianess vs the system
-            T value_buffer_endianess = *value;
-            if (system_endianess() != buffer_endianess)
+            //-Empty field
+            if (0 == bit_length)
             {
-                value_buffer_endianess = swap_endian(value_buffer_endianess);
+                return SUCCESS;
             }
 
+            //-Get the field bits
+            const uint64_t raw = value_to_raw(*value, bit_length, buffer_endianess);
+
             //-Set bits
-            const size_t bit_offset = BYTE2BIT(byte_idx) + bit_pos;
-            for (size_t bit_idx = 0; bit_idx < bit_length; ++bit_idx)
+            insert_raw((uint8_t*) buffer, buffer_length, BYTE2BIT(byte_idx) + bit_pos, bit_length, raw);
+            return SUCCESS;
+        }
+
+
+        /**
+         * Insert a compile time field onto a byte array, bits outside the field are untouched
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least FieldType::min_buffer_length bytes
+         * @tparam FieldType The field type (@see openlib::icd::ICDField)
+         * @param buffer The buffer where to insert the value
+         * @param value The field value
+         */
+        template <typename FieldType>
+        inline void insert_field(void* buffer, const typename FieldType::value_type& value)
+        {
+            typedef typename FieldType::value_type T;
+            uint8_t* buffer_ptr = ((uint8_t*) buffer) + FieldType::byte_offset;
+
+            //-Byte aligned full width: byte swap plus plain store
+            if (FieldType::aligned)
+            {
+                T wire_value = value;
+                if (FieldType::endianess != system_endianess())
+                {
+                    wire_value = swap_endian(wire_value);
+                }
+                memcpy(buffer_ptr, &wire_value, sizeof(T));
+                return;
+            }
+
+            //-Masked read-modify-write over the (compile time sized) bytes spanned by the field
+            const uint64_t raw = value_to_raw(value, FieldType::num_bits, FieldType::endianess);
+            insert_raw(buffer_ptr, FieldType::byte_length, FieldType::bit_offset, FieldType::num_bits, raw);
+        }
+
+        /**
+         * Insert a compile time field onto a byte array, bits outside the field are untouched
+         * @param buffer The buffer where to insert the value
+         * @param buffer_length The length of the buffer
+         * @param icd_field The field to be inserted
+         * @return int containing the error code (@see Error, 0: SUCCESSS)
+         */
+        template <size_t BYTE_OFFSET, size_t BIT_OFFSET, size_t NUM_BITS, Endianess ENDIANESS, typename T>
+        inline int insert(void* buffer, const size_t buffer_length, const openlib::icd::ICDField<BYTE_OFFSET, BIT_OFFSET, NUM_BITS, ENDIANESS, T>& icd_field)
+        {
+            typedef openlib::icd::ICDField<BYTE_OFFSET, BIT_OFFSET, NUM_BITS, ENDIANESS, T> FieldType;
+
+            //-Check buffer
+            if (NULL == buffer)
+            {
+                return ERROR_NULL_PARAMETER;
+            }
+
+            //-Check length (container size and endianess are checked at compile time)
+            if (buffer_length < FieldType::min_buffer_length)
             {
-                //-Get the buffer bit number
-                uint8_t bit_value = bit::get_bit_array(&value_buffer_endianess, bit_idx);
-                
-                //-Set the bit in the buffer
-                bit::set_bit_array(buffer, bit_offset + bit_idx, bit_value);
+                return ERROR_NOT_ENOUGH_DATA;
             }
+
+            insert_field<FieldType>(buffer, icd_field.value);
             return SUCCESS;
         }
 
-
         /**
          * Insert (encodes) a data descriptor onto a buffer
          * @param buffer The buffer where to encode the data
          * @param buffer_length The buffer length
-         * @param data_descriptor The data with descriptor
+         * @param data_descriptor The data with descriptor (read only, the field is not marked as changed)
          * @return
          */
-        inline int insert(void* buffer, const size_t buffer_length, openlib::icd::DataDescriptor& data_descriptor)
+        inline int insert(void* buffer, const size_t buffer_length, const openlib::icd::DataDescriptor& data_descriptor)
         {
             int retval = 0;
             using namespace openlib::icd;
@@ -308,7 +671,7 @@ namespace openlib
 
                 case DataType_binary:
                 case DataType_ascii:
-                    memcpy(buffer, data_descriptor.as_binary(), std::min(buffer_length, data_descriptor.data_length()));
+                    memcpy(buffer, data_descriptor.data(), std::min(buffer_length, data_descriptor.data_length()));
                     //retval = insert(buffer, buffer_length, data_descriptor.byte_offset, data_descriptor.bit_offset, data_descriptor.num_bits_, data_descriptor.endianess_, data_descriptor.as_uint8());
                     break;
                 default:
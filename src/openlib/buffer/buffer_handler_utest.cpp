@@ -270,3 +270,290 @@ TEST(buffer_hanlder, Test_error_out_constainer_too_small)
 	//std::cout << "OK=" << ok << std::endl;
 	CHECK_EQUAL(ok, ERROR_CONTAINER_TOO_SMALL);
 }
+
+TEST(buffer_hanlder, Test_bit_macros)
+{
+	//-The whole expression is converted
+	const size_t num_bits = 9;
+	const size_t num_bytes = 2;
+	CHECK_EQUAL(num_bytes, BIT2BYTE(num_bits + 7));
+	CHECK_EQUAL(BYTE2BIT(num_bytes), BYTE2BIT(num_bytes - 1) + 8);
+}
+
+TEST(buffer_hanlder, Test_error_invalid_layout)
+{
+	//-Little-endian values wider than a byte span whole bytes
+	uint16_t value = 0xABC;
+	uint8_t wire[3] = {0x5A, 0x5A, 0x5A};
+	CHECK_EQUAL(ERROR_INVALID_LAYOUT, insert(wire, sizeof(wire), 0, 4, 12, Endianess::Endianess_LittleEndian, &value));
+	CHECK_EQUAL(ERROR_INVALID_LAYOUT, extract(wire, sizeof(wire), 0, 4, 12, Endianess::Endianess_LittleEndian, &value));
+	CHECK_EQUAL(0x5A, wire[0]);
+	CHECK_EQUAL(0x5A, wire[1]);
+	CHECK_EQUAL(0xABC, value);
+
+	//-Byte multiples and values up to a byte (nothing to swap) round trip
+	CHECK_EQUAL(SUCCESS, insert(wire, sizeof(wire), 0, 4, 16, Endianess::Endianess_LittleEndian, &value));
+	CHECK_EQUAL(0x5B, wire[0]);
+	CHECK_EQUAL(0xC0, wire[1]);
+	CHECK_EQUAL(0xAA, wire[2]);
+	value = 0;
+	CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), 0, 4, 16, Endianess::Endianess_LittleEndian, &value));
+	CHECK_EQUAL(0xABC, value);
+	uint8_t nibble = 0x9;
+	CHECK_EQUAL(SUCCESS, insert(wire, sizeof(wire), 2, 4, 4, Endianess::Endianess_LittleEndian, &nibble));
+	nibble = 0;
+	CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), 2, 4, 4, Endianess::Endianess_LittleEndian, &nibble));
+	CHECK_EQUAL(0x9, nibble);
+	CHECK_EQUAL(0xA9, wire[2]);
+}
+
+//==========================
+// WORD-AT-A-TIME EXTRACTION
+//==========================
+
+/**
+ * Reference bit-by-bit extraction (previous implementation), used to cross-check the window engine
+ */
+template <typename T>
+static T extract_per_bit(const uint8_t* buffer, const size_t& byte_idx, const size_t& bit_pos, const size_t& bit_length, const Endianess& buffer_endianess)
+{
+	T value = 0;
+	const size_t bit_offset = BYTE2BIT(byte_idx) + bit_pos;
+	for (size_t bit_idx=0; bit_idx < bit_length; ++bit_idx)
+	{
+		bit::set_bit_array(&value, bit_idx, bit::get_bit_array(buffer, bit_offset + bit_idx));
+	}
+	value = value >> (BYTE2BIT(sizeof(T))-bit_length);
+	if (buffer_endianess != system_endianess())
+	{
+		value = swap_endian(value);
+	}
+	return value;
+}
+
+template <typename T>
+static bool cross_check_full_width(const uint8_t* buffer, const size_t& buffer_length)
+{
+	const size_t bit_length = BYTE2BIT(sizeof(T));
+	for (size_t byte_idx = 0; BYTE2BIT(byte_idx) + 7 + bit_length <= BYTE2BIT(buffer_length); ++byte_idx)
+	{
+		for (size_t bit_pos = 0; bit_pos < 8; ++bit_pos)
+		{
+			for (int e = Endianess_BigEndian; e < Endianess_Max; ++e)
+			{
+				T value = 0;
+				const Endianess endianess = (Endianess) e;
+				if (SUCCESS != extract(buffer, buffer_length, byte_idx, bit_pos, bit_length, endianess, &value) ||
+					extract_per_bit<T>(buffer, byte_idx, bit_pos, bit_length, endianess) != value)
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+TEST(buffer_hanlder, Test_window_matches_per_bit)
+{
+	uint8_t wire[24];
+	for (size_t i = 0; i < sizeof(wire); ++i)
+	{
+		wire[i] = (uint8_t) (0x9D * (i + 1) ^ (i << 3));
+	}
+
+	//-Every offset and width for single byte containers
+	for (size_t byte_idx = 0; byte_idx < sizeof(wire) - 1; ++byte_idx)
+	{
+		for (size_t bit_pos = 0; bit_pos < 8; ++bit_pos)
+		{
+			for (size_t bit_length = 1; bit_length <= 8; ++bit_length)
+			{
+				uint8_t value_uint8 = 0;
+				int8_t value_int8 = 0;
+				CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), byte_idx, bit_pos, bit_length, Endianess::Endianess_BigEndian, &value_uint8));
+				CHECK_EQUAL(extract_per_bit<uint8_t>(wire, byte_idx, bit_pos, bit_length, Endianess::Endianess_BigEndian), value_uint8);
+				CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), byte_idx, bit_pos, bit_length, Endianess::Endianess_LittleEndian, &value_int8));
+				CHECK_EQUAL(extract_per_bit<int8_t>(wire, byte_idx, bit_pos, bit_length, Endianess::Endianess_LittleEndian), value_int8);
+			}
+		}
+	}
+
+	//-Every offset and endianess for full width containers (including the 9 bytes span of 64-bits)
+	CHECK(cross_check_full_width<uint16_t>(wire, sizeof(wire)));
+	CHECK(cross_check_full_width<int16_t>(wire, sizeof(wire)));
+	CHECK(cross_check_full_width<uint32_t>(wire, sizeof(wire)));
+	CHECK(cross_check_full_width<int32_t>(wire, sizeof(wire)));
+	CHECK(cross_check_full_width<uint64_t>(wire, sizeof(wire)));
+}
+
+TEST(buffer_hanlder, Test_window_end_of_buffer)
+{
+	//-Field ending exactly on the last bit of the buffer (short window)
+	int ok;
+	uint16_t value_uint16 = 0;
+	ok = extract(buffer, buffer_length, 2, 0, 16, Endianess::Endianess_BigEndian, &value_uint16);
+	CHECK_EQUAL(ok, SUCCESS);
+	CHECK_EQUAL((uint16_t) (byte2 << 8 | byte3), value_uint16);
+
+	int8_t value_int8 = 0;
+	ok = extract(buffer, buffer_length, 3, 4, 4, Endianess::Endianess_BigEndian, &value_int8);
+	CHECK_EQUAL(ok, SUCCESS);
+	CHECK_EQUAL((int8_t) ((byte3 & 0x0F) | 0xF0), value_int8);
+}
+
+//==========================
+// MASKED INSERTION
+//==========================
+
+/**
+ * Reference bit-by-bit insertion (previous implementation), used to cross-check the masked insertion
+ */
+template <typename T>
+static void insert_per_bit(uint8_t* buffer, const size_t& byte_idx, const size_t& bit_pos, const size_t& bit_length, const Endianess& buffer_endianess, T value)
+{
+	if (system_endianess() != buffer_endianess)
+	{
+		value = swap_endian(value);
+	}
+	const size_t bit_offset = BYTE2BIT(byte_idx) + bit_pos;
+	for (size_t bit_idx = 0; bit_idx < bit_length; ++bit_idx)
+	{
+		bit::set_bit_array(buffer, bit_offset + bit_idx, bit::get_bit_array(&value, bit_idx));
+	}
+}
+
+template <typename T>
+static bool cross_check_insert_full_width(const T& value)
+{
+	const size_t bit_length = BYTE2BIT(sizeof(T));
+	uint8_t wire[24];
+	uint8_t expected[24];
+	for (size_t byte_idx = 0; BYTE2BIT(byte_idx) + 7 + bit_length <= BYTE2BIT(sizeof(wire)); ++byte_idx)
+	{
+		for (size_t bit_pos = 0; bit_pos < 8; ++bit_pos)
+		{
+			for (int e = Endianess_BigEndian; e < Endianess_Max; ++e)
+			{
+				const Endianess endianess = (Endianess) e;
+				T input = value;
+				memset(wire, 0xA5, sizeof(wire));
+				memset(expected, 0xA5, sizeof(wire));
+				insert_per_bit<T>(expected, byte_idx, bit_pos, bit_length, endianess, value);
+				if (SUCCESS != insert(wire, sizeof(wire), byte_idx, bit_pos, bit_length, endianess, &input) ||
+					0 != memcmp(wire, expected, sizeof(wire)))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+TEST(buffer_hanlder, Test_insert_matches_per_bit)
+{
+	CHECK(cross_check_insert_full_width<uint8_t>(0x5B));
+	CHECK(cross_check_insert_full_width<int16_t>(-12345));
+	CHECK(cross_check_insert_full_width<uint32_t>(0xDEADBEEF));
+	CHECK(cross_check_insert_full_width<int32_t>(-2));
+	CHECK(cross_check_insert_full_width<uint64_t>(0x0123456789ABCDEFULL));
+}
+
+TEST(buffer_hanlder, Test_insert_narrow_fields)
+{
+	//-Insert narrow fields, bits outside the field are untouched and extract reads them back
+	uint8_t wire[12];
+	for (size_t bit_offset = 0; bit_offset < BYTE2BIT(sizeof(wire)) - 12; ++bit_offset)
+	{
+		for (size_t bit_length = 1; bit_length <= 12; ++bit_length)
+		{
+			memset(wire, 0x5A, sizeof(wire));
+			uint8_t expected[12];
+			memcpy(expected, wire, sizeof(wire));
+
+			int16_t value = (int16_t) (0x0ABC & ((1 << bit_length) - 1));
+			for (size_t bit_idx = 0; bit_idx < bit_length; ++bit_idx)
+			{
+				bit::set_bit_array(expected, bit_offset + bit_idx, (value >> (bit_length - 1 - bit_idx)) & 0x01);
+			}
+
+			CHECK_EQUAL(SUCCESS, insert(wire, sizeof(wire), BIT2BYTE(bit_offset), bit_offset % 8, bit_length, Endianess::Endianess_BigEndian, &value));
+			MEMCMP_EQUAL(expected, wire, sizeof(wire));
+
+			uint16_t readback = 0;
+			CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), BIT2BYTE(bit_offset), bit_offset % 8, bit_length, Endianess::Endianess_BigEndian, &readback));
+			CHECK_EQUAL((uint16_t) value, readback);
+		}
+	}
+}
+
+TEST(buffer_hanlder, Test_insert_errors)
+{
+	uint8_t value_uint8 = 0xFF;
+	CHECK_EQUAL(ERROR_NULL_PARAMETER, insert((void*) NULL, buffer_length, 0, 0, 8, Endianess::Endianess_BigEndian, &value_uint8));
+	CHECK_EQUAL(ERROR_NOT_ENOUGH_DATA, insert(buffer, buffer_length, buffer_length-1, 7, 4, Endianess::Endianess_BigEndian, &value_uint8));
+	CHECK_EQUAL(ERROR_CONTAINER_TOO_SMALL, insert(buffer, buffer_length, 0, 0, 9, Endianess::Endianess_BigEndian, &value_uint8));
+	CHECK_EQUAL(byte0, buffer[0]);
+	CHECK_EQUAL(byte3, buffer[3]);
+}
+
+//==========================
+// COMPILE TIME FIELDS
+//==========================
+
+TEST(buffer_hanlder, Test_icd_field_extract)
+{
+	int ok;
+
+	//-Byte aligned
+	openlib::icd::ICDField<0, 0, 16, Endianess_BigEndian, int16_t> field_be;
+	ok = extract(buffer, buffer_length, field_be);
+	CHECK_EQUAL(ok, SUCCESS);
+	CHECK_EQUAL( (int16_t) (byte0 << 8 | byte1 << 0), field_be.value);
+
+	openlib::icd::ICDField<0, 0, 16, Endianess_LittleEndian, int16_t> field_le;
+	ok = extract(buffer, buffer_length, field_le);
+	CHECK_EQUAL(ok, SUCCESS);
+	CHECK_EQUAL( (int16_t) (byte0 << 0 | byte1 << 8), field_le.value);
+
+	//-Misaligned cross boundary, same as the runtime path
+	openlib::icd::ICDField<2, 7, 4, Endianess_BigEndian, uint8_t> field_nibble;
+	ok = extract(buffer, buffer_length, field_nibble);
+	CHECK_EQUAL(ok, SUCCESS);
+	CHECK_EQUAL((byte2 & 0x01) << 3  | byte3 >> 5 , field_nibble.value);
+
+	//-Out of boundary
+	openlib::icd::ICDField<3, 7, 4, Endianess_BigEndian, uint8_t> field_out;
+	ok = extract(buffer, buffer_length, field_out);
+	CHECK_EQUAL(ok, ERROR_NOT_ENOUGH_DATA);
+	ok = extract(NULL, buffer_length, field_nibble);
+	CHECK_EQUAL(ok, ERROR_NULL_PARAMETER);
+}
+
+TEST(buffer_hanlder, Test_icd_field_insert)
+{
+	uint8_t wire[16];
+	uint8_t expected[16];
+	memset(wire, 0x3C, sizeof(wire));
+	memset(expected, 0x3C, sizeof(expected));
+
+	openlib::icd::ICDField<1, 0, 32, Endianess_LittleEndian, uint32_t> field_aligned;
+	field_aligned.value = 0x11223344;
+	CHECK_EQUAL(SUCCESS, insert(wire, sizeof(wire), field_aligned));
+	uint32_t value_aligned = field_aligned.value;
+	insert(expected, sizeof(expected), 1, 0, 32, Endianess_LittleEndian, &value_aligned);
+	MEMCMP_EQUAL(expected, wire, sizeof(wire));
+
+	openlib::icd::ICDField<6, 5, 64, Endianess_BigEndian, int64_t> field_misaligned;
+	field_misaligned.value = -0x123456789ALL;
+	CHECK_EQUAL(SUCCESS, insert(wire, sizeof(wire), field_misaligned));
+	int64_t value_misaligned = field_misaligned.value;
+	insert(expected, sizeof(expected), 6, 5, 64, Endianess_BigEndian, &value_misaligned);
+	MEMCMP_EQUAL(expected, wire, sizeof(wire));
+
+	field_misaligned.value = 0;
+	CHECK_EQUAL(SUCCESS, extract(wire, sizeof(wire), field_misaligned));
+	CHECK_EQUAL(-0x123456789ALL, field_misaligned.value);
+	CHECK_EQUAL(ERROR_NOT_ENOUGH_DATA, insert(wire, 14, field_misaligned));
+}
@@ -0,0 +1,322 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_BUFFER_STREAM_FRAMER_H
+#define OPENLIB_BUFFER_STREAM_FRAMER_H
+
+//-Supporting libraries
+#include "openlib/common.h"
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/buffer/bit.h"
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/enum/endianess.h"
+#include <algorithm>
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-Namespace/s
+namespace openlib
+{
+    namespace buffer
+    {
+        /**
+         * Finds the first occurrence of a pattern (i.e. a sync word), 16 positions at a time with SSE2:
+         * candidates must match the first and the last byte of the pattern, memchr otherwise
+         * @param data The data where to search
+         * @param data_length The length of the data
+         * @param pattern The pattern
+         * @param pattern_length The length of the pattern (> 0)
+         * @return size_t containing the offset of the pattern, data_length if not found
+         */
+        inline size_t find_pattern(const uint8_t* data, const size_t& data_length, const uint8_t* pattern, const size_t& pattern_length)
+        {
+            if (0 == pattern_length || data_length < pattern_length)
+            {
+                return data_length;
+            }
+            const size_t last = pattern_length - 1;
+            size_t offset = 0;
+
+            #if defined(__SSE2__)
+            const __m128i first_byte = _mm_set1_epi8((char) pattern[0]);
+            const __m128i last_byte = _mm_set1_epi8((char) pattern[last]);
+            for (; offset + last + sizeof(__m128i) <= data_length; offset += sizeof(__m128i))
+            {
+                const __m128i first_block = _mm_loadu_si128((const __m128i*) (data + offset));
+                const __m128i last_block = _mm_loadu_si128((const __m128i*) (data + offset + last));
+                unsigned int candidates = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_block, first_byte), _mm_cmpeq_epi8(last_block, last_byte)));
+                while (0 != candidates)
+                {
+                    const size_t candidate = offset + bit::count_trailing_zeros(candidates);
+                    if (pattern_length <= 2 || 0 == memcmp(data + candidate + 1, pattern + 1, pattern_length - 2))
+                    {
+                        return candidate;
+                    }
+                    candidates &= candidates - 1;
+                }
+            }
+            #endif
+
+            //-Remainder (the whole data without SSE2)
+            while (offset + last < data_length)
+            {
+                const void* found = memchr(data + offset, pattern[0], data_length - last - offset);
+                if (NULL == found)
+                {
+                    break;
+                }
+                offset = (const uint8_t*) found - data;
+                if (0 == memcmp(data + offset + 1, pattern + 1, last))
+                {
+                    return offset;
+                }
+                ++offset;
+            }
+            return data_length;
+        }
+
+        /**
+         * Splits a continuous byte stream onto frames marked by a sync word plus a length field
+         * Chunks of any size are appended (@see write) and complete frames handed out as views of the
+         * internal buffer (@see next), the unconsumed bytes are only moved to the front of the buffer
+         * when a chunk does not fit past them (at most a partial frame)
+         *
+         *   | sync word | ... | length field | ... payload ... |
+         *   <---------------- frame length ------------------->
+         *
+         * frame length = length field value + length adjustment (i.e. the bytes not counted by the field)
+         */
+        class StreamFramer : public NonCopyable
+        {
+            public:
+                /**
+                 * Frame view, valid until the next write/reset
+                 */
+                struct Frame
+                {
+                    const uint8_t*  data;
+                    size_t          length;
+                };
+
+                //-Constructor & Destructor
+                inline StreamFramer(const void* sync, const size_t& sync_length,
+                                    const size_t& length_byte_offset, const size_t& length_bit_offset,
+                                    const size_t& length_num_bits, const Endianess& length_endianess,
+                                    const int64_t& length_adjustment, const size_t& max_frame_length,
+                                    const size_t& capacity);
+                virtual ~StreamFramer() {};
+
+                //-Accessor
+                inline size_t capacity() const      { return buffer_.size();            }
+                inline size_t available() const     { return write_idx_ - read_idx_;    }
+                inline size_t space() const         { return buffer_.size() - available(); }
+                inline uint64_t frames() const      { return frames_;                   }
+                inline uint64_t discarded() const   { return discarded_;                }
+                inline uint64_t invalid() const     { return invalid_;                  }
+
+                //-Ancillary functions
+                inline size_t write(const void* data, const size_t& data_length);
+                inline bool next(Frame& frame);
+                inline void reset();
+
+            protected:
+                //-Functions
+                inline void discard(const size_t& length);
+
+                //-Fields
+                std::vector<uint8_t>    buffer_;
+                size_t                  read_idx_;
+                size_t                  write_idx_;
+                std::vector<uint8_t>    sync_;
+                size_t                  length_byte_offset_;
+                size_t                  length_bit_offset_;
+                size_t                  length_num_bits_;
+                Endianess               length_endianess_;
+                int64_t                 length_adjustment_;
+                size_t                  header_length_;     //-Bytes needed to read the length
+                size_t                  max_frame_length_;
+                uint64_t                frames_;            //-Frames handed out
+                uint64_t                discarded_;         //-Bytes skipped looking for a sync word
+                uint64_t                invalid_;           //-Sync words followed by an invalid length
+
+        }; /*class StreamFramer*/
+
+        /**
+         * Constructor
+         * @param sync The sync word (copied)
+         * @param sync_length The length of the sync word (> 0)
+         * @param length_byte_offset The byte index of the length field from the start of the frame
+         * @param length_bit_offset The bit position of the length field within the byte (wire order)
+         * @param length_num_bits The number of bits of the length field [1..64]
+         * @param length_endianess The endianess of the length field on the wire
+         * @param length_adjustment Added to the length field value to get the frame length
+         * @param max_frame_length The longest valid frame, longer ones are treated as corrupted
+         * @param capacity The capacity of the buffer (>= max_frame_length)
+         */
+        StreamFramer::StreamFramer(const void* sync, const size_t& sync_length,
+                                   const size_t& length_byte_offset, const size_t& length_bit_offset,
+                                   const size_t& length_num_bits, const Endianess& length_endianess,
+                                   const int64_t& length_adjustment, const size_t& max_frame_length,
+                                   const size_t& capacity) :
+            buffer_(capacity),
+            read_idx_(0),
+            write_idx_(0),
+            sync_((const uint8_t*) sync, (const uint8_t*) sync + sync_length),
+            length_byte_offset_(length_byte_offset),
+            length_bit_offset_(length_bit_offset),
+            length_num_bits_(length_num_bits),
+            length_endianess_(length_endianess),
+            length_adjustment_(length_adjustment),
+            header_length_(0),
+            max_frame_length_(max_frame_length),
+            frames_(0),
+            discarded_(0),
+            invalid_(0)
+        {
+            assert(NULL != sync && sync_length > 0);
+            assert(length_num_bits > 0 && length_num_bits <= 64);
+            assert(capacity >= max_frame_length);
+            header_length_ = std::max(sync_length, (BYTE2BIT(length_byte_offset) + length_bit_offset + length_num_bits + 7) / 8);
+        }
+
+        /**
+         * Appends a chunk of the stream
+         * @param data The chunk
+         * @param data_length The length of the chunk
+         * @return size_t containing the bytes accepted, less than data_length when the buffer is full
+         * (call next to drain it)
+         */
+        size_t StreamFramer::write(const void* data, const size_t& data_length)
+        {
+            if (NULL == data)
+            {
+                return 0;
+            }
+            const size_t length = std::min(data_length, space());
+            if (write_idx_ + length > buffer_.size())
+            {
+                //-Move the unconsumed bytes to the front
+                memmove(&buffer_[0], &buffer_[read_idx_], available());
+                write_idx_ -= read_idx_;
+                read_idx_ = 0;
+            }
+            if (length > 0)
+            {
+                memcpy(&buffer_[write_idx_], data, length);
+                write_idx_ += length;
+            }
+            return length;
+        }
+
+        /**
+         * Hands out the next complete frame, skipping the bytes before a sync word and the sync words
+         * followed by an invalid length
+         * @param frame (output) The frame view (valid until the next write/reset)
+         * @return true if a frame is available, false if more data is needed
+         */
+        bool StreamFramer::next(Frame& frame)
+        {
+            while (available() >= sync_.size())
+            {
+                //-Sync word
+                const uint8_t* data = &buffer_[read_idx_];
+                const size_t sync_idx = find_pattern(data, available(), &sync_[0], sync_.size());
+                if (sync_idx == available())
+                {
+                    //-Keep a possible partial sync word
+                    discard(available() - (sync_.size() - 1));
+                    return false;
+                }
+                discard(sync_idx);
+                data = &buffer_[read_idx_];
+                if (available() < header_length_)
+                {
+                    return false;
+                }
+
+                //-Length
+                uint64_t length_value = 0;
+                extract(data, available(), length_byte_offset_, length_bit_offset_, length_num_bits_, length_endianess_, &length_value);
+                const int64_t frame_length = (int64_t) length_value + length_adjustment_;
+                if (length_value > max_frame_length_ || frame_length < (int64_t) header_length_ || frame_length > (int64_t) max_frame_length_)
+                {
+                    //-False sync word or corrupted length, search past it
+                    ++invalid_;
+                    discard(1);
+                    continue;
+                }
+                if (available() < (size_t) frame_length)
+                {
+                    return false;
+                }
+
+                frame.data = data;
+                frame.length = (size_t) frame_length;
+                read_idx_ += frame.length;
+                if (read_idx_ == write_idx_)
+                {
+                    //-Nothing left to move on the next write (the view stays valid until then)
+                    read_idx_ = 0;
+                    write_idx_ = 0;
+                }
+                ++frames_;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Drops the buffered bytes and the counters
+         */
+        void StreamFramer::reset()
+        {
+            read_idx_ = 0;
+            write_idx_ = 0;
+            frames_ = 0;
+            discarded_ = 0;
+            invalid_ = 0;
+        }
+
+        /**
+         * Skips bytes that are not part of a frame
+         * @param length The number of bytes
+         */
+        void StreamFramer::discard(const size_t& length)
+        {
+            read_idx_ += length;
+            discarded_ += length;
+            if (read_idx_ == write_idx_)
+            {
+                read_idx_ = 0;
+                write_idx_ = 0;
+            }
+        }
+
+    }; /*namespace buffer*/
+}; /*namespace openlib*/
+
+#endif /*OPENLIB_BUFFER_STREAM_FRAMER_H*/
@@ -0,0 +1,174 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "stream_framer.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::buffer;
+
+/**
+ * Appends a frame: sync word (0xEB 0x90) | length (16 bits big-endian, payload bytes) | payload
+ * @param stream The stream
+ * @param payload_length The length of the payload
+ * @param seed The first payload byte
+ */
+static void append_frame(vector<uint8_t>& stream, const size_t& payload_length, const uint8_t& seed)
+{
+	stream.push_back(0xEB);
+	stream.push_back(0x90);
+	stream.push_back((uint8_t) (payload_length >> 8));
+	stream.push_back((uint8_t) payload_length);
+	for (size_t i = 0; i < payload_length; ++i)
+	{
+		stream.push_back((uint8_t) (seed + i));
+	}
+}
+
+TEST_GROUP(stream_framer)
+{
+	const uint8_t sync[2] = {0xEB, 0x90};
+
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(stream_framer, Test_find_pattern)
+{
+	//-Same as a plain search for every position, length and pattern size
+	srand(7);
+	uint8_t data[100];
+	for (size_t i = 0; i < sizeof(data); ++i)
+	{
+		data[i] = (uint8_t) (rand() % 4);
+	}
+	for (size_t pattern_length = 1; pattern_length <= 4; ++pattern_length)
+	{
+		for (size_t pattern_idx = 0; pattern_idx + pattern_length <= sizeof(data); pattern_idx += 3)
+		{
+			const uint8_t* pattern = data + pattern_idx;
+			for (size_t data_length = 0; data_length <= sizeof(data); data_length += 5)
+			{
+				size_t expected = data_length;
+				for (size_t i = 0; i + pattern_length <= data_length; ++i)
+				{
+					if (0 == memcmp(data + i, pattern, pattern_length))
+					{
+						expected = i;
+						break;
+					}
+				}
+				CHECK_EQUAL(expected, find_pattern(data, data_length, pattern, pattern_length));
+			}
+		}
+	}
+	CHECK_EQUAL(10u, find_pattern(data, 10, data, 0));
+}
+
+TEST(stream_framer, Test_frames)
+{
+	//-Frames with garbage in between, a partial sync word and a false sync word with a bad length
+	vector<uint8_t> stream;
+	stream.push_back(0x01);
+	stream.push_back(0xEB);
+	append_frame(stream, 5, 0x10);
+	append_frame(stream, 0, 0x20);
+	stream.push_back(0xEB);
+	stream.push_back(0x90);
+	stream.push_back(0xFF);
+	stream.push_back(0xFF);
+	append_frame(stream, 40, 0x30);
+	stream.push_back(0x55);
+	append_frame(stream, 60, 0x40);
+
+	const size_t payloads[] = {5, 0, 40, 60};
+	const uint8_t seeds[] = {0x10, 0x20, 0x30, 0x40};
+	const size_t NUM_FRAMES = sizeof(payloads) / sizeof(payloads[0]);
+
+	//-Any chunk size gives the same frames
+	for (size_t chunk = 1; chunk <= stream.size(); ++chunk)
+	{
+		StreamFramer framer(sync, sizeof(sync), 2, 0, 16, Endianess_BigEndian, 4, 64, 80);
+		size_t frame_idx = 0;
+		size_t written = 0;
+		StreamFramer::Frame frame;
+		while (written < stream.size())
+		{
+			written += framer.write(&stream[written], std::min(chunk, stream.size() - written));
+			while (framer.next(frame))
+			{
+				CHECK(frame_idx < NUM_FRAMES);
+				CHECK_EQUAL(4 + payloads[frame_idx], frame.length);
+				CHECK_EQUAL(0xEB, frame.data[0]);
+				for (size_t i = 0; i < payloads[frame_idx]; ++i)
+				{
+					CHECK_EQUAL((uint8_t) (seeds[frame_idx] + i), frame.data[4 + i]);
+				}
+				++frame_idx;
+			}
+		}
+		CHECK_EQUAL(NUM_FRAMES, frame_idx);
+		CHECK_EQUAL(NUM_FRAMES, framer.frames());
+		CHECK_EQUAL(1u, framer.invalid());
+		CHECK_EQUAL(0u, framer.available());
+	}
+}
+
+TEST(stream_framer, Test_full)
+{
+	StreamFramer framer(sync, sizeof(sync), 2, 0, 16, Endianess_BigEndian, 4, 16, 16);
+	vector<uint8_t> stream;
+	append_frame(stream, 10, 0);
+	append_frame(stream, 10, 0);
+
+	//-The buffer takes what fits, draining frees the space
+	CHECK_EQUAL(16u, framer.write(&stream[0], stream.size()));
+	CHECK_EQUAL(0u, framer.space());
+	StreamFramer::Frame frame;
+	CHECK(framer.next(frame));
+	CHECK_EQUAL(14u, frame.length);
+	CHECK(!framer.next(frame));
+	CHECK_EQUAL(12u, framer.write(&stream[16], stream.size() - 16));
+	CHECK(framer.next(frame));
+	CHECK_EQUAL(14u, frame.length);
+	CHECK_EQUAL(0u, frame.data[4]);
+
+	//-Garbage only: everything but a possible partial sync word is dropped
+	const uint8_t garbage[6] = {1, 2, 3, 4, 5, 0xEB};
+	framer.reset();
+	CHECK_EQUAL(6u, framer.write(garbage, sizeof(garbage)));
+	CHECK(!framer.next(frame));
+	CHECK_EQUAL(5u, framer.discarded());
+	CHECK_EQUAL(1u, framer.available());
+	CHECK_EQUAL(0u, framer.write(NULL, 4));
+}
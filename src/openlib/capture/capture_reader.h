@@ -0,0 +1,208 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_CAPTURE_CAPTURE_READER_H
+#define OPENLIB_CAPTURE_CAPTURE_READER_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/enum/access_pattern.h"
+#include "openlib/capture/struct/capture_format.h"
+#include "openlib/utils/mapped_file.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace capture
+    {
+        /**
+         * Zero-copy replay of a capture file: the file is memory mapped (read ahead hinted as sequential) and
+         * the frames handed out as views onto the mapping, ready for MessageICD::decode, MessageView or
+         * MessageRegistry::dispatch. Payloads start 8 bytes aligned
+         */
+        class CaptureReader : public NonCopyable
+        {
+            public:
+                /**
+                 * Frame view, valid while the capture is open
+                 */
+                struct Frame
+                {
+                    uint64_t        timestamp;  //-Nanoseconds since the epoch
+                    uint32_t        channel;
+                    const uint8_t*  data;
+                    size_t          length;
+                };
+
+                //-Constructor & Destructor
+                CaptureReader() : data_(NULL), length_(0), position_(0), frames_(0), truncated_(false) {};
+                virtual ~CaptureReader() { close(); };
+
+                //-Accessor
+                inline bool is_open() const                 { return NULL != data_; }
+                inline const size_t& length() const         { return length_;       }
+                inline const size_t& position() const       { return position_;     }
+                inline const size_t& frames() const         { return frames_;       }
+                inline bool truncated() const               { return truncated_;    }
+
+                //-Ancillary functions
+                inline bool open_file(const std::string& path, const bool& huge_pages = false);
+                inline bool open(const void* data, const size_t& length);
+                inline void close();
+                inline bool next(Frame& frame);
+                inline void rewind();
+
+            protected:
+                //-Functions
+                inline bool bind(const uint8_t* data, const size_t& length);
+
+                //-Fields
+                utils::MappedFile   file_;
+                const uint8_t*      data_;
+                size_t              length_;
+                size_t              position_;  //-Next record
+                size_t              frames_;    //-Frames read since the last rewind
+                bool                truncated_; //-The last record runs past the end of the capture
+
+        }; /*class CaptureReader*/
+
+        /**
+         * Maps a capture file (closes the previous one)
+         * @param path The path to the file
+         * @param huge_pages Whether to ask for transparent huge pages (best effort @see MappedFile::advise)
+         * @return true on success (false if it cannot be opened or it is not a capture of this byte order)
+         */
+        bool CaptureReader::open_file(const std::string& path, const bool& huge_pages)
+        {
+            close();
+            if (!file_.open(path))
+            {
+                return false;
+            }
+            file_.advise(AccessPattern_Sequential, huge_pages);
+            if (!bind(file_.data(), file_.length()))
+            {
+                file_.close();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Reads an in memory capture (closes the previous one), the memory must outlive the reader
+         * @param data The capture
+         * @param length The length of the capture
+         * @return true on success
+         */
+        bool CaptureReader::open(const void* data, const size_t& length)
+        {
+            close();
+            return bind((const uint8_t*) data, length);
+        }
+
+        /**
+         * Checks the header and starts at the first frame
+         * @param data The capture
+         * @param length The length of the capture
+         * @return true if it is a capture of this byte order
+         */
+        bool CaptureReader::bind(const uint8_t* data, const size_t& length)
+        {
+            if (NULL == data || length < sizeof(CaptureHeader))
+            {
+                return false;
+            }
+            CaptureHeader header;
+            memcpy(&header, data, sizeof(header));
+            if (0 != memcmp(header.magic, CAPTURE_MAGIC, sizeof(header.magic)) ||
+                CAPTURE_VERSION != header.version || CAPTURE_BYTE_ORDER != header.byte_order)
+            {
+                return false;
+            }
+            data_ = data;
+            length_ = length;
+            rewind();
+            return true;
+        }
+
+        /**
+         * Releases the capture
+         */
+        void CaptureReader::close()
+        {
+            file_.close();
+            data_ = NULL;
+            length_ = 0;
+            position_ = 0;
+            frames_ = 0;
+            truncated_ = false;
+        }
+
+        /**
+         * Takes the next frame
+         * @param frame (output) The frame view
+         * @return true if a frame was read, false at the end of the capture (@see truncated)
+         */
+        bool CaptureReader::next(Frame& frame)
+        {
+            if (NULL == data_ || position_ + sizeof(CaptureRecord) > length_)
+            {
+                truncated_ = (NULL != data_ && position_ < length_);
+                return false;
+            }
+            CaptureRecord record;
+            memcpy(&record, data_ + position_, sizeof(record));
+            const size_t payload = position_ + sizeof(CaptureRecord);
+            if (record.length > length_ - payload)
+            {
+                truncated_ = true;
+                return false;
+            }
+            frame.timestamp = record.timestamp;
+            frame.channel = record.channel;
+            frame.data = data_ + payload;
+            frame.length = record.length;
+
+            const size_t alignment = CAPTURE_ALIGNMENT;
+            position_ = std::min(length_, (payload + record.length + alignment - 1) & ~(alignment - 1));
+            ++frames_;
+            return true;
+        }
+
+        /**
+         * Goes back to the first frame
+         */
+        void CaptureReader::rewind()
+        {
+            position_ = (NULL == data_) ? 0 : sizeof(CaptureHeader);
+            frames_ = 0;
+            truncated_ = false;
+        }
+
+    };/*namespace capture*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_CAPTURE_CAPTURE_READER_H*/
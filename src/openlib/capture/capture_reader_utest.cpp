@@ -0,0 +1,177 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "capture_reader.h"
+#include "capture_writer.h"
+#include "openlib/icd/message_view.h"
+#include "openlib/icd/text_icd_parser.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::capture;
+using namespace openlib::icd;
+
+static const size_t CAPTURE_FRAMES = 50;
+
+TEST_GROUP(capture_reader)
+{
+	vector<uint8_t> capture;
+	vector<vector<uint8_t> > frames;
+
+	void setup()
+	{
+		srand(3);
+		CaptureWriter::append_header(capture);
+		frames.resize(CAPTURE_FRAMES);
+		for (size_t i = 0; i < CAPTURE_FRAMES; ++i)
+		{
+			frames[i].resize(i % 13);
+			for (size_t j = 0; j < frames[i].size(); ++j)
+			{
+				frames[i][j] = (uint8_t) rand();
+			}
+			CHECK(CaptureWriter::append(capture, 1000 + i, (uint32_t) (i % 3), frames[i].data(), frames[i].size()));
+		}
+	}
+
+	void teardown()
+	{
+	}
+
+	/**
+	 * Reads all the frames of a capture and checks them against the recorded ones
+	 */
+	void check_frames(CaptureReader& reader)
+	{
+		CaptureReader::Frame frame;
+		for (size_t i = 0; i < CAPTURE_FRAMES; ++i)
+		{
+			CHECK(reader.next(frame));
+			CHECK_EQUAL(1000 + i, frame.timestamp);
+			CHECK_EQUAL(i % 3, frame.channel);
+			CHECK_EQUAL(frames[i].size(), frame.length);
+			CHECK(0 == frame.length || 0 == memcmp(frames[i].data(), frame.data, frame.length));
+		}
+		CHECK(!reader.next(frame));
+		CHECK(!reader.truncated());
+		CHECK_EQUAL(CAPTURE_FRAMES, reader.frames());
+	}
+};
+
+TEST(capture_reader, Test_memory)
+{
+	CaptureReader reader;
+	CHECK(reader.open(capture.data(), capture.size()));
+	check_frames(reader);
+
+	//-Zero-copy, aligned payloads
+	reader.rewind();
+	CaptureReader::Frame frame;
+	CHECK(reader.next(frame));
+	CHECK(reader.next(frame));
+	CHECK(frame.data > capture.data() && frame.data < capture.data() + capture.size());
+	CHECK_EQUAL(0u, (size_t) (frame.data - capture.data()) % 8);
+	reader.rewind();
+	check_frames(reader);
+}
+
+TEST(capture_reader, Test_file)
+{
+	char path[] = "/tmp/capture_XXXXXX";
+	close(mkstemp(path));
+
+	CaptureWriter writer;
+	CHECK(writer.open(path));
+	for (size_t i = 0; i < CAPTURE_FRAMES; ++i)
+	{
+		CHECK(writer.write(1000 + i, (uint32_t) (i % 3), frames[i].data(), frames[i].size()));
+	}
+	CHECK_EQUAL(CAPTURE_FRAMES, writer.frames());
+	CHECK(writer.close());
+
+	CaptureReader reader;
+	CHECK(reader.open_file(path, true));
+	CHECK_EQUAL(capture.size(), reader.length());
+	check_frames(reader);
+	reader.close();
+	CHECK(!reader.is_open());
+	remove(path);
+	CHECK(!reader.open_file(path));
+}
+
+TEST(capture_reader, Test_decode)
+{
+	MessageICD message;
+	TextICDParser parser;
+	CHECK_EQUAL(ParserError_None, parser.parse(string("field id uint8 0 0 8 BE\nfield value uint32 1 0 32 LE\n"), message));
+	CHECK_EQUAL(ParserError_None, message.compile());
+
+	vector<uint8_t> replay;
+	CaptureWriter::append_header(replay);
+	const uint8_t frame_data[5] = {7, 0x78, 0x56, 0x34, 0x12};
+	CHECK(CaptureWriter::append(replay, 1, 0, frame_data, sizeof(frame_data)));
+
+	//-Frames go straight to the decoders
+	CaptureReader reader;
+	CHECK(reader.open(replay.data(), replay.size()));
+	CaptureReader::Frame frame;
+	CHECK(reader.next(frame));
+	CHECK_EQUAL(ParserError_None, message.decode(frame.data, frame.length));
+	CHECK_EQUAL(0x12345678u, *message.field(message.find("value"))->as_uint32());
+	MessageView view(frame.data, frame.length, message);
+	CHECK_EQUAL(7u, view.get<uint8_t>(message.find("id")));
+}
+
+TEST(capture_reader, Test_errors)
+{
+	CaptureReader reader;
+	CaptureReader::Frame frame;
+	CHECK(!reader.next(frame));
+	CHECK(!reader.open(capture.data(), sizeof(CaptureHeader) - 1));
+	CHECK(!reader.open(NULL, 0));
+
+	vector<uint8_t> corrupted(capture);
+	corrupted[0] = 'X';
+	CHECK(!reader.open(corrupted.data(), corrupted.size()));
+	corrupted[0] = CAPTURE_MAGIC[0];
+	corrupted[12] ^= 0xFF;
+	CHECK(!reader.open(corrupted.data(), corrupted.size()));
+
+	//-A frame cut short stops the replay
+	CHECK(reader.open(capture.data(), capture.size() - 8));
+	size_t count = 0;
+	while (reader.next(frame))
+	{
+		++count;
+	}
+	CHECK_EQUAL(CAPTURE_FRAMES - 1, count);
+	CHECK(reader.truncated());
+}
@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_CAPTURE_CAPTURE_WRITER_H
+#define OPENLIB_CAPTURE_CAPTURE_WRITER_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/capture/struct/capture_format.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace capture
+    {
+        /**
+         * Records frames onto a capture file (@see CaptureReader), the records are staged on a buffer and
+         * written in large blocks
+         */
+        class CaptureWriter : public NonCopyable
+        {
+            public:
+                //-Constructor & Destructor
+                CaptureWriter() : file_(NULL), frames_(0) {};
+                virtual ~CaptureWriter() { close(); };
+
+                //-Accessor
+                inline bool is_open() const                 { return NULL != file_; }
+                inline const size_t& frames() const         { return frames_;       }
+
+                //-Ancillary functions
+                inline bool open(const std::string& path);
+                inline bool write(const uint64_t& timestamp, const uint32_t& channel, const void* data, const size_t& length);
+                inline bool flush();
+                inline bool close();
+                static inline void append_header(std::vector<uint8_t>& output);
+                static inline bool append(std::vector<uint8_t>& output, const uint64_t& timestamp, const uint32_t& channel, const void* data, const size_t& length);
+
+            protected:
+                //-Fields
+                FILE*                   file_;
+                std::vector<uint8_t>    staging_;
+                size_t                  frames_;
+
+        }; /*class CaptureWriter*/
+
+        /**
+         * Creates a capture file (closes the previous one)
+         * @param path The path to the file
+         * @return true on success
+         */
+        bool CaptureWriter::open(const std::string& path)
+        {
+            close();
+            file_ = fopen(path.c_str(), "wb");
+            if (NULL == file_)
+            {
+                return false;
+            }
+            staging_.clear();
+            append_header(staging_);
+            frames_ = 0;
+            return true;
+        }
+
+        /**
+         * Records a frame
+         * @param timestamp The reception time (nanoseconds since the epoch)
+         * @param channel The source of the frame
+         * @param data The frame
+         * @param length The length of the frame
+         * @return true on success
+         */
+        bool CaptureWriter::write(const uint64_t& timestamp, const uint32_t& channel, const void* data, const size_t& length)
+        {
+            if (NULL == file_ || !append(staging_, timestamp, channel, data, length))
+            {
+                return false;
+            }
+            ++frames_;
+            return (staging_.size() < (1 << 20)) || flush();
+        }
+
+        /**
+         * Writes the staged records
+         * @return true on success
+         */
+        bool CaptureWriter::flush()
+        {
+            if (NULL == file_)
+            {
+                return false;
+            }
+            const bool written = staging_.empty() || (staging_.size() == fwrite(&staging_[0], 1, staging_.size(), file_));
+            staging_.clear();
+            return written;
+        }
+
+        /**
+         * Writes the staged records and closes the file
+         * @return true on success (false if not open)
+         */
+        bool CaptureWriter::close()
+        {
+            if (NULL == file_)
+            {
+                return false;
+            }
+            const bool written = flush();
+            const bool closed = (0 == fclose(file_));
+            file_ = NULL;
+            return written && closed;
+        }
+
+        /**
+         * Appends the file header to an in memory capture
+         * @param output The capture
+         */
+        void CaptureWriter::append_header(std::vector<uint8_t>& output)
+        {
+            CaptureHeader header;
+            memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+            header.version = CAPTURE_VERSION;
+            header.byte_order = CAPTURE_BYTE_ORDER;
+            const uint8_t* header_ptr = reinterpret_cast<const uint8_t*> (&header);
+            output.insert(output.end(), header_ptr, header_ptr + sizeof(header));
+        }
+
+        /**
+         * Appends a frame record to an in memory capture
+         * @param output The capture (@see append_header)
+         * @param timestamp The reception time (nanoseconds since the epoch)
+         * @param channel The source of the frame
+         * @param data The frame
+         * @param length The length of the frame
+         * @return true on success (false if the frame is too long or NULL)
+         */
+        bool CaptureWriter::append(std::vector<uint8_t>& output, const uint64_t& timestamp, const uint32_t& channel, const void* data, const size_t& length)
+        {
+            if ((NULL == data && 0 != length) || length > 0xFFFFFFFF)
+            {
+                return false;
+            }
+            CaptureRecord record;
+            record.timestamp = timestamp;
+            record.length = (uint32_t) length;
+            record.channel = channel;
+            const uint8_t* record_ptr = reinterpret_cast<const uint8_t*> (&record);
+            output.insert(output.end(), record_ptr, record_ptr + sizeof(record));
+            if (0 != length)
+            {
+                output.insert(output.end(), (const uint8_t*) data, (const uint8_t*) data + length);
+            }
+            const size_t alignment = CAPTURE_ALIGNMENT;
+            output.resize((output.size() + alignment - 1) & ~(alignment - 1), 0);
+            return true;
+        }
+
+    };/*namespace capture*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_CAPTURE_CAPTURE_WRITER_H*/
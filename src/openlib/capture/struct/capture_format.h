@@ -0,0 +1,75 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_CAPTURE_CAPTURE_FORMAT_H
+#define OPENLIB_CAPTURE_CAPTURE_FORMAT_H
+
+//-Supporting libraries
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+//-Namespace/s
+namespace openlib
+{
+	namespace capture
+	{
+		/**
+		 * Capture file layout (@see CaptureReader, CaptureWriter): a header followed by the recorded frames
+		 * back to back, every record starting 8 bytes aligned (the payload is zero padded), the integers
+		 * are in the byte order of the writer (checked on load through 'byte_order')
+		 *
+		 *   CaptureHeader | CaptureRecord payload [padding] | CaptureRecord payload [padding] | ...
+		 */
+		static const char     CAPTURE_MAGIC[8]    = {'O', 'L', 'C', 'A', 'P', 'T', 'U', 'R'};
+		static const uint32_t CAPTURE_VERSION     = 1;
+		static const uint32_t CAPTURE_BYTE_ORDER  = 0x01020304;
+		static const size_t   CAPTURE_ALIGNMENT   = 8;
+
+		/**
+		 * File header
+		 */
+		struct CaptureHeader
+		{
+			char        magic[8];           //-CAPTURE_MAGIC
+			uint32_t    version;            //-CAPTURE_VERSION
+			uint32_t    byte_order;         //-CAPTURE_BYTE_ORDER as written
+		};/*CaptureHeader*/
+
+		/**
+		 * Frame record header, followed by 'length' bytes of payload
+		 */
+		struct CaptureRecord
+		{
+			uint64_t    timestamp;          //-Reception time (nanoseconds since the epoch)
+			uint32_t    length;             //-Payload length
+			uint32_t    channel;            //-Source of the frame (user defined)
+		};/*CaptureRecord*/
+
+		//-The layout must not depend on the compiler
+		static_assert(sizeof(CaptureHeader) == 16, "CaptureHeader: unexpected padding");
+		static_assert(sizeof(CaptureRecord) == 16, "CaptureRecord: unexpected padding");
+		static_assert(std::is_trivially_copyable<CaptureRecord>::value, "Capture records are read in place");
+
+	};/*namespace capture*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_CAPTURE_CAPTURE_FORMAT_H*/
@@ -25,8 +25,8 @@
 #include <stdint.h>
 
 //-Ancillary macros
-#define BYTE2BIT(b) (b*8)
-#define BIT2BYTE(b) (b/8)
+#define BYTE2BIT(b) ((b)*8)
+#define BIT2BYTE(b) ((b)/8)
 #define GET_BIT_ARRAY(array, n) ((((uint8_t*)array)[n/8] >> ((7-n)%8)) & 0x01)
 #define SET_BIT_ARRAY(array, n, bit_value) ((((uint8_t*)array)[n/8] >> ((7-n)%8)) & 0x01)
 
@@ -0,0 +1,70 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ENUM_ACCESS_PATTERN_H
+#define OPENLIB_ENUM_ACCESS_PATTERN_H
+
+//-Suporting libraries
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+        /**
+         * Expected access pattern of a memory region (paging hint)
+         */
+        enum AccessPattern
+        {
+            //-Safety
+            AccessPattern_Min   = -1,
+
+            //-Type
+            AccessPattern_Normal = 0,       /**< No particular order */
+            AccessPattern_Sequential,       /**< Read once, front to back (aggressive read ahead) */
+            AccessPattern_Random,           /**< Scattered reads (no read ahead) */
+            AccessPattern_WillNeed,         /**< Read soon (prefetch the whole region) */
+
+            //-Safety
+            AccessPattern_Max,
+
+        }; /*enum AccessPattern*/
+
+        /**
+         * Converts an AccessPattern to a human readable form std::string
+         * @param value The AccessPattern to be converted
+         * @return std::string containing the human-readable string
+         */
+        inline std::string to_string(const AccessPattern& value)
+        {
+            switch (value)
+            {
+                case AccessPattern_Normal       : return "Normal";
+                case AccessPattern_Sequential   : return "Sequential";
+                case AccessPattern_Random       : return "Random";
+                case AccessPattern_WillNeed     : return "WillNeed";
+                default:
+                    return "Invalid";
+            }
+        }
+
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ENUM_ACCESS_PATTERN_H*/
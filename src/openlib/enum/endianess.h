@@ -81,9 +81,15 @@ namespace openlib
         }
 
         /**
-         * Returns the current system endianess
+         * Returns the current system endianess (a compile time constant when the compiler exposes the byte order)
          * @return Endianess of the system
          */
+        #if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+        inline constexpr Endianess system_endianess()
+        {
+            return (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? Endianess_LittleEndian : Endianess_BigEndian;
+        }
+        #else
         inline Endianess system_endianess()
         {
             int n = 1;
@@ -96,6 +102,7 @@ namespace openlib
                 return Endianess_BigEndian;
             }
         }
+        #endif
 
 };/*namespace openlib*/
 
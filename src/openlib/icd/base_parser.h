@@ -23,7 +23,8 @@
 #define OPENLIB_ICD_BASE_PARSER_H
 
 //-Supporting libraries
-#include "openlib/icd/message_icd.h""
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/enum/parser_error.h"
 #include <string>
 #include <map>
 #include <set>
@@ -33,11 +34,6 @@ namespace openlib
 {
 	namespace icd
 	{
-        enum ParserError
-        {
-            ParserError_None,
-        };
-
 		/**
 		 * Parses a data field
 		 */
@@ -50,6 +46,17 @@ namespace openlib
 				virtual ParserError parse(const std::string& text, MessageICD& icd_message) = 0;
 				virtual ParserError parse(const void* data, const size_t data_length, MessageICD& icd_message) = 0;
 
+		    protected:
+		        //-Access to the message being populated (friendship is not inherited)
+		        static inline bool adopt(MessageICD& icd_message, DataDescriptor* data_descriptor)  { return icd_message.adopt(data_descriptor); }
+		        static inline DataDescriptor* emplace(MessageICD& icd_message, const DataType& data_type, const std::string& name, const size_t& byte_offset,
+		                                              const size_t& bit_offset, const size_t& num_bits, const openlib::Endianess& endianess)
+		        {
+		            return icd_message.emplace(data_type, name, byte_offset, bit_offset, num_bits, endianess);
+		        }
+		        static inline void clear(MessageICD& icd_message)                                   { icd_message.clear(); }
+		        static inline void reserve(MessageICD& icd_message, const size_t& num_fields)       { icd_message.reserve(num_fields); }
+
 		}; /*class BaseICDParser*/
 
 
@@ -0,0 +1,389 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_COLUMN_BATCH_H
+#define OPENLIB_ICD_COLUMN_BATCH_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/enum/endianess.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/value_arena.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Batch decode of many messages of the same layout onto columns (structure of arrays): one
+         * contiguous, typed column per field of the plan, row i holding the value of the message i
+         * The kernel runs field by field across all the messages, the layout arithmetic of the field
+         * being loop invariant the shift/mask/swap loop vectorizes
+         */
+        class ColumnBatch : public NonCopyable
+        {
+            //-Chunked decode onto the columns of a batch (@see ParallelDecoder)
+            friend class ParallelDecoder;
+
+            public:
+                //-Constructor & Destructor
+                ColumnBatch() : plan_(NULL), capacity_(0), size_(0) {};
+                virtual ~ColumnBatch() {};
+
+                //-Accessor
+                inline size_t size() const                  { return size_;         }
+                inline size_t capacity() const              { return capacity_;     }
+                inline size_t num_columns() const           { return columns_.size(); }
+                inline const uint8_t* column(const size_t& field_idx) const;
+                template <typename T>
+                inline const T* column(const size_t& field_idx) const;
+
+                //-Ancillary functions
+                inline void reserve(const MessagePlan& plan, const size_t& num_messages);
+                inline ParserError decode(const uint8_t* buffer, const size_t& stride, const size_t& num_messages);
+                inline ParserError decode(const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages);
+                inline void release();
+
+                //-Kernels (columns supplied by the caller, 'data_length' bytes per row)
+                static inline ParserError decode(const MessagePlan& plan, const uint8_t* buffer, const size_t& stride, const size_t& num_messages, uint8_t* const* columns);
+                static inline ParserError decode(const MessagePlan& plan, const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, uint8_t* const* columns);
+
+            protected:
+                /**
+                 * Messages back to back on a single buffer
+                 */
+                struct StridedRows
+                {
+                    const uint8_t*  buffer;
+                    size_t          stride;
+                    inline const uint8_t* operator[](const size_t& row) const   { return buffer + row * stride; }
+                };
+
+                /**
+                 * Messages on their own buffers
+                 */
+                struct PointerRows
+                {
+                    const uint8_t* const* buffers;
+                    inline const uint8_t* operator[](const size_t& row) const   { return buffers[row]; }
+                };
+
+                //-Functions
+                template <typename Rows>
+                static inline void decode_columns(const MessagePlan& plan, const Rows& rows, const size_t& row_length, const size_t& num_messages, const size_t& bulk_length, uint8_t* const* columns);
+                template <typename Rows, typename T>
+                static inline void decode_integers(const FieldOperation& operation, const Rows& rows, const size_t& row_length, const size_t& num_messages, const size_t& num_loads, T* column);
+
+                //-Fields
+                const MessagePlan*      plan_;
+                ValueArena              arena_;
+                std::vector<uint8_t*>   columns_;
+                size_t                  capacity_;  //-Rows per column
+                size_t                  size_;      //-Rows decoded
+
+        }; /*class ColumnBatch*/
+
+        /**
+         * Lays out one column per field of a plan (single allocation, cache line aligned columns)
+         * IMPORTANT: the plan must outlive the batch (or the next reserve)
+         * @param plan The compiled plan (@see MessageICD::plan)
+         * @param num_messages The number of rows
+         */
+        void ColumnBatch::reserve(const MessagePlan& plan, const size_t& num_messages)
+        {
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+            const size_t alignment = ValueArena::ALIGNMENT;
+            size_t arena_length = 0;
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                arena_length = ValueArena::align(arena_length, alignment) + num_messages * operations[field_idx].data_length;
+            }
+            ValueArena arena;
+            arena.reserve(arena_length);
+            columns_.resize(operations.size());
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                columns_[field_idx] = arena.allocate(num_messages * operations[field_idx].data_length, alignment);
+            }
+            arena_.swap(arena);
+            plan_ = &plan;
+            capacity_ = num_messages;
+            size_ = 0;
+        }
+
+        /**
+         * Decodes messages back to back on a buffer onto the columns
+         * @param buffer The first message
+         * @param stride The distance between messages (>= plan min_buffer_length)
+         * @param num_messages The number of messages (<= capacity)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ColumnBatch::decode(const uint8_t* buffer, const size_t& stride, const size_t& num_messages)
+        {
+            size_ = 0;
+            if (NULL == plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            if (num_messages > capacity_)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            const ParserError error = decode(*plan_, buffer, stride, num_messages, columns_.data());
+            if (ParserError_None == error)
+            {
+                size_ = num_messages;
+            }
+            return error;
+        }
+
+        /**
+         * Decodes messages on their own buffers onto the columns
+         * @param buffers The messages
+         * @param buffer_length The length of every message buffer (>= plan min_buffer_length)
+         * @param num_messages The number of messages (<= capacity)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ColumnBatch::decode(const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages)
+        {
+            size_ = 0;
+            if (NULL == plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            if (num_messages > capacity_)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            const ParserError error = decode(*plan_, buffers, buffer_length, num_messages, columns_.data());
+            if (ParserError_None == error)
+            {
+                size_ = num_messages;
+            }
+            return error;
+        }
+
+        /**
+         * Releases the columns
+         */
+        void ColumnBatch::release()
+        {
+            arena_.release();
+            columns_.clear();
+            plan_ = NULL;
+            capacity_ = 0;
+            size_ = 0;
+        }
+
+        /**
+         * Access to a column
+         * @param field_idx The field index (offset order, @see MessagePlan::index_of)
+         * @return The column ('data_length' bytes per row), NULL if out of range
+         */
+        const uint8_t* ColumnBatch::column(const size_t& field_idx) const
+        {
+            return (field_idx < columns_.size()) ? columns_[field_idx] : NULL;
+        }
+
+        /**
+         * Typed access to a column
+         * @tparam T The value type, its size must match the field value container
+         * @param field_idx The field index (offset order, @see MessagePlan::index_of)
+         * @return The column, NULL if out of range or the size of the type does not match
+         */
+        template <typename T>
+        const T* ColumnBatch::column(const size_t& field_idx) const
+        {
+            if (field_idx >= columns_.size() || sizeof(T) != plan_->operations()[field_idx].data_length)
+            {
+                return NULL;
+            }
+            return reinterpret_cast<const T*> (columns_[field_idx]);
+        }
+
+        /**
+         * Decodes messages back to back on a buffer onto columns
+         * @param plan The compiled plan
+         * @param buffer The first message
+         * @param stride The distance between messages (>= plan min_buffer_length)
+         * @param num_messages The number of messages
+         * @param columns The columns, one per field of the plan with room for 'num_messages' rows
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ColumnBatch::decode(const MessagePlan& plan, const uint8_t* buffer, const size_t& stride, const size_t& num_messages, uint8_t* const* columns)
+        {
+            if (NULL == buffer || NULL == columns)
+            {
+                return ParserError_NullParameter;
+            }
+            if (stride < plan.min_buffer_length())
+            {
+                return ParserError_NotEnoughData;
+            }
+            const StridedRows rows = {buffer, stride};
+            decode_columns(plan, rows, stride, num_messages, num_messages * stride, columns);
+            return ParserError_None;
+        }
+
+        /**
+         * Decodes messages on their own buffers onto columns
+         * @param plan The compiled plan
+         * @param buffers The messages
+         * @param buffer_length The length of every message buffer (>= plan min_buffer_length)
+         * @param num_messages The number of messages
+         * @param columns The columns, one per field of the plan with room for 'num_messages' rows
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ColumnBatch::decode(const MessagePlan& plan, const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, uint8_t* const* columns)
+        {
+            if (NULL == buffers || NULL == columns)
+            {
+                return ParserError_NullParameter;
+            }
+            for (size_t row = 0; row < num_messages; ++row)
+            {
+                if (NULL == buffers[row])
+                {
+                    return ParserError_NullParameter;
+                }
+            }
+            if (buffer_length < plan.min_buffer_length())
+            {
+                return ParserError_NotEnoughData;
+            }
+            const PointerRows rows = {buffers};
+            decode_columns(plan, rows, buffer_length, num_messages, 0, columns);
+            return ParserError_None;
+        }
+
+        /**
+         * Decodes all the fields, a field at a time across all the messages
+         * @param plan The compiled plan
+         * @param rows The messages
+         * @param row_length The length of every message
+         * @param num_messages The number of messages
+         * @param bulk_length The bytes readable from the first message (back to back messages), 0 otherwise
+         * @param columns The columns
+         */
+        template <typename Rows>
+        void ColumnBatch::decode_columns(const MessagePlan& plan, const Rows& rows, const size_t& row_length, const size_t& num_messages, const size_t& bulk_length, uint8_t* const* columns)
+        {
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                const FieldOperation& operation = operations[field_idx];
+                uint8_t* column = columns[field_idx];
+                if (FieldOperationKind_Bytes == operation.kind)
+                {
+                    for (size_t row = 0; row < num_messages; ++row)
+                    {
+                        MessagePlan::decode_bytes(operation, rows[row], row_length, column + row * operation.data_length);
+                    }
+                    continue;
+                }
+
+                //-Rows whose 64-bits window can be loaded straight (may read into the next message when back to back)
+                const size_t window_end = operation.byte_index + sizeof(uint64_t);
+                size_t num_loads = 0;
+                if (0 == operation.spill_bits && row_length >= window_end)
+                {
+                    num_loads = num_messages;
+                }
+                else if (0 == operation.spill_bits && num_messages > 0 && bulk_length >= window_end)
+                {
+                    num_loads = std::min(num_messages, (bulk_length - window_end) / row_length + 1);
+                }
+
+                switch (operation.data_length)
+                {
+                    case sizeof(uint8_t)  : decode_integers(operation, rows, row_length, num_messages, num_loads, (uint8_t*) column);  break;
+                    case sizeof(uint16_t) : decode_integers(operation, rows, row_length, num_messages, num_loads, (uint16_t*) column); break;
+                    case sizeof(uint32_t) : decode_integers(operation, rows, row_length, num_messages, num_loads, (uint32_t*) column); break;
+                    default:
+                        decode_integers(operation, rows, row_length, num_messages, num_loads, (uint64_t*) column);
+                }
+            }
+        }
+
+        /**
+         * Decodes an integral field across all the messages
+         * @tparam Rows The message access (StridedRows, PointerRows)
+         * @tparam T The column type (two's complement bits for signed values)
+         * @param operation The field operation
+         * @param rows The messages
+         * @param row_length The length of every message
+         * @param num_messages The number of messages
+         * @param num_loads The first rows whose window can be loaded straight
+         * @param column The column
+         */
+        template <typename Rows, typename T>
+        void ColumnBatch::decode_integers(const FieldOperation& operation, const Rows& rows, const size_t& row_length, const size_t& num_messages, const size_t& num_loads, T* column)
+        {
+            const size_t byte_index = operation.byte_index;
+            const size_t window_shift = operation.window_shift;
+            const size_t swap_shift = operation.swap_shift;
+            const uint64_t mask = operation.mask;
+            const uint64_t sign_bit = operation.sign_bit;
+            const bool swap_window = (Endianess_LittleEndian == system_endianess());
+
+            //-Hot loops: load, shift, mask, (swap), sign extend
+            if (!operation.swap)
+            {
+                for (size_t row = 0; row < num_loads; ++row)
+                {
+                    uint64_t window;
+                    memcpy(&window, rows[row] + byte_index, sizeof(window));
+                    window = swap_window ? buffer::swap_endian(window) : window;
+                    const uint64_t raw = (window >> window_shift) & mask;
+                    column[row] = (T) ((raw ^ sign_bit) - sign_bit);
+                }
+            }
+            else
+            {
+                for (size_t row = 0; row < num_loads; ++row)
+                {
+                    uint64_t window;
+                    memcpy(&window, rows[row] + byte_index, sizeof(window));
+                    window = swap_window ? buffer::swap_endian(window) : window;
+                    const uint64_t raw = buffer::swap_endian((window >> window_shift) & mask) >> swap_shift;
+                    column[row] = (T) ((raw ^ sign_bit) - sign_bit);
+                }
+            }
+
+            //-Tail of the buffers, fields spilling onto a 9th byte
+            for (size_t row = num_loads; row < num_messages; ++row)
+            {
+                column[row] = (T) MessagePlan::decode_field(operation, rows[row], row_length);
+            }
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_COLUMN_BATCH_H*/
@@ -0,0 +1,99 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "column_batch.h"
+#include "decode_fixture_utest.h"
+#include <stdint.h>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const size_t NUM_MESSAGES = 37;
+
+TEST_GROUP(column_batch)
+{
+	DecodeFixture fixture;
+
+	void setup()
+	{
+		fixture.setup(NUM_MESSAGES, 11);
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(column_batch, Test_strided)
+{
+	const MessageICD& message = fixture.message;
+	ColumnBatch batch;
+	batch.reserve(message.plan(), NUM_MESSAGES);
+	CHECK_EQUAL(NUM_MESSAGES, batch.capacity());
+	CHECK_EQUAL(message.size(), batch.num_columns());
+	CHECK_EQUAL(ParserError_None, batch.decode(fixture.buffers.data(), FIXTURE_LENGTH, NUM_MESSAGES));
+	fixture.check_columns(batch);
+
+	//-Typed columns
+	CHECK(NULL != batch.column<int16_t>(message.find("count")));
+	CHECK(NULL == batch.column<int32_t>(message.find("count")));
+	CHECK(NULL == batch.column(message.size()));
+	CHECK_EQUAL(0u, ((uintptr_t) batch.column(1)) % 64);
+	const int8_t* delta = batch.column<int8_t>(message.find("delta"));
+	for (size_t row = 0; row < NUM_MESSAGES; ++row)
+	{
+		CHECK(delta[row] >= -16 && delta[row] <= 15);
+	}
+}
+
+TEST(column_batch, Test_pointers)
+{
+	vector<const uint8_t*> rows(NUM_MESSAGES);
+	for (size_t row = 0; row < NUM_MESSAGES; ++row)
+	{
+		rows[row] = fixture.frame(row);
+	}
+	ColumnBatch batch;
+	batch.reserve(fixture.message.plan(), NUM_MESSAGES);
+	CHECK_EQUAL(ParserError_None, batch.decode(rows.data(), FIXTURE_LENGTH, NUM_MESSAGES));
+	fixture.check_columns(batch);
+}
+
+TEST(column_batch, Test_errors)
+{
+	ColumnBatch batch;
+	CHECK_EQUAL(ParserError_NullParameter, batch.decode(fixture.buffers.data(), FIXTURE_LENGTH, 1));
+	batch.reserve(fixture.message.plan(), 4);
+	CHECK_EQUAL(ParserError_ContainerTooSmall, batch.decode(fixture.buffers.data(), FIXTURE_LENGTH, 5));
+	CHECK_EQUAL(ParserError_NotEnoughData, batch.decode(fixture.buffers.data(), FIXTURE_LENGTH - 1, 4));
+	CHECK_EQUAL(ParserError_NullParameter, batch.decode((const uint8_t*) NULL, FIXTURE_LENGTH, 4));
+	const uint8_t* rows[2] = {fixture.buffers.data(), NULL};
+	CHECK_EQUAL(ParserError_NullParameter, batch.decode(rows, FIXTURE_LENGTH, 2));
+	CHECK_EQUAL(0u, batch.size());
+	CHECK_EQUAL(ParserError_None, batch.decode(fixture.buffers.data(), FIXTURE_LENGTH, 0));
+	batch.release();
+	CHECK_EQUAL(0u, batch.capacity());
+}
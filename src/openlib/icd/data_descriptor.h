@@ -26,12 +26,15 @@
 #include "openlib/common.h"
 #include "openlib/enum/endianess.h"
 #include "openlib/icd/enum/data_type.h"
+#include "openlib/icd/enum_table.h"
+#include "openlib/icd/struct/validation_rule.h"
 #include "openlib/utils/utils.h"
 #include "openlib/utils/string_fnc.h"
 #include <algorithm>
-#include <map>
 #include <string>
+#include <vector>
 #include <assert.h>
+#include <string.h>
 
 //-Namespace/s
 namespace openlib
@@ -45,9 +48,8 @@ namespace openlib
         {
             public:
                 //-Types
-                typedef std::map<int,std::string> EnumMap;
-                typedef EnumMap::const_iterator   EnumMapConstIterator;
                 typedef int (ValidateCallbackType (const DataDescriptor*, std::string& error_msg));
+                typedef std::vector<ValidationRule> ValidationRuleVector;
 
                 DataDescriptor( const DataType& data_type, const std::string& name,
                                 const size_t& byte_offset, const size_t& bit_offset,
@@ -60,7 +62,11 @@ namespace openlib
                     endianess_(endianess),
                     data_(NULL),
                     data_length_(0),
-                    validate_fnc_(NULL)
+                    validate_fnc_(NULL),
+                    owns_data_(false),
+                    local_data_(0),
+                    dirty_word_(NULL),
+                    dirty_mask_(0)
                 {
                     switch (data_type)
                     {
@@ -77,8 +83,16 @@ namespace openlib
                             //-Completeness
                             assert(false);
                     }
-                    //-Allocate the data container
-                    data_ = new uint8_t[data_length_];
+                    //-Data container: inline for values that fit, heap for larger byte arrays
+                    if (data_length_ <= sizeof(local_data_))
+                    {
+                        data_ = reinterpret_cast<uint8_t*> (&local_data_);
+                    }
+                    else
+                    {
+                        data_ = new uint8_t[data_length_]();
+                        owns_data_ = true;
+                    }
                 }
 
                 /**
@@ -86,7 +100,10 @@ namespace openlib
                  */
                 ~DataDescriptor()
                 {
-                    DeleteArray(data_);
+                    if (owns_data_)
+                    {
+                        DeleteArray(data_);
+                    }
                 }
 
                 //-Accessor
@@ -97,44 +114,79 @@ namespace openlib
                 inline const size_t& num_bits() const               { return num_bits_;         }
                 inline const openlib::Endianess& endianess() const  { return endianess_;        }
                 inline const uint8_t* data() const                  { return data_;             }
+                inline uint8_t* data()                              { return data_;             }
                 inline const size_t& data_length() const            { return data_length_;      }
-                inline const EnumMap& enum_map() const              { return enum_map_;         }
+                inline const EnumTable& enum_table() const          { return enum_table_;       }
+                inline EnumTable& enum_table()                      { return enum_table_;       }
 
                 //-8bits
                 inline uint8_t* as_uint8();
                 inline int8_t*  as_int8();
-                int8_t& int8()    {  return *(reinterpret_cast<int8_t*> (&data_[0])); }
-                uint8_t& uint8()  {  return *(reinterpret_cast<uint8_t*> (&data_[0])); }
+                inline const uint8_t* as_uint8() const;
+                inline const int8_t*  as_int8() const;
+                int8_t& int8()    {  mark_dirty(); return *(reinterpret_cast<int8_t*> (&data_[0])); }
+                uint8_t& uint8()  {  mark_dirty(); return *(reinterpret_cast<uint8_t*> (&data_[0])); }
+                int8_t int8() const     { return *(reinterpret_cast<const int8_t*> (&data_[0])); }
+                uint8_t uint8() const   { return *(reinterpret_cast<const uint8_t*> (&data_[0])); }
 
                 //-16-bits
                 inline uint16_t* as_uint16();
                 inline int16_t*  as_int16();
-                int16_t& int16()    {  return *(reinterpret_cast<int16_t*> (&data_[0])); }
-                uint16_t& uint16()  {  return *(reinterpret_cast<uint16_t*> (&data_[0])); }
+                inline const uint16_t* as_uint16() const;
+                inline const int16_t*  as_int16() const;
+                int16_t& int16()    {  mark_dirty(); return *(reinterpret_cast<int16_t*> (&data_[0])); }
+                uint16_t& uint16()  {  mark_dirty(); return *(reinterpret_cast<uint16_t*> (&data_[0])); }
+                int16_t int16() const   { return *(reinterpret_cast<const int16_t*> (&data_[0])); }
+                uint16_t uint16() const { return *(reinterpret_cast<const uint16_t*> (&data_[0])); }
 
 
                 //-32-bits
                 inline uint32_t* as_uint32();
                 inline int32_t*  as_int32();
-                int32_t& int32()    {  return *(reinterpret_cast<int32_t*> (&data_[0])); }
-                uint32_t& uint32()  {  return *(reinterpret_cast<uint32_t*> (&data_[0])); }
+                inline const uint32_t* as_uint32() const;
+                inline const int32_t*  as_int32() const;
+                int32_t& int32()    {  mark_dirty(); return *(reinterpret_cast<int32_t*> (&data_[0])); }
+                uint32_t& uint32()  {  mark_dirty(); return *(reinterpret_cast<uint32_t*> (&data_[0])); }
+                int32_t int32() const   { return *(reinterpret_cast<const int32_t*> (&data_[0])); }
+                uint32_t uint32() const { return *(reinterpret_cast<const uint32_t*> (&data_[0])); }
 
                 //-Enummeration
                 inline int* as_enum();
-                int& enum_val()     {  return *(reinterpret_cast<int*> (&data_[0])); }
+                inline const int* as_enum() const;
+                int& enum_val()     {  mark_dirty(); return *(reinterpret_cast<int*> (&data_[0])); }
+                int enum_val() const    { return *(reinterpret_cast<const int*> (&data_[0])); }
 
                 //-ASCII
                 inline char* as_ascii();
+                inline const char* as_ascii() const;
 
                 //-Binary
                 inline uint8_t* as_binary();
+                inline const uint8_t* as_binary() const;
 
                 //-Ancillary                
                 inline void set(const std::string& hex_str);
                 inline void set(const void* buffer, const size_t buffer_length);
                 inline void set_enum(const int&, const std::string& str_value);
-                inline std::string get_enum(const int& value, bool& found);
+                inline std::string get_enum(const int& value, bool& found) const;
+                inline const char* enum_label(const int& value) const;
+                inline bool enum_value(const char* label, const size_t& label_length, int& value) const;
                 inline int validate(std::string& error_msg) const;
+                inline void set_validate(ValidateCallbackType* validate_fnc)    { validate_fnc_ = validate_fnc; }
+
+                //-Declarative validation (@see MessageValidator)
+                inline void add_rule(const ValidationRule& rule)                { rules_.push_back(rule);   }
+                inline const ValidationRuleVector& rules() const                { return rules_;            }
+
+                //-Storage
+                inline size_t data_alignment() const;
+                inline void bind(uint8_t* storage);
+                inline void unbind();
+                inline bool is_bound() const;
+
+                //-Change tracking (the non-const value accessors and 'set' mark the value as changed, the const ones are reads)
+                inline void track(uint64_t* dirty_word, const uint64_t& dirty_mask)  { dirty_word_ = dirty_word; dirty_mask_ = dirty_mask; }
+                inline void mark_dirty()                                            { if (NULL != dirty_word_) { *dirty_word_ |= dirty_mask_; } }
 
             protected:
                 //-Fields
@@ -146,8 +198,13 @@ namespace openlib
                 openlib::Endianess      endianess_;
                 uint8_t*                data_;
                 size_t                  data_length_;
-                EnumMap                 enum_map_;
+                EnumTable               enum_table_;
                 ValidateCallbackType*   validate_fnc_;
+                ValidationRuleVector    rules_;
+                bool                    owns_data_;     //-'data_' was allocated by the descriptor
+                uint64_t                local_data_;    //-Inline data container
+                uint64_t*               dirty_word_;    //-Change tracking word (owned by the message)
+                uint64_t                dirty_mask_;    //-Change tracking bit within 'dirty_word_'
 
         };/*DataDescriptor*/
 
@@ -170,11 +227,11 @@ namespace openlib
         }DataDescriptorPtrCompareLess;
 
 
-        uint8_t* DataDescriptor::as_uint8()
+        const uint8_t* DataDescriptor::as_uint8() const
         {
-            uint8_t* retval = NULL;
+            const uint8_t* retval = NULL;
             if (DataType_uint8 == data_type_){
-                retval = reinterpret_cast<uint8_t* > (data_);
+                retval = reinterpret_cast<const uint8_t*> (data_);
             }
             else{
                 assert(false);
@@ -182,11 +239,17 @@ namespace openlib
             return retval;
         }
 
-        int8_t* DataDescriptor::as_int8()
+        uint8_t* DataDescriptor::as_uint8()
+        {
+            mark_dirty();
+            return const_cast<uint8_t*> (static_cast<const DataDescriptor*> (this)->as_uint8());
+        }
+
+        const int8_t* DataDescriptor::as_int8() const
         {
-            int8_t* retval = NULL;
+            const int8_t* retval = NULL;
             if (DataType_int8 == data_type_){
-                retval = reinterpret_cast<int8_t* > (data_);
+                retval = reinterpret_cast<const int8_t*> (data_);
             }
             else{
                 assert(false);
@@ -194,12 +257,18 @@ namespace openlib
             return retval;
         }
 
+        int8_t* DataDescriptor::as_int8()
+        {
+            mark_dirty();
+            return const_cast<int8_t*> (static_cast<const DataDescriptor*> (this)->as_int8());
+        }
 
-        uint16_t* DataDescriptor::as_uint16()
+
+        const uint16_t* DataDescriptor::as_uint16() const
         {
-            uint16_t* retval = NULL;
+            const uint16_t* retval = NULL;
             if (DataType_uint16 == data_type_){
-                retval = reinterpret_cast<uint16_t* > (data_);
+                retval = reinterpret_cast<const uint16_t*> (data_);
             }
             else{
                 assert(false);
@@ -207,11 +276,17 @@ namespace openlib
             return retval;
         }
 
-        int16_t* DataDescriptor::as_int16()
+        uint16_t* DataDescriptor::as_uint16()
         {
-            int16_t* retval = NULL;
+            mark_dirty();
+            return const_cast<uint16_t*> (static_cast<const DataDescriptor*> (this)->as_uint16());
+        }
+
+        const int16_t* DataDescriptor::as_int16() const
+        {
+            const int16_t* retval = NULL;
             if (DataType_int16 == data_type_){
-                retval = reinterpret_cast<int16_t* > (data_);
+                retval = reinterpret_cast<const int16_t*> (data_);
             }
             else{
                 assert(false);
@@ -219,20 +294,32 @@ namespace openlib
             return retval;
         }
 
-        uint32_t* DataDescriptor::as_uint32()
+        int16_t* DataDescriptor::as_int16()
         {
-            uint32_t* retval = NULL;
+            mark_dirty();
+            return const_cast<int16_t*> (static_cast<const DataDescriptor*> (this)->as_int16());
+        }
+
+        const uint32_t* DataDescriptor::as_uint32() const
+        {
+            const uint32_t* retval = NULL;
             if (DataType_uint32 == data_type_){
-                retval = reinterpret_cast<uint32_t* > (data_);
+                retval = reinterpret_cast<const uint32_t*> (data_);
             }
             return retval;
         }
 
-        int32_t* DataDescriptor::as_int32()
+        uint32_t* DataDescriptor::as_uint32()
+        {
+            mark_dirty();
+            return const_cast<uint32_t*> (static_cast<const DataDescriptor*> (this)->as_uint32());
+        }
+
+        const int32_t* DataDescriptor::as_int32() const
         {
-            int32_t* retval = NULL;
+            const int32_t* retval = NULL;
             if (DataType_int32 == data_type_){
-                retval = reinterpret_cast<int32_t*> (data_);
+                retval = reinterpret_cast<const int32_t*> (data_);
             }
             else{
                 assert(false);
@@ -240,11 +327,17 @@ namespace openlib
             return retval;
         }
 
-        int* DataDescriptor::as_enum()
+        int32_t* DataDescriptor::as_int32()
         {
-            int* retval = NULL;
+            mark_dirty();
+            return const_cast<int32_t*> (static_cast<const DataDescriptor*> (this)->as_int32());
+        }
+
+        const int* DataDescriptor::as_enum() const
+        {
+            const int* retval = NULL;
             if (DataType_enum == data_type_){
-                retval = reinterpret_cast<int*> (data_);
+                retval = reinterpret_cast<const int*> (data_);
             }
             else{
                 assert(false);
@@ -252,11 +345,17 @@ namespace openlib
             return retval;
         }
 
-        char* DataDescriptor::as_ascii()
+        int* DataDescriptor::as_enum()
+        {
+            mark_dirty();
+            return const_cast<int*> (static_cast<const DataDescriptor*> (this)->as_enum());
+        }
+
+        const char* DataDescriptor::as_ascii() const
         {
-            char* retval = NULL;
+            const char* retval = NULL;
             if (DataType_ascii == data_type_){
-                retval = reinterpret_cast<char*> (data_);
+                retval = reinterpret_cast<const char*> (data_);
             }
             else{
                 assert(false);
@@ -264,10 +363,16 @@ namespace openlib
             return retval;
         }
 
+        char* DataDescriptor::as_ascii()
+        {
+            mark_dirty();
+            return const_cast<char*> (static_cast<const DataDescriptor*> (this)->as_ascii());
+        }
+
         //-Binary
-        uint8_t* DataDescriptor::as_binary()
+        const uint8_t* DataDescriptor::as_binary() const
         {
-            uint8_t* retval = NULL;
+            const uint8_t* retval = NULL;
             if (DataType_binary == data_type_){
                 retval = data_;
             }
@@ -277,12 +382,19 @@ namespace openlib
             return retval;
         }
 
+        uint8_t* DataDescriptor::as_binary()
+        {
+            mark_dirty();
+            return const_cast<uint8_t*> (static_cast<const DataDescriptor*> (this)->as_binary());
+        }
+
         /**
          * Set the value from a hex string
          * @param hex_str
          */
         void DataDescriptor::set(const std::string& hex_str)
         {
+            mark_dirty();
             switch (data_type_)
             {
                 case DataType_uint8  :
@@ -335,6 +447,7 @@ namespace openlib
         void DataDescriptor::set(const void* buffer, const size_t buffer_length)
         {
             assert(buffer_length <= this->data_length_);
+            mark_dirty();
             memcpy(data_, buffer, std::min(buffer_length, data_length_));
         }
 
@@ -347,7 +460,7 @@ namespace openlib
         {
             if (DataType_enum == data_type_)
             {
-                this->enum_map_[value] = str_value;
+                this->enum_table_.set(value, str_value);
             }
             else{
                 assert(false);
@@ -360,17 +473,17 @@ namespace openlib
          * @param found (output) whether the string mapped was found for the given 'value'
          * @return string containing the mapped 'value' (@invalid type) if trying to access a non-enum type
          */
-        std::string DataDescriptor::get_enum(const int& value, bool& found)
+        std::string DataDescriptor::get_enum(const int& value, bool& found) const
         {
             std::string retval = "";
             found = false;
             if (DataType_enum == data_type_)
             {
-                EnumMapConstIterator it = enum_map_.find(value);
-                if (it != enum_map_.end())
+                const char* label = enum_table_.label(value);
+                if (NULL != label)
                 {
                     found = true;
-                    retval = it->second;
+                    retval = label;
                 }
             }else
             {
@@ -380,6 +493,90 @@ namespace openlib
             return retval;
         }
 
+        /**
+         * Retrieve the label of an enumeration value without allocating (@see EnumTable)
+         * @param value The value to be retrieved
+         * @return The label (null terminated, valid while the enumeration is not modified), NULL if not found
+         */
+        const char* DataDescriptor::enum_label(const int& value) const
+        {
+            return enum_table_.label(value);
+        }
+
+        /**
+         * Retrieve the value of an enumeration label (text to binary)
+         * @param label The label (not necessarily null terminated)
+         * @param label_length The length of the label
+         * @param value (output) The value
+         * @return true if found
+         */
+        bool DataDescriptor::enum_value(const char* label, const size_t& label_length, int& value) const
+        {
+            return enum_table_.value_of(label, label_length, value);
+        }
+
+        /**
+         * Natural alignment of the data container (byte arrays are byte aligned)
+         * @return size_t containing the alignment in bytes
+         */
+        size_t DataDescriptor::data_alignment() const
+        {
+            if (DataType_ascii == data_type_ || DataType_binary == data_type_)
+            {
+                return 1;
+            }
+            return data_length_;
+        }
+
+        /**
+         * Binds the data container onto an external storage (i.e. a message value arena), the current value
+         * is copied and the own container released. The storage must outlive the binding (@see unbind)
+         * @param storage The storage, at least 'data_length()' bytes aligned to 'data_alignment()'
+         */
+        void DataDescriptor::bind(uint8_t* storage)
+        {
+            if (NULL != storage && storage != data_)
+            {
+                memcpy(storage, data_, data_length_);
+                if (owns_data_)
+                {
+                    DeleteArray(data_);
+                    owns_data_ = false;
+                }
+                data_ = storage;
+            }
+        }
+
+        /**
+         * Moves the data container back from an external storage onto the descriptor, the value is kept
+         */
+        void DataDescriptor::unbind()
+        {
+            if (is_bound())
+            {
+                uint8_t* storage = data_;
+                if (data_length_ <= sizeof(local_data_))
+                {
+                    data_ = reinterpret_cast<uint8_t*> (&local_data_);
+                }
+                else
+                {
+                    data_ = new uint8_t[data_length_];
+                    owns_data_ = true;
+                }
+                memcpy(data_, storage, data_length_);
+            }
+        }
+
+        /**
+         * Whether the data container is bound to an external storage
+         * @return true if bound
+         */
+        bool DataDescriptor::is_bound() const
+        {
+            return !owns_data_ && data_ != reinterpret_cast<const uint8_t*> (&local_data_);
+        }
+
         /**
          * Call validation function (if set otherwise returns SUCCESS)
          * @return 0 must be SUCCESS, rest is customizable
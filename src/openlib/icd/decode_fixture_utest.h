@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_DECODE_FIXTURE_UTEST_H
+#define OPENLIB_ICD_DECODE_FIXTURE_UTEST_H
+
+//-Supporting libraries
+#include "column_batch.h"
+#include "message_icd.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+/**
+ * Every kind of field: narrow, signed, little-endian, spilling onto a 9th byte, byte arrays
+ */
+static const char* FIXTURE_ICD =
+	"field id      uint8   0 0 8  BE\n"
+	"field count   int16   1 0 16 LE\n"
+	"field flags   uint8   3 0 3  BE\n"
+	"field delta   int8    3 3 5  BE\n"
+	"field range   uint32  4 0 20 BE\n"
+	"field mode    enum    6 4 4  BE\n"
+	"field wide    int32   7 5 32 BE\n"
+	"field word    uint32  12 0 32 LE\n"
+	"field name    ascii   16 0 24 BE\n"
+	"field payload binary  19 4 16 BE\n";
+static const size_t FIXTURE_LENGTH = 22;
+
+/**
+ * Shared fixture of the decoding tests (column batch, parallel decoder, message record): the message
+ * of FIXTURE_ICD and a set of random frames, checked against a message by message decode
+ */
+struct DecodeFixture
+{
+	openlib::icd::MessageICD    message;
+	std::vector<uint8_t>        buffers;
+	size_t                      num_messages;
+
+	/**
+	 * Parses and compiles the message, fills the frames
+	 * @param messages The number of frames
+	 * @param seed The seed of the random frames
+	 */
+	void setup(const size_t& messages, const unsigned int& seed)
+	{
+		openlib::icd::TextICDParser parser;
+		CHECK_EQUAL(openlib::icd::ParserError_None, parser.parse(std::string(FIXTURE_ICD), message));
+		CHECK_EQUAL(openlib::icd::ParserError_None, message.compile());
+		CHECK_EQUAL(FIXTURE_LENGTH, message.plan().min_buffer_length());
+
+		srand(seed);
+		num_messages = messages;
+		buffers.resize(num_messages * FIXTURE_LENGTH);
+		for (size_t i = 0; i < buffers.size(); ++i)
+		{
+			buffers[i] = (uint8_t) rand();
+		}
+	}
+
+	/**
+	 * A frame
+	 * @param row The frame index
+	 * @return const uint8_t* pointing to the frame
+	 */
+	const uint8_t* frame(const size_t& row) const
+	{
+		return &buffers[row * FIXTURE_LENGTH];
+	}
+
+	/**
+	 * Checks the values decoded from a frame against a message decode of it
+	 * @tparam ValueFnc Callable returning the decoded value (const uint8_t*) of a field index
+	 * @param row The frame index
+	 * @param value The decoded values
+	 */
+	template <typename ValueFnc>
+	void check_row(const size_t& row, ValueFnc value)
+	{
+		CHECK_EQUAL(openlib::icd::ParserError_None, message.decode(frame(row), FIXTURE_LENGTH));
+		for (size_t field_idx = 0; field_idx < message.size(); ++field_idx)
+		{
+			const openlib::icd::DataDescriptor& field = *message.field(field_idx);
+			CHECK(0 == memcmp(field.data(), value(field_idx), field.data_length()));
+		}
+	}
+
+	/**
+	 * Checks the columns of a batch against a message by message decode
+	 * @param batch The batch holding every frame
+	 */
+	void check_columns(const openlib::icd::ColumnBatch& batch)
+	{
+		CHECK_EQUAL(num_messages, batch.size());
+		for (size_t row = 0; row < num_messages; ++row)
+		{
+			check_row(row, [&] (const size_t& field_idx)
+				{
+					return batch.column(field_idx) + row * message.field(field_idx)->data_length();
+				});
+		}
+	}
+};
+
+#endif /*OPENLIB_ICD_DECODE_FIXTURE_UTEST_H*/
@@ -83,6 +83,23 @@ namespace openlib
             return (DataType) value;
         }
 
+        /**
+         * Returns a DataType from its human readable form (@see to_string)
+         * @param value The string to be converted
+         * @return DataType represented by the string, DataType_Undefined if unknown
+         */
+        inline DataType data_type_from_string(const std::string &value)
+        {
+            for (int data_type = DataType_Min + 1; data_type < DataType_Max; ++data_type)
+            {
+                if (value == to_string((DataType) data_type))
+                {
+                    return (DataType) data_type;
+                }
+            }
+            return DataType_Undefined;
+        }
+
     };/*namespace icd*/
 };/*namespace openlib*/
 
@@ -22,17 +22,70 @@
 #ifndef OPENLIB_ICD_ENUM_PARSER_ERROR_H
 #define OPENLIB_ICD_ENUM_PARSER_ERROR_H
 
+//-Supporting libraries
+#include <string>
+
 //-Namespace/s
 namespace openlib
 {
     namespace icd
     {
 
+        /**
+         * Parser (encode/decode) error codes
+         */
         enum ParserError
         {
-            ParserError_None,
+            ParserError_None = 0,           /**< ParserError_None (SUCCESS) */
+            ParserError_NullParameter,      /**< ParserError_NullParameter */
+            ParserError_NotEnoughData,      /**< ParserError_NotEnoughData */
+            ParserError_ContainerTooSmall,  /**< ParserError_ContainerTooSmall */
+            ParserError_InvalidDataType,    /**< ParserError_InvalidDataType */
+
+            //-ICD definition parsing
+            ParserError_CannotOpen,         /**< ParserError_CannotOpen */
+            ParserError_SyntaxError,        /**< ParserError_SyntaxError */
+            ParserError_UnknownKeyword,     /**< ParserError_UnknownKeyword */
+            ParserError_InvalidNumber,      /**< ParserError_InvalidNumber */
+            ParserError_InvalidLayout,      /**< ParserError_InvalidLayout */
+            ParserError_DuplicatedField,    /**< ParserError_DuplicatedField */
+            ParserError_UnexpectedEnd,      /**< ParserError_UnexpectedEnd */
+
+            //-Binary schema loading
+            ParserError_InvalidSchema,      /**< ParserError_InvalidSchema */
+            ParserError_UnsupportedVersion, /**< ParserError_UnsupportedVersion */
+
+            //-Message dispatch
+            ParserError_DuplicatedMessage,  /**< ParserError_DuplicatedMessage */
+            ParserError_UnknownMessage,     /**< ParserError_UnknownMessage */
 
         };
+
+        //-Supporting functions
+        inline std::string to_string(const ParserError &value)
+        {
+            switch (value)
+            {
+                case ParserError_None              : return "none";
+                case ParserError_NullParameter     : return "null parameter";
+                case ParserError_NotEnoughData     : return "not enough data";
+                case ParserError_ContainerTooSmall : return "container too small";
+                case ParserError_InvalidDataType   : return "invalid data type";
+                case ParserError_CannotOpen        : return "cannot open";
+                case ParserError_SyntaxError       : return "syntax error";
+                case ParserError_UnknownKeyword    : return "unknown keyword";
+                case ParserError_InvalidNumber     : return "invalid number";
+                case ParserError_InvalidLayout     : return "invalid layout";
+                case ParserError_DuplicatedField   : return "duplicated field";
+                case ParserError_UnexpectedEnd     : return "unexpected end";
+                case ParserError_InvalidSchema     : return "invalid schema";
+                case ParserError_UnsupportedVersion: return "unsupported version";
+                case ParserError_DuplicatedMessage : return "duplicated message";
+                case ParserError_UnknownMessage    : return "unknown message";
+                default:
+                    return "invalid";
+            }
+        }
     };/*namespace icd*/
 };/*namespace openlib*/
 
@@ -0,0 +1,85 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_ENUM_RULE_KIND_H
+#define OPENLIB_ICD_ENUM_RULE_KIND_H
+
+//-Used namespaces
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+
+        /**
+         * Kind of validation rule (@see ValidationRule)
+         */
+        enum RuleKind
+        {
+            RuleKind_Min   = -1,
+
+            RuleKind_Range = 0,     /**< The value lies within [min, max] */
+            RuleKind_NonZero,       /**< The value is not zero */
+            RuleKind_ReservedZero,  /**< The bits of the mask are zero */
+            RuleKind_EnumSet,       /**< The value is one of the enumeration of the field */
+
+            RuleKind_Max,
+            RuleKind_Undefined,     /**< RuleKind_Undefined */
+
+        }; /*enum RuleKind*/
+
+        //-Supporting functions
+        inline std::string to_string(const RuleKind &value)
+        {
+            switch (value)
+            {
+                case RuleKind_Range         : return "range";
+                case RuleKind_NonZero       : return "nonzero";
+                case RuleKind_ReservedZero  : return "reserved";
+                case RuleKind_EnumSet       : return "enum";
+                default:
+                    return "invalid";
+            }
+        }
+
+        /**
+         * Returns a RuleKind from its human readable form (@see to_string)
+         * @param value The string to be converted
+         * @return RuleKind represented by the string, RuleKind_Undefined if unknown
+         */
+        inline RuleKind rule_kind_from_string(const std::string &value)
+        {
+            for (int rule_kind = RuleKind_Min + 1; rule_kind < RuleKind_Max; ++rule_kind)
+            {
+                if (value == to_string((RuleKind) rule_kind))
+                {
+                    return (RuleKind) rule_kind;
+                }
+            }
+            return RuleKind_Undefined;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_ENUM_RULE_KIND_H*/
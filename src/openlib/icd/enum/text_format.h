@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_ENUM_TEXT_FORMAT_H
+#define OPENLIB_ICD_ENUM_TEXT_FORMAT_H
+
+//-Used namespaces
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+
+        /**
+         * Text rendering of messages (@see TextSerializer)
+         */
+        enum TextFormat
+        {
+            TextFormat_Min   = -1,
+
+            TextFormat_Json = 0,    /**< One JSON object per line */
+            TextFormat_Csv,         /**< One comma separated row per line (RFC 4180 quoting) */
+
+            TextFormat_Max,
+            TextFormat_Undefined,   /**< TextFormat_Undefined */
+
+        }; /*enum TextFormat*/
+
+        //-Supporting functions
+        inline std::string to_string(const TextFormat &value)
+        {
+            switch (value)
+            {
+                case TextFormat_Json    : return "json";
+                case TextFormat_Csv     : return "csv";
+                default:
+                    return "invalid";
+            }
+        }
+
+        /**
+         * Returns a TextFormat from its human readable form (@see to_string)
+         * @param value The string to be converted
+         * @return TextFormat represented by the string, TextFormat_Undefined if unknown
+         */
+        inline TextFormat text_format_from_string(const std::string &value)
+        {
+            for (int text_format = TextFormat_Min + 1; text_format < TextFormat_Max; ++text_format)
+            {
+                if (value == to_string((TextFormat) text_format))
+                {
+                    return (TextFormat) text_format;
+                }
+            }
+            return TextFormat_Undefined;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_ENUM_TEXT_FORMAT_H*/
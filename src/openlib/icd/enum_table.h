@@ -0,0 +1,325 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_ENUM_TABLE_H
+#define OPENLIB_ICD_ENUM_TABLE_H
+
+//-Supporting libraries
+#include "openlib/utils/string_fnc.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <string_view>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Enumeration table of a field: value order array of entries over an interned label pool, a direct
+         * indexed table when the values span a compact range and a label hash for the reverse lookup
+         * Lookups do not allocate, the labels are null terminated and stay valid while the table is not
+         * modified. The indexes are laid out by build() (@see MessageICD::compile), until then the lookups
+         * fall back to a binary search (values) and a linear scan (labels)
+         */
+        class EnumTable
+        {
+            public:
+                /**
+                 * Table entry
+                 */
+                struct Entry
+                {
+                    int         value;
+                    uint32_t    label_offset;   //-Within the label pool
+                    uint32_t    label_length;
+                    uint32_t    label_capacity; //-Length of the longest label held by the slot (reused on replace)
+                };
+                typedef std::vector<Entry>  EntryVector;
+
+                //-Constructor & Destructor
+                EnumTable() : min_value_(0) {};
+                ~EnumTable() {};
+
+                //-Accessor
+                inline const EntryVector& entries() const       { return entries_;          }
+                inline size_t size() const                      { return entries_.size();   }
+                inline bool empty() const                       { return entries_.empty();  }
+                inline bool is_dense() const                    { return !dense_.empty();   }
+                inline const char* label(const Entry& entry) const  { return labels_.data() + entry.label_offset; }
+
+                //-Ancillary functions
+                inline void set(const int& value, const char* label, const size_t& label_length);
+                inline void set(const int& value, const std::string& label)    { set(value, label.data(), label.length()); }
+                inline void build();
+                inline void clear();
+                inline const Entry* find(const int& value) const;
+                inline const char* label(const int& value) const;
+                inline bool value_of(const char* label, const size_t& label_length, int& value) const;
+                inline std::string_view view(const int& value) const;
+                inline bool value_of(const std::string_view& label, int& value) const    { return value_of(label.data(), label.length(), value); }
+
+            private:
+                //-Functions
+                inline bool matches(const Entry& entry, const char* label, const size_t& label_length) const;
+
+                //-Constants
+                static const uint32_t NO_ENTRY = 0xFFFFFFFF;
+
+                //-Fields
+                EntryVector             entries_;   //-Value order
+                std::string             labels_;    //-Label pool (null terminated labels)
+                std::vector<uint32_t>   dense_;     //-Entry of (value - min_value_), empty if not compact
+                int                     min_value_;
+                std::vector<uint32_t>   slots_;     //-Label hash table (open addressing, linear probing)
+
+        }; /*class EnumTable*/
+
+        /**
+         * Maps a value onto a label (replaces the previous one), drops the indexes until the next build()
+         * A replaced label is written over its previous slot if it fits (or the slot ends the pool), the
+         * pool only grows when a label outgrows its slot
+         * @param value The value
+         * @param label The label (not necessarily null terminated)
+         * @param label_length The length of the label
+         */
+        void EnumTable::set(const int& value, const char* label, const size_t& label_length)
+        {
+            //-Labels are mostly defined in value order
+            EntryVector::iterator it = entries_.end();
+            if (!entries_.empty() && entries_.back().value >= value)
+            {
+                it = entries_.begin();
+                while (it->value < value)
+                {
+                    ++it;
+                }
+            }
+
+            if (entries_.end() != it && it->value == value)
+            {
+                //-Replace: the slot at the end of the pool is released, others are reused if the label fits
+                if (it->label_offset + it->label_capacity + 1 == labels_.size())
+                {
+                    labels_.resize(it->label_offset);
+                }
+                else if (label_length <= it->label_capacity)
+                {
+                    memcpy(&labels_[it->label_offset], label, label_length);
+                    labels_[it->label_offset + label_length] = '\0';
+                    it->label_length = (uint32_t) label_length;
+                    dense_.clear();
+                    slots_.clear();
+                    return;
+                }
+                it->label_offset = (uint32_t) labels_.size();
+                it->label_length = (uint32_t) label_length;
+                it->label_capacity = (uint32_t) label_length;
+            }
+            else
+            {
+                Entry entry;
+                entry.value = value;
+                entry.label_offset = (uint32_t) labels_.size();
+                entry.label_length = (uint32_t) label_length;
+                entry.label_capacity = (uint32_t) label_length;
+                entries_.insert(it, entry);
+            }
+            labels_.append(label, label_length);
+            labels_.push_back('\0');
+            dense_.clear();
+            slots_.clear();
+        }
+
+        /**
+         * Lays out the lookup indexes
+         */
+        void EnumTable::build()
+        {
+            dense_.clear();
+            slots_.clear();
+            if (entries_.empty())
+            {
+                return;
+            }
+            const uint32_t no_entry = NO_ENTRY;
+
+            //-Direct indexed when the values are compact (at most 4 slots per entry)
+            const int64_t span = (int64_t) entries_.back().value - entries_.front().value + 1;
+            if (span <= (int64_t) (4 * entries_.size() + 16))
+            {
+                min_value_ = entries_.front().value;
+                dense_.assign((size_t) span, no_entry);
+                for (size_t entry_idx = 0; entry_idx < entries_.size(); ++entry_idx)
+                {
+                    dense_[(size_t) (entries_[entry_idx].value - min_value_)] = (uint32_t) entry_idx;
+                }
+            }
+
+            //-Power of 2 capacity, load factor <= 0.5, the lowest value wins on duplicated labels
+            size_t capacity = 2;
+            while (capacity < 2 * entries_.size())
+            {
+                capacity <<= 1;
+            }
+            slots_.assign(capacity, no_entry);
+            const size_t mask = capacity - 1;
+            for (size_t entry_idx = 0; entry_idx < entries_.size(); ++entry_idx)
+            {
+                const Entry& entry = entries_[entry_idx];
+                size_t slot = string_fnc::hash(label(entry), entry.label_length) & mask;
+                bool duplicated = false;
+                while (NO_ENTRY != slots_[slot] && !duplicated)
+                {
+                    duplicated = matches(entries_[slots_[slot]], label(entry), entry.label_length);
+                    slot = (slot + 1) & mask;
+                }
+                if (!duplicated)
+                {
+                    slots_[slot] = (uint32_t) entry_idx;
+                }
+            }
+        }
+
+        /**
+         * Clears the table
+         */
+        void EnumTable::clear()
+        {
+            entries_.clear();
+            labels_.clear();
+            dense_.clear();
+            slots_.clear();
+            min_value_ = 0;
+        }
+
+        /**
+         * Finds the entry of a value
+         * @param value The value
+         * @return The entry, NULL if not found
+         */
+        const EnumTable::Entry* EnumTable::find(const int& value) const
+        {
+            if (!dense_.empty())
+            {
+                const int64_t offset = (int64_t) value - min_value_;
+                if (offset < 0 || offset >= (int64_t) dense_.size() || NO_ENTRY == dense_[(size_t) offset])
+                {
+                    return NULL;
+                }
+                return &entries_[dense_[(size_t) offset]];
+            }
+            size_t low = 0;
+            size_t high = entries_.size();
+            while (low < high)
+            {
+                const size_t middle = low + (high - low) / 2;
+                if (entries_[middle].value < value)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return (low < entries_.size() && value == entries_[low].value) ? &entries_[low] : NULL;
+        }
+
+        /**
+         * Label of a value
+         * @param value The value
+         * @return The label (null terminated), NULL if not found
+         */
+        const char* EnumTable::label(const int& value) const
+        {
+            const Entry* entry = find(value);
+            return (NULL == entry) ? NULL : label(*entry);
+        }
+
+        /**
+         * Value of a label (reverse lookup, i.e. text to binary encode)
+         * @param label The label (not necessarily null terminated)
+         * @param label_length The length of the label
+         * @param value (output) The value
+         * @return true if found
+         */
+        bool EnumTable::value_of(const char* label, const size_t& label_length, int& value) const
+        {
+            if (NULL == label)
+            {
+                return false;
+            }
+            if (slots_.empty())
+            {
+                for (size_t entry_idx = 0; entry_idx < entries_.size(); ++entry_idx)
+                {
+                    if (matches(entries_[entry_idx], label, label_length))
+                    {
+                        value = entries_[entry_idx].value;
+                        return true;
+                    }
+                }
+                return false;
+            }
+            const size_t mask = slots_.size() - 1;
+            for (size_t slot = string_fnc::hash(label, label_length) & mask; NO_ENTRY != slots_[slot]; slot = (slot + 1) & mask)
+            {
+                const Entry& entry = entries_[slots_[slot]];
+                if (matches(entry, label, label_length))
+                {
+                    value = entry.value;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Label of a value
+         * @param value The value
+         * @return The label, empty if not found
+         */
+        std::string_view EnumTable::view(const int& value) const
+        {
+            const Entry* entry = find(value);
+            return (NULL == entry) ? std::string_view() : std::string_view(label(*entry), entry->label_length);
+        }
+
+        /**
+         * Whether the label of an entry matches
+         * @param entry The entry
+         * @param label The label
+         * @param label_length The length of the label
+         * @return true if equal
+         */
+        bool EnumTable::matches(const Entry& entry, const char* label, const size_t& label_length) const
+        {
+            return entry.label_length == label_length && 0 == memcmp(labels_.data() + entry.label_offset, label, label_length);
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_ENUM_TABLE_H*/
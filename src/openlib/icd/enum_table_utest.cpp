@@ -0,0 +1,160 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "enum_table.h"
+#include "message_icd.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+TEST_GROUP(enum_table)
+{
+
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+
+	/**
+	 * Checks the lookups of a table holding the labels 'L<value>' for the given values
+	 */
+	void check_table(const EnumTable& table, const int* values, const size_t& num_values)
+	{
+		CHECK_EQUAL(num_values, table.size());
+		for (size_t i = 0; i < num_values; ++i)
+		{
+			const string label = "L" + to_string(values[i]);
+			STRCMP_EQUAL(label.c_str(), table.label(values[i]));
+			int value = 0;
+			CHECK(table.value_of(label.data(), label.length(), value));
+			CHECK_EQUAL(values[i], value);
+		}
+		int value = 0;
+		CHECK(NULL == table.label(values[num_values - 1] + 1));
+		CHECK(NULL == table.label(values[0] - 1));
+		CHECK(!table.value_of("L", 1, value));
+		CHECK(!table.value_of(NULL, 0, value));
+	}
+};
+
+TEST(enum_table, Test_dense)
+{
+	const int values[] = {-2, -1, 0, 1, 2, 5, 7};
+	EnumTable table;
+	for (size_t i = sizeof(values) / sizeof(values[0]); i > 0; --i)
+	{
+		table.set(values[i - 1], "L" + to_string(values[i - 1]));
+	}
+	check_table(table, values, sizeof(values) / sizeof(values[0]));
+	table.build();
+	CHECK(table.is_dense());
+	check_table(table, values, sizeof(values) / sizeof(values[0]));
+	CHECK(NULL == table.label(3));
+}
+
+TEST(enum_table, Test_sparse)
+{
+	const int values[] = {-2000000000, -7, 3, 100000, 2000000000};
+	EnumTable table;
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+	{
+		table.set(values[i], "L" + to_string(values[i]));
+	}
+	table.build();
+	CHECK(!table.is_dense());
+	check_table(table, values, sizeof(values) / sizeof(values[0]));
+	CHECK_EQUAL(values[1], table.entries()[1].value);
+}
+
+TEST(enum_table, Test_update)
+{
+	EnumTable table;
+	table.set(1, string("ONE"));
+	table.set(2, string("TWO"));
+	table.set(1, string("UNO"));
+	table.set(3, string("UNO"));
+	table.build();
+	CHECK_EQUAL(3u, table.size());
+	STRCMP_EQUAL("UNO", table.label(1));
+
+	//-The lowest value wins on duplicated labels
+	int value = 0;
+	CHECK(table.value_of("UNO", 3, value));
+	CHECK_EQUAL(1, value);
+	CHECK(!table.value_of("ONE", 3, value));
+	CHECK(table.view(2) == "TWO");
+	CHECK(table.view(4).empty());
+	CHECK(table.value_of(string_view("TWO"), value));
+	CHECK_EQUAL(2, value);
+
+	//-Replaced labels reuse their slot, the pool does not grow
+	const uint32_t slot = table.find(1)->label_offset;
+	const uint32_t end_slot = table.find(3)->label_offset;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		table.set(1, (0 == i % 2) ? string("A") : string("UNO"));
+		table.set(3, string("TRES") + to_string(i % 3));
+	}
+	CHECK_EQUAL(slot, table.find(1)->label_offset);
+	CHECK_EQUAL(end_slot, table.find(3)->label_offset);
+	STRCMP_EQUAL("UNO", table.label(1));
+	STRCMP_EQUAL("TRES0", table.label(3));
+	table.set(1, string("UNO_LONGER"));
+	table.build();
+	STRCMP_EQUAL("UNO_LONGER", table.label(1));
+	CHECK(table.value_of("UNO_LONGER", 10, value));
+	CHECK_EQUAL(1, value);
+	CHECK(!table.value_of("UNO", 3, value));
+	STRCMP_EQUAL("TWO", table.label(2));
+
+	table.clear();
+	CHECK(table.empty());
+	CHECK(NULL == table.label(1));
+}
+
+TEST(enum_table, Test_descriptor)
+{
+	MessageICD message;
+	TextICDParser parser;
+	CHECK_EQUAL(ParserError_None, parser.parse(string("field mode enum 0 0 8 BE\nenum 0 IDLE\nenum 1 RUN\nenum 2 FAULT\n"), message));
+	CHECK_EQUAL(ParserError_None, message.compile());
+	const DataDescriptor& mode = *message.field(0);
+	CHECK(mode.enum_table().is_dense());
+	STRCMP_EQUAL("FAULT", mode.enum_label(2));
+	CHECK(NULL == mode.enum_label(3));
+	int value = 0;
+	CHECK(mode.enum_value("RUN", 3, value));
+	CHECK_EQUAL(1, value);
+	bool found = false;
+	STRCMP_EQUAL("IDLE", mode.get_enum(0, found).c_str());
+	CHECK(found);
+}
@@ -27,9 +27,15 @@
 #include "openlib/icd/struct/icd_data_entry.h"
 #include "openlib/icd/enum/parser_error.h"
 #include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/value_arena.h"
+#include "openlib/icd/name_index.h"
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <new>
 
 //-Namespace/s
 namespace openlib
@@ -41,32 +47,84 @@ namespace openlib
          */
         class MessageICD
         {            
+            //-Parsers populate the message (@see BaseICDParser)
+            friend class BaseICDParser;
+
             public:
                 typedef std::set<DataDescriptor*, DataDescriptorPtrCompareLess> DataFieldSet;
                 typedef DataFieldSet::const_iterator DataFieldSetConstIterator;
                 typedef DataFieldSet::iterator DataFieldSetIterator;
 
                 //-Constructor & Destructor
-                MessageICD() {};
-                virtual ~MessageICD() { clear(); };
+                MessageICD() : compiled_(false), block_idx_(0), num_emplaced_(0) {};
+                virtual inline ~MessageICD();
 
                 //-Accessor & Mutators
                 inline const DataFieldSet& data_field_set() const;
+                inline const MessagePlan& plan() const              { return plan_;     }
+                inline const ValueArena& arena() const              { return arena_;    }
+                inline size_t size() const                          { return plan_.operations().size(); }
+                inline DataDescriptor* field(const size_t& field_idx) const;
+                inline size_t find(const std::string& name) const   { return name_index_.find(name); }
+                inline size_t find(const char* name, const size_t& name_length) const { return name_index_.find(name, name_length); }
 
                 //-Ancillary functions
-                ParserError encode(std::uint8_t* buffer, const size_t& buffer_length);
-                ParserError decode(const std::uint8_t* buffer, const size_t& buffer_length);
+                inline ParserError compile();
+                inline ParserError encode(std::uint8_t* buffer, const size_t& buffer_length);
+                inline ParserError decode(const std::uint8_t* buffer, const size_t& buffer_length);
+                inline ParserError encode_dirty(std::uint8_t* buffer, const size_t& buffer_length);
+                inline bool is_dirty(const size_t& field_idx) const;
+                inline void reserve(const size_t& num_fields);
+                inline void mark_all_dirty();
+                inline ParserError delta(const std::uint8_t* previous, const std::uint8_t* current, const size_t& buffer_length, std::vector<uint64_t>& changed, size_t& num_changed);
 
             protected:
                 //-Functions
                 inline void add(DataDescriptor* data_descriptor);
+                inline bool adopt(DataDescriptor* data_descriptor);
+                inline DataDescriptor* emplace(const DataType& data_type, const std::string& name, const size_t& byte_offset, const size_t& bit_offset,
+                                               const size_t& num_bits, const openlib::Endianess& endianess);
+                inline bool insert(DataDescriptor* data_descriptor);
+                inline void add_block(const size_t& capacity);
                 inline void clear();
 
+                //-Types
+                struct DescriptorBlock
+                {
+                    DataDescriptor* data;       //-Raw storage of 'capacity' descriptors
+                    size_t          capacity;
+                    size_t          used;       //-Descriptors built on the block
+                };
+
+                //-Constants
+                static const size_t MIN_DESCRIPTOR_BLOCK = 16;
+
                 //-Fields
                 DataFieldSet data_field_set_;
+                MessagePlan  plan_;
+                ValueArena   arena_;
+                NameIndex    name_index_;
+                bool         compiled_;
+                std::vector<uint64_t> dirty_;   //-Changed values since the last encode, bit i flags the field i of the plan
+                std::vector<DataDescriptor*> owned_;    //-Descriptors owned by the message (@see adopt)
+                std::vector<DescriptorBlock> blocks_;   //-Storage of the descriptors built by the message, kept on clear (@see emplace)
+                size_t       block_idx_;                //-First block with room
+                size_t       num_emplaced_;             //-Descriptors built on the blocks
 
         }; /*class ICDMessage*/
 
+        /**
+         * Destructor, the owned descriptors are deleted
+         */
+        MessageICD::~MessageICD()
+        {
+            clear();
+            for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx)
+            {
+                ::operator delete(blocks_[block_idx].data);
+            }
+        }
+
         /**
          * Access to data field set of the ICD message
          * @return The reference to the 'data_field_set_'
@@ -76,24 +134,355 @@ namespace openlib
             return data_field_set_;
         }
 
+        /**
+         * Access to a field by index (offset order) of the compiled message (@see find to resolve names)
+         * @param field_idx The field index
+         * @return The data descriptor, NULL if out of range
+         */
+        DataDescriptor* MessageICD::field(const size_t& field_idx) const
+        {
+            if (field_idx >= plan_.operations().size())
+            {
+                return NULL;
+            }
+            return plan_.operations()[field_idx].descriptor;
+        }
+
         /**
          * Add a data descriptor to the ICD Message        
+         * IMPORTANT: the value of the descriptor lives in the message arena once compiled, the descriptor
+         * must outlive the message or be removed with clear() before being destroyed
          * @param data_descriptor The data descriptor to be added
          */
         void MessageICD::add(DataDescriptor* data_descriptor)
         {
             if (NULL != data_descriptor)
             {
-                data_field_set_.insert(data_descriptor);
+                insert(data_descriptor);
+                compiled_ = false;
             }
         }
 
+        /**
+         * Add a data descriptor owned by the ICD Message (deleted on clear)
+         * @param data_descriptor The data descriptor to be added
+         * @return true if added, false (the descriptor is deleted) if its offset is already taken
+         */
+        bool MessageICD::adopt(DataDescriptor* data_descriptor)
+        {
+            if (NULL == data_descriptor)
+            {
+                return false;
+            }
+            if (!insert(data_descriptor))
+            {
+                delete data_descriptor;
+                return false;
+            }
+            owned_.push_back(data_descriptor);
+            compiled_ = false;
+            return true;
+        }
+
+        /**
+         * Builds a data descriptor owned by the ICD Message (destroyed on clear). Descriptors are laid out
+         * in blocks, kept on clear, so reloading a message does not allocate them again (@see reserve)
+         * @param data_type The data type
+         * @param name The field name
+         * @param byte_offset The byte offset
+         * @param bit_offset The bit offset
+         * @param num_bits The number of bits
+         * @param endianess The endianess
+         * @return The data descriptor, NULL (nothing added) if its offset is already taken
+         */
+        DataDescriptor* MessageICD::emplace(const DataType& data_type, const std::string& name, const size_t& byte_offset, const size_t& bit_offset,
+                                            const size_t& num_bits, const openlib::Endianess& endianess)
+        {
+            while (block_idx_ < blocks_.size() && blocks_[block_idx_].used == blocks_[block_idx_].capacity)
+            {
+                ++block_idx_;
+            }
+            if (block_idx_ == blocks_.size())
+            {
+                //-Geometric growth when the number of fields is not known in advance
+                add_block(std::max((size_t) MIN_DESCRIPTOR_BLOCK, num_emplaced_));
+            }
+            DescriptorBlock& block = blocks_[block_idx_];
+            DataDescriptor* data_descriptor = new (block.data + block.used) DataDescriptor(data_type, name, byte_offset, bit_offset, num_bits, endianess);
+            if (!insert(data_descriptor))
+            {
+                data_descriptor->~DataDescriptor();
+                return NULL;
+            }
+            ++block.used;
+            ++num_emplaced_;
+            compiled_ = false;
+            return data_descriptor;
+        }
+
+        /**
+         * Appends a descriptor block
+         * @param capacity The number of descriptors of the block
+         */
+        void MessageICD::add_block(const size_t& capacity)
+        {
+            DescriptorBlock block = {static_cast<DataDescriptor*> (::operator new(sizeof(DataDescriptor) * capacity)), capacity, 0};
+            blocks_.push_back(block);
+        }
+
+        /**
+         * Reserves room for the descriptors built by the message (i.e. by a parser that knows the number
+         * of fields in advance, @see BaseICDParser), so they take a single block
+         * @param num_fields The number of fields
+         */
+        void MessageICD::reserve(const size_t& num_fields)
+        {
+            size_t available = 0;
+            for (size_t block_idx = block_idx_; block_idx < blocks_.size(); ++block_idx)
+            {
+                available += blocks_[block_idx].capacity - blocks_[block_idx].used;
+            }
+            if (available < num_fields)
+            {
+                add_block(num_fields - available);
+            }
+        }
+
+        /**
+         * Inserts a data descriptor onto the offset sorted set, the end is tried first since definitions
+         * usually come in offset order
+         * @param data_descriptor The data descriptor
+         * @return true if inserted, false if its offset is already taken
+         */
+        bool MessageICD::insert(DataDescriptor* data_descriptor)
+        {
+            const size_t size = data_field_set_.size();
+            data_field_set_.insert(data_field_set_.end(), data_descriptor);
+            return data_field_set_.size() != size;
+        }
+
         /**
         * Clear content of the data descriptors        
         */
         void MessageICD::clear()
         {   
+            //-Move the values back onto the descriptors before releasing the arena (not needed if all are owned)
+            if (data_field_set_.size() != owned_.size() + num_emplaced_)
+            {
+                for (DataFieldSetIterator it = data_field_set_.begin(); it != data_field_set_.end(); ++it)
+                {
+                    (*it)->unbind();
+                    (*it)->track(NULL, 0);
+                }
+            }
+            dirty_.clear();
+            arena_.reset();
+            name_index_.clear();
             data_field_set_.erase(data_field_set_.begin(), data_field_set_.end());
+            for (size_t i = 0; i < owned_.size(); ++i)
+            {
+                delete owned_[i];
+            }
+            owned_.clear();
+            for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx)
+            {
+                DescriptorBlock& block = blocks_[block_idx];
+                for (size_t i = 0; i < block.used; ++i)
+                {
+                    block.data[i].~DataDescriptor();
+                }
+                block.used = 0;
+            }
+            block_idx_ = 0;
+            num_emplaced_ = 0;
+            plan_.clear();
+            compiled_ = false;
+        }
+
+        /**
+         * Compiles the data descriptors onto a flat, offset sorted encode/decode plan, the values of all
+         * the descriptors are packed onto a single aligned arena (done on the first encode/decode after
+         * the data descriptors change)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageICD::compile()
+        {
+            plan_.clear();
+            name_index_.clear();
+            compiled_ = false;
+
+            //-Lay out the values in offset order (one allocation per message, the block is reused if no value
+            //-lives on it, i.e. after clear)
+            size_t arena_length = 0;
+            size_t buffer_length = 0;
+            for (DataFieldSetConstIterator it = data_field_set_.begin(); it != data_field_set_.end(); ++it)
+            {
+                arena_length = ValueArena::align(arena_length, (*it)->data_alignment()) + (*it)->data_length();
+                buffer_length = std::max(buffer_length, (*it)->byte_offset() + BIT2BYTE((*it)->bit_offset() + (*it)->num_bits() + 7));
+            }
+            ValueArena arena;
+            ValueArena& target = (0 == arena_.used()) ? arena_ : arena;
+            target.reserve(arena_length);
+            for (DataFieldSetIterator it = data_field_set_.begin(); it != data_field_set_.end(); ++it)
+            {
+                (*it)->bind(target.allocate((*it)->data_length(), (*it)->data_alignment()));
+            }
+            if (&target != &arena_)
+            {
+                arena_.swap(arena);
+            }
+            plan_.reserve(data_field_set_.size(), buffer_length);
+
+            //-Flatten the field operations, lay out the enumeration lookups
+            for (DataFieldSetIterator it = data_field_set_.begin(); it != data_field_set_.end(); ++it)
+            {
+                (*it)->enum_table().build();
+                const ParserError error = plan_.add(**it);
+                if (ParserError_None != error)
+                {
+                    plan_.clear();
+                    return error;
+                }
+            }
+
+            //-Name lookup
+            name_index_.build(plan_);
+
+            //-Change tracking, everything is pending until the first encode
+            dirty_.assign((data_field_set_.size() + 63) / 64, 0);
+            size_t field_idx = 0;
+            for (DataFieldSetIterator it = data_field_set_.begin(); it != data_field_set_.end(); ++it, ++field_idx)
+            {
+                (*it)->track(&dirty_[field_idx / 64], ((uint64_t) 1) << (field_idx % 64));
+            }
+            mark_all_dirty();
+            compiled_ = true;
+            return ParserError_None;
+        }
+
+        /**
+         * Encodes the data descriptor values onto a buffer
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageICD::encode(std::uint8_t* buffer, const size_t& buffer_length)
+        {
+            if (!compiled_)
+            {
+                const ParserError error = compile();
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+            }
+            const ParserError error = plan_.encode(buffer, buffer_length);
+            if (ParserError_None == error)
+            {
+                std::fill(dirty_.begin(), dirty_.end(), 0);
+            }
+            return error;
+        }
+
+        /**
+         * Decodes a buffer onto the data descriptor values
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageICD::decode(const std::uint8_t* buffer, const size_t& buffer_length)
+        {
+            if (!compiled_)
+            {
+                const ParserError error = compile();
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+            }
+            const ParserError error = plan_.decode(buffer, buffer_length);
+            if (ParserError_None == error)
+            {
+                mark_all_dirty();
+            }
+            return error;
+        }
+
+        /**
+         * Encodes only the values changed since the last encode onto a buffer holding that encoding
+         * (i.e. a buffer that persists between cycles), the rest of the buffer is untouched
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageICD::encode_dirty(std::uint8_t* buffer, const size_t& buffer_length)
+        {
+            if (!compiled_)
+            {
+                const ParserError error = compile();
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+            }
+            const ParserError error = plan_.encode_dirty(buffer, buffer_length, dirty_.data());
+            if (ParserError_None == error)
+            {
+                std::fill(dirty_.begin(), dirty_.end(), 0);
+            }
+            return error;
+        }
+
+        /**
+         * Detects the fields that differ between two receptions of the message, without decoding
+         * (@see MessagePlan::delta)
+         * @param previous The previous buffer
+         * @param current The current buffer
+         * @param buffer_length The length of both buffers
+         * @param changed (output) The bitmap of changed fields, bit (i % 64) of word (i / 64) flags the field i
+         * @param num_changed (output) The number of changed fields
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageICD::delta(const std::uint8_t* previous, const std::uint8_t* current, const size_t& buffer_length, std::vector<uint64_t>& changed, size_t& num_changed)
+        {
+            num_changed = 0;
+            if (!compiled_)
+            {
+                const ParserError error = compile();
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+            }
+            changed.resize((plan_.operations().size() + 63) / 64);
+            return plan_.delta(previous, current, buffer_length, changed.data(), num_changed);
+        }
+
+        /**
+         * Whether a value changed since the last encode
+         * @param field_idx The field index (@see MessagePlan::index_of)
+         * @return true if changed (or not encoded yet)
+         */
+        bool MessageICD::is_dirty(const size_t& field_idx) const
+        {
+            if (field_idx / 64 >= dirty_.size())
+            {
+                return false;
+            }
+            return 0 != (dirty_[field_idx / 64] & (((uint64_t) 1) << (field_idx % 64)));
+        }
+
+        /**
+         * Flags all the values as changed (the next encode_dirty writes every field)
+         */
+        void MessageICD::mark_all_dirty()
+        {
+            const size_t num_fields = plan_.operations().size();
+            for (size_t word_idx = 0; word_idx < dirty_.size(); ++word_idx)
+            {
+                const size_t num_bits = std::min((size_t) 64, num_fields - word_idx * 64);
+                dirty_[word_idx] = buffer::low_mask(num_bits);
+            }
         }
     
 
@@ -0,0 +1,377 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "message_icd.h"
+#include "message_view.h"
+#include "openlib/buffer/buffer_handler.h"
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+/**
+ * Test message
+ */
+class TestMessageICD: public MessageICD
+{
+    public:
+        TestMessageICD()
+        {
+            fields_[0] = new DataDescriptor(DataType_uint8,  "id",      0, 0,  8, Endianess_BigEndian);
+            fields_[1] = new DataDescriptor(DataType_int16,  "count",   1, 0, 16, Endianess_LittleEndian);
+            fields_[2] = new DataDescriptor(DataType_uint8,  "flags",   3, 0,  3, Endianess_BigEndian);
+            fields_[3] = new DataDescriptor(DataType_int8,   "delta",   3, 3,  5, Endianess_BigEndian);
+            fields_[4] = new DataDescriptor(DataType_uint32, "range",   4, 0, 20, Endianess_BigEndian);
+            fields_[5] = new DataDescriptor(DataType_enum,   "mode",    6, 4,  4, Endianess_BigEndian);
+            fields_[6] = new DataDescriptor(DataType_binary, "payload", 7, 0, 32, Endianess_BigEndian);
+            for (size_t i = 0; i < NUM_FIELDS; ++i)
+            {
+                add(fields_[i]);
+            }
+        }
+
+        ~TestMessageICD()
+        {
+            clear();
+            for (size_t i = 0; i < NUM_FIELDS; ++i)
+            {
+                Delete(fields_[i]);
+            }
+        }
+
+        DataDescriptor& field(const size_t& idx) { return *fields_[idx]; }
+        using MessageICD::clear;
+
+        static const size_t NUM_FIELDS = 7;
+        static const size_t LENGTH = 11;
+
+    private:
+        DataDescriptor* fields_[NUM_FIELDS];
+};
+
+TEST_GROUP(message_icd)
+{
+	uint8_t buffer[TestMessageICD::LENGTH];
+
+	void setup()
+	{
+		const uint8_t wire[TestMessageICD::LENGTH] = {0x7E, 0x34, 0x92, 0b10111010, 0xAB, 0xCD, 0xE9, 0xDE, 0xAD, 0xBE, 0xEF};
+		memcpy(buffer, wire, sizeof(buffer));
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(message_icd, Test_decode)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+	CHECK_EQUAL(TestMessageICD::NUM_FIELDS, message.plan().operations().size());
+	CHECK_EQUAL(sizeof(buffer), message.plan().min_buffer_length());
+
+	//-Same values as the runtime extraction
+	CHECK_EQUAL(0x7E, message.field(0).uint8());
+	CHECK_EQUAL((int16_t) 0x9234, message.field(1).int16());
+	CHECK_EQUAL(0b101, message.field(2).uint8());
+	CHECK_EQUAL(-6, message.field(3).int8());
+	CHECK_EQUAL(0xABCDEu, message.field(4).uint32());
+	CHECK_EQUAL(9, message.field(5).enum_val());
+	const uint8_t payload[] = {0xDE, 0xAD, 0xBE, 0xEF};
+	MEMCMP_EQUAL(payload, message.field(6).as_binary(), sizeof(payload));
+
+	for (size_t i = 0; i < TestMessageICD::NUM_FIELDS - 1; ++i)
+	{
+		DataDescriptor& field = message.field(i);
+		int32_t value = 0;
+		buffer::extract(buffer, sizeof(buffer), field.byte_offset(), field.bit_offset(), field.num_bits(), field.endianess(), &value);
+		int32_t decoded = 0;
+		switch (field.data_length())
+		{
+			case 1: decoded = (DataType_int8 == field.data_type()) ? field.int8() : field.uint8(); break;
+			case 2: decoded = field.int16(); break;
+			default: decoded = field.int32(); break;
+		}
+		if (DataType_int8 != field.data_type() && DataType_int16 != field.data_type())
+		{
+			value &= (int32_t) buffer::low_mask(field.num_bits());
+		}
+		CHECK_EQUAL(value, decoded);
+	}
+}
+
+TEST(message_icd, Test_encode)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+
+	//-Round trip
+	uint8_t output[TestMessageICD::LENGTH];
+	memset(output, 0x00, sizeof(output));
+	CHECK_EQUAL(ParserError_None, message.encode(output, sizeof(output)));
+	MEMCMP_EQUAL(buffer, output, sizeof(output));
+
+	//-Change a field
+	message.field(3).int8() = 3;
+	message.field(4).uint32() = 0x12345;
+	CHECK_EQUAL(ParserError_None, message.encode(output, sizeof(output)));
+	CHECK_EQUAL(0b10100011, output[3]);
+	CHECK_EQUAL(0x12, output[4]);
+	CHECK_EQUAL(0x34, output[5]);
+	CHECK_EQUAL(0x59, output[6]);
+}
+
+TEST(message_icd, Test_errors)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(ParserError_NullParameter, message.decode(NULL, sizeof(buffer)));
+	CHECK_EQUAL(ParserError_NotEnoughData, message.decode(buffer, sizeof(buffer) - 1));
+	CHECK_EQUAL(ParserError_NotEnoughData, message.encode(buffer, sizeof(buffer) - 1));
+
+	MessagePlan plan;
+	DataDescriptor too_wide(DataType_uint8, "too_wide", 0, 0, 9, Endianess_BigEndian);
+	CHECK_EQUAL(ParserError_ContainerTooSmall, plan.add(too_wide));
+	DataDescriptor partial_le(DataType_uint16, "partial_le", 0, 4, 12, Endianess_LittleEndian);
+	CHECK_EQUAL(ParserError_InvalidLayout, plan.add(partial_le));
+	CHECK_EQUAL(0u, plan.operations().size());
+
+	//-Little-endian fields spanning whole bytes, or a single byte, are fine
+	DataDescriptor nibble_le(DataType_uint8, "nibble_le", 0, 0, 4, Endianess_LittleEndian);
+	DataDescriptor word_le(DataType_uint16, "word_le", 1, 0, 16, Endianess_LittleEndian);
+	CHECK_EQUAL(ParserError_None, plan.add(nibble_le));
+	CHECK_EQUAL(ParserError_None, plan.add(word_le));
+	CHECK_EQUAL(2u, plan.operations().size());
+}
+
+TEST(message_icd, Test_value_arena)
+{
+	TestMessageICD message;
+	message.field(4).uint32() = 0xABCDE;
+	message.field(6).set(buffer, 4);
+
+	//-Values are packed onto the arena, aligned, and kept through the binding
+	CHECK_EQUAL(ParserError_None, message.compile());
+	const uint8_t* arena_begin = message.arena().data();
+	const uint8_t* arena_end = arena_begin + message.arena().capacity();
+	CHECK_EQUAL(0u, reinterpret_cast<uintptr_t> (arena_begin) % ValueArena::ALIGNMENT);
+	CHECK_EQUAL(message.arena().capacity(), message.arena().used());
+	for (size_t i = 0; i < TestMessageICD::NUM_FIELDS; ++i)
+	{
+		const DataDescriptor& field = message.field(i);
+		CHECK(field.is_bound());
+		CHECK(field.data() >= arena_begin && field.data() + field.data_length() <= arena_end);
+		CHECK_EQUAL(0u, reinterpret_cast<uintptr_t> (field.data()) % field.data_alignment());
+	}
+	CHECK_EQUAL(0xABCDEu, message.field(4).uint32());
+	MEMCMP_EQUAL(buffer, message.field(6).as_binary(), 4);
+
+	//-Values move back onto the descriptors when cleared
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+	message.field(1).int16() = 1234;
+	DataDescriptor& count = message.field(1);
+	DataDescriptor& payload = message.field(6);
+	message.clear();
+	CHECK(!count.is_bound());
+	CHECK(!payload.is_bound());
+	CHECK_EQUAL(1234, count.int16());
+	MEMCMP_EQUAL(buffer + 7, payload.as_binary(), 4);
+}
+
+TEST(message_icd, Test_message_view)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(ParserError_None, message.compile());
+
+	//-Fields read straight from the wire, same values as a full decode
+	MessageView view(buffer, sizeof(buffer), message);
+	CHECK(view.valid());
+	CHECK_EQUAL(TestMessageICD::NUM_FIELDS, view.size());
+	CHECK_EQUAL(0x7E, view.get<uint8_t>(0));
+	CHECK_EQUAL(-6, view.get<int8_t>(3));
+	CHECK_EQUAL(9, view.get<int>(message.plan().index_of(&message.field(5))));
+
+	uint32_t range = 0;
+	CHECK_EQUAL(ParserError_None, view.get(4, range));
+	CHECK_EQUAL(0xABCDEu, range);
+	uint8_t too_small = 0;
+	CHECK_EQUAL(ParserError_ContainerTooSmall, view.get(4, too_small));
+	CHECK_EQUAL(ParserError_InvalidDataType, view.get(6, range));
+
+	//-Signed fields are sign extended onto wider types, full width or not
+	uint8_t negative[TestMessageICD::LENGTH];
+	memcpy(negative, buffer, sizeof(negative));
+	negative[1] = 0xFF;
+	negative[2] = 0xFF;
+	MessageView negative_view(negative, sizeof(negative), message);
+	int32_t count32 = 0;
+	int64_t count64 = 0;
+	int64_t delta64 = 0;
+	uint64_t range64 = 0;
+	CHECK_EQUAL(ParserError_None, negative_view.get(1, count32));
+	CHECK_EQUAL(ParserError_None, negative_view.get(1, count64));
+	CHECK_EQUAL(ParserError_None, negative_view.get(3, delta64));
+	CHECK_EQUAL(ParserError_None, negative_view.get(4, range64));
+	CHECK_EQUAL(-1, count32);
+	CHECK_EQUAL((int64_t) -1, count64);
+	CHECK_EQUAL((int64_t) -1, negative_view.get<int64_t>(1));
+	CHECK_EQUAL((int64_t) -6, delta64);
+	CHECK_EQUAL((uint64_t) 0xABCDE, range64);
+	POINTERS_EQUAL(buffer + 7, view.bytes(6));
+	POINTERS_EQUAL(NULL, view.bytes(0));
+
+	//-Views are plain values
+	MessageView copy = view;
+	POINTERS_EQUAL(view.buffer(), copy.buffer());
+	MessageView truncated(buffer, sizeof(buffer) - 1, message);
+	CHECK(!truncated.valid());
+	CHECK_EQUAL(ParserError_NotEnoughData, truncated.get(4, range));
+	POINTERS_EQUAL(NULL, truncated.bytes(6));
+}
+
+TEST(message_icd, Test_encode_dirty)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+	CHECK(message.is_dirty(0));
+
+	//-First cycle writes everything
+	uint8_t output[TestMessageICD::LENGTH];
+	memset(output, 0x00, sizeof(output));
+	CHECK_EQUAL(ParserError_None, message.encode_dirty(output, sizeof(output)));
+	MEMCMP_EQUAL(buffer, output, sizeof(output));
+	for (size_t i = 0; i < TestMessageICD::NUM_FIELDS; ++i)
+	{
+		CHECK(!message.is_dirty(i));
+	}
+
+	//-Next cycles only patch the changed fields (the id byte is tampered to prove it is not rewritten)
+	output[0] = 0x00;
+	message.field(3).int8() = 3;
+	message.field(6).set("0x01020304");
+	CHECK(!message.is_dirty(0));
+	CHECK(message.is_dirty(3));
+	CHECK(message.is_dirty(6));
+	CHECK_EQUAL(ParserError_None, message.encode_dirty(output, sizeof(output)));
+	CHECK_EQUAL(0x00, output[0]);
+	CHECK_EQUAL(0b10100011, output[3]);
+	CHECK_EQUAL(0xE9, output[6]);
+	CHECK_EQUAL(0x01, output[7]);
+	CHECK_EQUAL(0x04, output[10]);
+	CHECK(!message.is_dirty(3));
+
+	//-Reads (const accessors, buffer::insert) leave the fields clean
+	const DataDescriptor& delta = message.field(3);
+	CHECK_EQUAL(3, delta.int8());
+	CHECK_EQUAL(3, *delta.as_int8());
+	uint8_t scratch[TestMessageICD::LENGTH];
+	memset(scratch, 0x00, sizeof(scratch));
+	for (size_t i = 0; i < TestMessageICD::NUM_FIELDS; ++i)
+	{
+		CHECK_EQUAL(openlib::buffer::SUCCESS, openlib::buffer::insert(scratch, sizeof(scratch), message.field(i)));
+		CHECK(!message.is_dirty(i));
+	}
+
+	//-Nothing changed, nothing written
+	memset(output, 0xFF, sizeof(output));
+	CHECK_EQUAL(ParserError_None, message.encode_dirty(output, sizeof(output)));
+	CHECK_EQUAL(0xFF, output[3]);
+}
+
+TEST(message_icd, Test_delta)
+{
+	TestMessageICD message;
+	std::vector<uint64_t> changed;
+	size_t num_changed = 0;
+
+	//-Same content
+	uint8_t current[TestMessageICD::LENGTH];
+	memcpy(current, buffer, sizeof(current));
+	CHECK_EQUAL(ParserError_None, message.delta(buffer, current, sizeof(buffer), changed, num_changed));
+	CHECK_EQUAL(0u, num_changed);
+	CHECK_EQUAL(1u, changed.size());
+	CHECK_EQUAL(0u, changed[0]);
+
+	//-Flip one bit of 'delta' (bit 27), the last bit of 'range' (bit 51) and a payload byte
+	current[3] ^= 0x10;
+	current[6] ^= 0x10;
+	current[9] ^= 0xFF;
+	CHECK_EQUAL(ParserError_None, message.delta(buffer, current, sizeof(buffer), changed, num_changed));
+	CHECK_EQUAL(3u, num_changed);
+	CHECK_EQUAL((1u << 3) | (1u << 4) | (1u << 6), changed[0]);
+
+	//-Longer messages go through the word (and SIMD) paths
+	MessagePlan plan;
+	std::vector<DataDescriptor*> fields;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		fields.push_back(new DataDescriptor(DataType_uint16, "field", 2 * i, 0, 16, Endianess_BigEndian));
+		CHECK_EQUAL(ParserError_None, plan.add(*fields.back()));
+	}
+	uint8_t previous_long[200];
+	uint8_t current_long[200];
+	memset(previous_long, 0x55, sizeof(previous_long));
+	memcpy(current_long, previous_long, sizeof(current_long));
+	current_long[0] = 0;
+	current_long[131] = 0;
+	current_long[199] = 0;
+	uint64_t changed_long[2];
+	CHECK_EQUAL(ParserError_None, plan.delta(previous_long, current_long, sizeof(current_long), changed_long, num_changed));
+	CHECK_EQUAL(3u, num_changed);
+	CHECK_EQUAL(1u, changed_long[0]);
+	CHECK_EQUAL((((uint64_t) 1) << (65 - 64)) | (((uint64_t) 1) << (99 - 64)), changed_long[1]);
+	for (size_t i = 0; i < fields.size(); ++i)
+	{
+		delete fields[i];
+	}
+
+	CHECK_EQUAL(ParserError_NotEnoughData, message.delta(buffer, current, sizeof(buffer) - 1, changed, num_changed));
+}
+
+TEST(message_icd, Test_find_by_name)
+{
+	TestMessageICD message;
+	CHECK_EQUAL(NameIndex::NOT_FOUND, message.find("range"));
+	CHECK_EQUAL(ParserError_None, message.compile());
+
+	//-Resolve once, then index directly
+	const MessageICD& icd_message = message;
+	const size_t range_idx = icd_message.find("range");
+	CHECK_EQUAL(4u, range_idx);
+	POINTERS_EQUAL(&message.field(4), icd_message.field(range_idx));
+	CHECK_EQUAL(0u, message.find("id"));
+	CHECK_EQUAL(6u, message.find(std::string("payload")));
+	CHECK_EQUAL(5u, message.find("mode_extra", 4));
+	CHECK_EQUAL(NameIndex::NOT_FOUND, message.find("unknown"));
+	CHECK_EQUAL(NameIndex::NOT_FOUND, message.find(""));
+	const size_t& not_found = std::max(NameIndex::NOT_FOUND, message.find("unknown"));    //-ODR-used (bound by reference)
+	CHECK_EQUAL(NameIndex::NOT_FOUND, not_found);
+	POINTERS_EQUAL(NULL, icd_message.field(icd_message.size()));
+
+	MessageView view(buffer, sizeof(buffer), message);
+	CHECK_EQUAL(0xABCDEu, view.get<uint32_t>(message.find("range")));
+}
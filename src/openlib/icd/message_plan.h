@@ -0,0 +1,736 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_MESSAGE_PLAN_H
+#define OPENLIB_ICD_MESSAGE_PLAN_H
+
+//-Supporting libraries
+#include "openlib/common.h"
+#include "openlib/enum/endianess.h"
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/enum/data_type.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/value_arena.h"
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Kind of field operation
+         */
+        enum FieldOperationKind
+        {
+            FieldOperationKind_Integer = 0,     /**< Integral value, extracted/inserted through a 64-bits window */
+            FieldOperationKind_Bytes,           /**< Byte array (ascii, binary) */
+        };
+
+        /**
+         * A flattened field operation, all the layout arithmetic is resolved when the plan is compiled
+         */
+        struct FieldOperation
+        {
+            FieldOperationKind  kind;
+            size_t              byte_index;     //-First byte of the field on the buffer
+            size_t              bit_offset;     //-Bit offset within the first byte [0..7]
+            size_t              num_bits;       //-Number of bits of the field
+            size_t              window_shift;   //-Right shift of the 64-bits window (fields within 8 bytes)
+            size_t              spill_bits;     //-Bits taken from the 9th byte (0 if the field fits 8 bytes)
+            bool                swap;           //-Little-endian field spanning more than a byte
+            size_t              swap_shift;     //-Right shift after swapping the 64-bits value
+            uint64_t            mask;           //-Field mask (right aligned)
+            uint64_t            window_mask;    //-Field mask within the 64-bits window
+            uint64_t            sign_bit;       //-Sign bit for narrow signed values (0 if not needed)
+            bool                is_signed;      //-Signed value type
+            uint8_t*            data;           //-Value container
+            size_t              data_length;    //-Value container length
+            size_t              data_offset;    //-Value offset within a value record (@see MessageRecord)
+            DataDescriptor*     descriptor;     //-Source descriptor
+        };
+
+        /**
+         * Compiled encode/decode plan of a message: contiguous, offset sorted array of field operations
+         * The layout is immutable once compiled: the const decode/encode overloads taking a value record
+         * neither read nor write the descriptor values, any number of threads can share the plan
+         */
+        class MessagePlan
+        {
+            public:
+                typedef std::vector<FieldOperation>             FieldOperationVector;
+                typedef FieldOperationVector::const_iterator    FieldOperationVectorConstIterator;
+
+                //-Constructor & Destructor
+                MessagePlan() : min_buffer_length_(0), record_length_(0) {};
+                ~MessagePlan() {};
+
+                //-Accessor
+                inline const FieldOperationVector& operations() const   { return operations_;           }
+                inline const size_t& min_buffer_length() const          { return min_buffer_length_;    }
+                inline const size_t& record_length() const              { return record_length_;        }
+
+                //-Ancillary functions
+                inline ParserError add(DataDescriptor& data_descriptor);
+                inline void clear();
+                inline void reserve(const size_t& num_fields, const size_t& buffer_length);
+                inline ParserError decode(const uint8_t* buffer, const size_t& buffer_length) const;
+                inline ParserError encode(uint8_t* buffer, const size_t& buffer_length) const;
+                inline ParserError decode(const uint8_t* buffer, const size_t& buffer_length, uint8_t* record) const;
+                inline ParserError encode(uint8_t* buffer, const size_t& buffer_length, const uint8_t* record) const;
+                inline size_t index_of(const DataDescriptor* data_descriptor) const;
+                inline ParserError delta(const uint8_t* previous, const uint8_t* current, const size_t& buffer_length, uint64_t* changed, size_t& num_changed) const;
+                static inline uint64_t decode_field(const FieldOperation& operation, const uint8_t* buffer, const size_t& buffer_length);
+                static inline void decode_bytes(const FieldOperation& operation, const uint8_t* buffer, const size_t& buffer_length, uint8_t* output);
+                static inline void encode_field(const FieldOperation& operation, uint8_t* buffer, const size_t& buffer_length);
+                static inline int64_t container_value(const FieldOperation& operation, const uint64_t& value);
+                static inline void encode_field(const FieldOperation& operation, const uint8_t* data, uint8_t* buffer, const size_t& buffer_length);
+                static inline uint64_t load_value(const uint8_t* data, const size_t& data_length);
+                static inline void store_value(uint8_t* data, const size_t& data_length, const uint64_t& value);
+                inline ParserError encode_dirty(uint8_t* buffer, const size_t& buffer_length, const uint64_t* dirty) const;
+
+                //-Constants
+                static const uint32_t NO_FIELD = 0xFFFFFFFF;
+
+                /**
+                 * First bit (from the start of the buffer) of a field operation
+                 * @param operation The field operation
+                 * @return size_t containing the bit index
+                 */
+                static inline size_t field_begin_bit(const FieldOperation& operation)
+                {
+                    return BYTE2BIT(operation.byte_index) + operation.bit_offset;
+                }
+
+                /**
+                 * Number of bits on the buffer of a field operation
+                 * @param operation The field operation
+                 * @return size_t containing the number of bits
+                 */
+                static inline size_t field_num_bits(const FieldOperation& operation)
+                {
+                    return (FieldOperationKind_Bytes == operation.kind) ? BYTE2BIT(operation.data_length) : operation.num_bits;
+                }
+
+            protected:
+                //-Functions
+                inline void mark_changed_bits(const size_t& byte_idx, const uint8_t& changed_bits, uint64_t* changed, size_t& num_changed) const;
+
+                //-Fields
+                FieldOperationVector    operations_;
+                std::vector<uint32_t>   byte_field_;    //-Bit to field table: first field (lowest index) covering each byte
+                size_t                  min_buffer_length_;
+                size_t                  record_length_; //-Length of a value record (values in offset order, naturally aligned)
+
+        }; /*class MessagePlan*/
+
+        /**
+         * Compiles a data descriptor onto a field operation appended to the plan (descriptors shall be added offset sorted)
+         * @param data_descriptor The data descriptor, its value container is referenced by the plan
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::add(DataDescriptor& data_descriptor)
+        {
+            FieldOperation operation;
+            operation.byte_index    = data_descriptor.byte_offset() + BIT2BYTE(data_descriptor.bit_offset());
+            operation.bit_offset    = data_descriptor.bit_offset() % 8;
+            operation.num_bits      = data_descriptor.num_bits();
+            operation.data          = data_descriptor.data();
+            operation.data_length   = data_descriptor.data_length();
+            operation.data_offset   = ValueArena::align(record_length_, data_descriptor.data_alignment());
+            operation.descriptor    = &data_descriptor;
+            operation.window_shift  = 0;
+            operation.spill_bits    = 0;
+            operation.swap          = false;
+            operation.swap_shift    = 0;
+            operation.mask          = 0;
+            operation.window_mask   = 0;
+            operation.sign_bit      = 0;
+            operation.is_signed     = false;
+            operation.kind          = FieldOperationKind_Integer;
+
+            bool is_signed = false;
+            switch (data_descriptor.data_type())
+            {
+                case DataType_int8   :
+                case DataType_int16  :
+                case DataType_int32  :
+                    is_signed = true;
+                    operation.is_signed = true;
+                    operation.kind = FieldOperationKind_Integer;
+                    break;
+
+                case DataType_uint8  :
+                case DataType_uint16 :
+                case DataType_uint32 :
+                case DataType_enum   :  //-Zero extended onto the int container
+                    operation.kind = FieldOperationKind_Integer;
+                    break;
+
+                case DataType_ascii  :
+                case DataType_binary :
+                    operation.kind = FieldOperationKind_Bytes;
+                    break;
+
+                default:
+                    return ParserError_InvalidDataType;
+            }
+
+            if (FieldOperationKind_Integer == operation.kind)
+            {
+                //-Check recipient of data
+                if (0 == operation.num_bits || operation.num_bits > BYTE2BIT(operation.data_length))
+                {
+                    return ParserError_ContainerTooSmall;
+                }
+
+                //-Little-endian fields span whole bytes (same rule as ICDField)
+                if (!buffer::is_valid_layout(operation.num_bits, data_descriptor.endianess()))
+                {
+                    return ParserError_InvalidLayout;
+                }
+
+                //-Window layout
+                const size_t window_bits = operation.bit_offset + operation.num_bits;
+                if (window_bits <= 64)
+                {
+                    operation.window_shift = 64 - window_bits;
+                }
+                else
+                {
+                    operation.spill_bits = window_bits - 64;
+                }
+                operation.mask          = buffer::low_mask(operation.num_bits);
+                operation.window_mask   = operation.mask << operation.window_shift;
+
+                //-Endianess & sign
+                const size_t num_bytes = (operation.num_bits + 7) / 8;
+                operation.swap          = (Endianess_LittleEndian == data_descriptor.endianess() && num_bytes > 1);
+                operation.swap_shift    = 64 - BYTE2BIT(num_bytes);
+                if (is_signed && operation.num_bits < BYTE2BIT(operation.data_length))
+                {
+                    operation.sign_bit = ((uint64_t) 1) << (operation.num_bits - 1);
+                }
+                min_buffer_length_ = std::max(min_buffer_length_, operation.byte_index + (window_bits + 7) / 8);
+            }
+            else
+            {
+                //-Byte arrays are copied whole
+                min_buffer_length_ = std::max(min_buffer_length_, operation.byte_index + operation.data_length + ((0 == operation.bit_offset) ? 0 : 1));
+            }
+
+            //-Bit to field table
+            const size_t end_byte = (field_begin_bit(operation) + field_num_bits(operation) + 7) / 8;
+            if (byte_field_.size() < end_byte)
+            {
+                byte_field_.resize(end_byte, (uint32_t) NO_FIELD);
+            }
+            for (size_t byte_idx = operation.byte_index; byte_idx < end_byte; ++byte_idx)
+            {
+                byte_field_[byte_idx] = std::min(byte_field_[byte_idx], (uint32_t) operations_.size());
+            }
+
+            record_length_ = operation.data_offset + operation.data_length;
+            operations_.push_back(operation);
+            return ParserError_None;
+        }
+
+        /**
+         * Reserves the plan capacity
+         * @param num_fields The number of fields
+         * @param buffer_length The length of the buffer spanned by the fields
+         */
+        void MessagePlan::reserve(const size_t& num_fields, const size_t& buffer_length)
+        {
+            operations_.reserve(num_fields);
+            byte_field_.reserve(buffer_length);
+        }
+
+        /**
+         * Clear the plan
+         */
+        void MessagePlan::clear()
+        {
+            operations_.clear();
+            byte_field_.clear();
+            min_buffer_length_ = 0;
+            record_length_ = 0;
+        }
+
+        /**
+         * Decodes a buffer onto the value containers of the plan
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::decode(const uint8_t* buffer, const size_t& buffer_length) const
+        {
+            //-Checks (once per message)
+            if (NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const FieldOperation* operation = operations_.data();
+            const FieldOperation* end = operation + operations_.size();
+            for (; operation != end; ++operation)
+            {
+                if (FieldOperationKind_Integer == operation->kind)
+                {
+                    store_value(operation->data, operation->data_length, decode_field(*operation, buffer, buffer_length));
+                }
+                else
+                {
+                    decode_bytes(*operation, buffer, buffer_length, operation->data);
+                }
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Decodes a buffer onto a value record (the values of the descriptors are untouched)
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @param record The value record, 'record_length()' bytes aligned as its values (@see MessageRecord)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::decode(const uint8_t* buffer, const size_t& buffer_length, uint8_t* record) const
+        {
+            //-Checks (once per message)
+            if (NULL == buffer || NULL == record)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const FieldOperation* operation = operations_.data();
+            const FieldOperation* end = operation + operations_.size();
+            for (; operation != end; ++operation)
+            {
+                if (FieldOperationKind_Integer == operation->kind)
+                {
+                    store_value(record + operation->data_offset, operation->data_length, decode_field(*operation, buffer, buffer_length));
+                }
+                else
+                {
+                    decode_bytes(*operation, buffer, buffer_length, record + operation->data_offset);
+                }
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Decodes an integral field operation
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 'min_buffer_length()' bytes
+         * @param operation The field operation (FieldOperationKind_Integer)
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @return uint64_t containing the value (sign extended for signed types)
+         */
+        uint64_t MessagePlan::decode_field(const FieldOperation& operation, const uint8_t* buffer, const size_t& buffer_length)
+        {
+            const uint8_t* buffer_ptr = buffer + operation.byte_index;
+            const uint64_t window = buffer::load_window(buffer_ptr, buffer_length - operation.byte_index);
+            uint64_t raw;
+            if (0 == operation.spill_bits)
+            {
+                raw = window >> operation.window_shift;
+            }
+            else
+            {
+                raw = (window << operation.spill_bits) | (buffer_ptr[sizeof(uint64_t)] >> (8 - operation.spill_bits));
+            }
+            raw &= operation.mask;
+            if (operation.swap)
+            {
+                raw = buffer::swap_endian(raw) >> operation.swap_shift;
+            }
+            return (raw ^ operation.sign_bit) - operation.sign_bit;
+        }
+
+        /**
+         * Interprets a value as the value type of a field operation (a full width signed field is not sign
+         * extended by decode_field, a value container is not sign extended by load_value)
+         * @param operation The field operation (FieldOperationKind_Integer)
+         * @param value The value
+         * @return int64_t containing the value
+         */
+        int64_t MessagePlan::container_value(const FieldOperation& operation, const uint64_t& value)
+        {
+            if (operation.data_length >= sizeof(uint64_t))
+            {
+                return (int64_t) value;
+            }
+            const uint64_t truncated = value & buffer::low_mask(BYTE2BIT(operation.data_length));
+            if (!operation.is_signed)
+            {
+                return (int64_t) truncated;
+            }
+            const uint64_t sign_bit = ((uint64_t) 1) << (BYTE2BIT(operation.data_length) - 1);
+            return (int64_t) ((truncated ^ sign_bit) - sign_bit);
+        }
+
+        /**
+         * Decodes a byte array field operation
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 'min_buffer_length()' bytes
+         * @param operation The field operation (FieldOperationKind_Bytes)
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @param output The output, 'operation.data_length' bytes
+         */
+        void MessagePlan::decode_bytes(const FieldOperation& operation, const uint8_t* buffer, const size_t& buffer_length, uint8_t* output)
+        {
+            const uint8_t* buffer_ptr = buffer + operation.byte_index;
+            if (0 == operation.bit_offset)
+            {
+                memcpy(output, buffer_ptr, operation.data_length);
+            }
+            else
+            {
+                for (size_t i = 0; i < operation.data_length; ++i)
+                {
+                    output[i] = (uint8_t) buffer::extract_raw(buffer_ptr, buffer_length - operation.byte_index, BYTE2BIT(i) + operation.bit_offset, 8);
+                }
+            }
+        }
+
+        /**
+         * Returns the index of the operation of a data descriptor (resolve once, then index directly)
+         * @param data_descriptor The data descriptor
+         * @return size_t containing the index, operations().size() if not found
+         */
+        size_t MessagePlan::index_of(const DataDescriptor* data_descriptor) const
+        {
+            for (size_t i = 0; i < operations_.size(); ++i)
+            {
+                if (operations_[i].descriptor == data_descriptor)
+                {
+                    return i;
+                }
+            }
+            return operations_.size();
+        }
+
+        /**
+         * Encodes the value containers of the plan onto a buffer, bits not covered by a field are untouched
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::encode(uint8_t* buffer, const size_t& buffer_length) const
+        {
+            //-Checks (once per message)
+            if (NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const FieldOperation* operation = operations_.data();
+            const FieldOperation* end = operation + operations_.size();
+            for (; operation != end; ++operation)
+            {
+                encode_field(*operation, buffer, buffer_length);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Encodes a value record onto a buffer, bits not covered by a field are untouched
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @param record The value record (@see decode)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::encode(uint8_t* buffer, const size_t& buffer_length, const uint8_t* record) const
+        {
+            //-Checks (once per message)
+            if (NULL == buffer || NULL == record)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const FieldOperation* operation = operations_.data();
+            const FieldOperation* end = operation + operations_.size();
+            for (; operation != end; ++operation)
+            {
+                encode_field(*operation, record + operation->data_offset, buffer, buffer_length);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Detects the fields that differ between two encodings of the message without decoding them: the
+         * buffers are XOR-ed a word (16 bytes with SSE2) at a time and the differing bits mapped onto
+         * fields through the bit to field table
+         * @param previous The previous buffer
+         * @param current The current buffer
+         * @param buffer_length The length of both buffers
+         * @param changed (output) The bitmap, bit (i % 64) of word (i / 64) flags the operation i, (size() + 63) / 64 words
+         * @param num_changed (output) The number of changed fields
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::delta(const uint8_t* previous, const uint8_t* current, const size_t& buffer_length, uint64_t* changed, size_t& num_changed) const
+        {
+            num_changed = 0;
+
+            //-Checks (once per message)
+            if (NULL == previous || NULL == current || NULL == changed)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+            memset(changed, 0, sizeof(uint64_t) * ((operations_.size() + 63) / 64));
+
+            //-Only the bytes covered by fields are compared
+            const size_t length = byte_field_.size();
+            size_t byte_idx = 0;
+
+            #if defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; byte_idx + sizeof(__m128i) <= length; byte_idx += sizeof(__m128i))
+            {
+                const __m128i diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (previous + byte_idx)), _mm_loadu_si128((const __m128i*) (current + byte_idx)));
+                if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)))
+                {
+                    for (size_t i = 0; i < sizeof(__m128i); ++i)
+                    {
+                        mark_changed_bits(byte_idx + i, previous[byte_idx + i] ^ current[byte_idx + i], changed, num_changed);
+                    }
+                }
+            }
+            #endif
+
+            for (; byte_idx + sizeof(uint64_t) <= length; byte_idx += sizeof(uint64_t))
+            {
+                uint64_t previous_word;
+                uint64_t current_word;
+                memcpy(&previous_word, previous + byte_idx, sizeof(uint64_t));
+                memcpy(&current_word, current + byte_idx, sizeof(uint64_t));
+                if (0 != (previous_word ^ current_word))
+                {
+                    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+                    {
+                        mark_changed_bits(byte_idx + i, previous[byte_idx + i] ^ current[byte_idx + i], changed, num_changed);
+                    }
+                }
+            }
+
+            for (; byte_idx < length; ++byte_idx)
+            {
+                mark_changed_bits(byte_idx, previous[byte_idx] ^ current[byte_idx], changed, num_changed);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Maps the differing bits of a byte onto the fields covering them
+         * @param byte_idx The byte index
+         * @param changed_bits The differing bits (XOR of both bytes)
+         * @param changed (output) The bitmap of changed fields
+         * @param num_changed (output) The number of changed fields, incremented
+         */
+        void MessagePlan::mark_changed_bits(const size_t& byte_idx, const uint8_t& changed_bits, uint64_t* changed, size_t& num_changed) const
+        {
+            if (0 == changed_bits || NO_FIELD == byte_field_[byte_idx])
+            {
+                return;
+            }
+            for (size_t bit_pos = 0; bit_pos < 8; ++bit_pos)
+            {
+                if (0 == (changed_bits & (0x80 >> bit_pos)))
+                {
+                    continue;
+                }
+
+                //-Fields are offset sorted, scan the ones starting up to the differing bit
+                const size_t bit_idx = BYTE2BIT(byte_idx) + bit_pos;
+                for (size_t field_idx = byte_field_[byte_idx]; field_idx < operations_.size(); ++field_idx)
+                {
+                    const FieldOperation& operation = operations_[field_idx];
+                    const size_t begin_bit = field_begin_bit(operation);
+                    if (begin_bit > bit_idx)
+                    {
+                        break;
+                    }
+                    const uint64_t field_mask = ((uint64_t) 1) << (field_idx % 64);
+                    if (bit_idx < begin_bit + field_num_bits(operation) && 0 == (changed[field_idx / 64] & field_mask))
+                    {
+                        changed[field_idx / 64] |= field_mask;
+                        ++num_changed;
+                    }
+                }
+            }
+        }
+
+        /**
+         * Encodes only the field operations flagged on a bitmap, bits not covered by those fields are untouched
+         * @param buffer The buffer where to encode (holding the previous encoding)
+         * @param buffer_length The length of the buffer
+         * @param dirty The bitmap, bit (i % 64) of word (i / 64) flags the operation i
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessagePlan::encode_dirty(uint8_t* buffer, const size_t& buffer_length, const uint64_t* dirty) const
+        {
+            //-Checks (once per message)
+            if (NULL == buffer || NULL == dirty)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < min_buffer_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const size_t num_words = (operations_.size() + 63) / 64;
+            for (size_t word_idx = 0; word_idx < num_words; ++word_idx)
+            {
+                uint64_t word = dirty[word_idx];
+                while (0 != word)
+                {
+                    //-Lowest flagged operation
+                    const size_t bit_idx = bit::count_trailing_zeros(word);
+                    word &= word - 1;
+                    encode_field(operations_[word_idx * 64 + bit_idx], buffer, buffer_length);
+                }
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Encodes a field operation
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 'min_buffer_length()' bytes
+         * @param operation The field operation
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         */
+        void MessagePlan::encode_field(const FieldOperation& operation, uint8_t* buffer, const size_t& buffer_length)
+        {
+            encode_field(operation, operation.data, buffer, buffer_length);
+        }
+
+        /**
+         * Encodes a value onto the field of a field operation
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 'min_buffer_length()' bytes
+         * @param operation The field operation
+         * @param data The value container ('operation.data_length' bytes)
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         */
+        void MessagePlan::encode_field(const FieldOperation& operation, const uint8_t* data, uint8_t* buffer, const size_t& buffer_length)
+        {
+            uint8_t* buffer_ptr = buffer + operation.byte_index;
+            const size_t available = buffer_length - operation.byte_index;
+            if (FieldOperationKind_Integer == operation.kind)
+            {
+                uint64_t raw = load_value(data, operation.data_length) & operation.mask;
+                if (operation.swap)
+                {
+                    raw = buffer::swap_endian(raw) >> operation.swap_shift;
+                }
+                if (0 == operation.spill_bits)
+                {
+                    const uint64_t window = buffer::load_window(buffer_ptr, available);
+                    buffer::store_window(buffer_ptr, available, (window & ~operation.window_mask) | (raw << operation.window_shift));
+                }
+                else
+                {
+                    buffer::insert_raw(buffer_ptr, available, operation.bit_offset, operation.num_bits, raw);
+                }
+            }
+            else if (0 == operation.bit_offset)
+            {
+                memcpy(buffer_ptr, data, operation.data_length);
+            }
+            else
+            {
+                for (size_t i = 0; i < operation.data_length; ++i)
+                {
+                    buffer::insert_raw(buffer_ptr, available, BYTE2BIT(i) + operation.bit_offset, 8, data[i]);
+                }
+            }
+        }
+
+        /**
+         * Loads a value from its container
+         * @param data The value container
+         * @param data_length The container length (1, 2, 4 or 8 bytes)
+         * @return uint64_t containing the value (not sign extended)
+         */
+        uint64_t MessagePlan::load_value(const uint8_t* data, const size_t& data_length)
+        {
+            switch (data_length)
+            {
+                case sizeof(uint8_t)  : { return *data; }
+                case sizeof(uint16_t) : { uint16_t value; memcpy(&value, data, sizeof(value)); return value; }
+                case sizeof(uint32_t) : { uint32_t value; memcpy(&value, data, sizeof(value)); return value; }
+                case sizeof(uint64_t) : { uint64_t value; memcpy(&value, data, sizeof(value)); return value; }
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * Stores a value onto its container
+         * @param data The value container
+         * @param data_length The container length (1, 2, 4 or 8 bytes)
+         * @param value The value to be stored (truncated to the container)
+         */
+        void MessagePlan::store_value(uint8_t* data, const size_t& data_length, const uint64_t& value)
+        {
+            switch (data_length)
+            {
+                case sizeof(uint8_t)  : { *data = (uint8_t) value; break; }
+                case sizeof(uint16_t) : { uint16_t tmp = (uint16_t) value; memcpy(data, &tmp, sizeof(tmp)); break; }
+                case sizeof(uint32_t) : { uint32_t tmp = (uint32_t) value; memcpy(data, &tmp, sizeof(tmp)); break; }
+                case sizeof(uint64_t) : { memcpy(data, &value, sizeof(value)); break; }
+                default:
+                    break;
+            }
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_MESSAGE_PLAN_H*/
@@ -0,0 +1,214 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_MESSAGE_RECORD_H
+#define OPENLIB_ICD_MESSAGE_RECORD_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/value_arena.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Decoded values of a message, held apart from its layout: the compiled plan is the immutable,
+         * shared schema and the record the per-thread (or per-message) state, so any number of threads
+         * decode/encode against the same MessageICD without locks nor copies of the descriptors
+         * The values follow the plan layout (@see MessagePlan::record_length), the plan must outlive the
+         * record and must not be recompiled while in use
+         */
+        class MessageRecord : public NonCopyable
+        {
+            public:
+                //-Constructor & Destructor
+                MessageRecord() : plan_(NULL) {};
+                explicit MessageRecord(const MessagePlan& plan) : plan_(NULL)   { reset(plan); };
+                explicit MessageRecord(const MessageICD& icd_message) : plan_(NULL) { reset(icd_message.plan()); };
+                virtual ~MessageRecord() {};
+
+                //-Accessor
+                inline const MessagePlan* plan() const          { return plan_;             }
+                inline const uint8_t* data() const              { return arena_.data();     }
+                inline uint8_t* data()                          { return arena_.data();     }
+                inline size_t length() const                    { return (NULL == plan_) ? 0 : plan_->record_length(); }
+                inline size_t size() const                      { return (NULL == plan_) ? 0 : plan_->operations().size(); }
+
+                //-Ancillary functions
+                inline void reset(const MessagePlan& plan);
+                inline ParserError decode(const uint8_t* buffer, const size_t& buffer_length);
+                inline ParserError encode(uint8_t* buffer, const size_t& buffer_length) const;
+                inline const uint8_t* value(const size_t& field_idx) const;
+                inline uint8_t* value(const size_t& field_idx);
+                template <typename T> inline T get(const size_t& field_idx) const;
+                template <typename T> inline ParserError get(const size_t& field_idx, T& value) const;
+                template <typename T> inline ParserError set(const size_t& field_idx, const T& value);
+
+            private:
+                //-Fields
+                const MessagePlan*  plan_;
+                ValueArena          arena_;
+
+        }; /*class MessageRecord*/
+
+        /**
+         * Lays out (zeroed) the values of a plan, the block is kept if big enough
+         * @param plan The compiled plan (@see MessageICD::compile)
+         */
+        void MessageRecord::reset(const MessagePlan& plan)
+        {
+            const size_t length = plan.record_length();
+            arena_.reserve((0 == length) ? 1 : length);
+            memset(arena_.data(), 0, arena_.capacity());
+            plan_ = &plan;
+        }
+
+        /**
+         * Decodes a buffer onto the record
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageRecord::decode(const uint8_t* buffer, const size_t& buffer_length)
+        {
+            if (NULL == plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            return plan_->decode(buffer, buffer_length, arena_.data());
+        }
+
+        /**
+         * Encodes the record onto a buffer, bits not covered by a field are untouched
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageRecord::encode(uint8_t* buffer, const size_t& buffer_length) const
+        {
+            if (NULL == plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            return plan_->encode(buffer, buffer_length, arena_.data());
+        }
+
+        /**
+         * Access to the value container of a field
+         * @param field_idx The field index (offset order, @see MessageICD::find)
+         * @return The container ('data_length' bytes), NULL if out of range
+         */
+        const uint8_t* MessageRecord::value(const size_t& field_idx) const
+        {
+            return (field_idx < size()) ? arena_.data() + plan_->operations()[field_idx].data_offset : NULL;
+        }
+
+        /**
+         * Access to the value container of a field
+         * @param field_idx The field index (offset order, @see MessageICD::find)
+         * @return The container ('data_length' bytes), NULL if out of range
+         */
+        uint8_t* MessageRecord::value(const size_t& field_idx)
+        {
+            return (field_idx < size()) ? arena_.data() + plan_->operations()[field_idx].data_offset : NULL;
+        }
+
+        /**
+         * Reads an integral value
+         * IMPORTANT: NO CHECKS!!!!!!!! the field must exist and the size of the type match its container
+         * @tparam T The value type
+         * @param field_idx The field index
+         * @return T containing the value
+         */
+        template <typename T>
+        T MessageRecord::get(const size_t& field_idx) const
+        {
+            T value;
+            memcpy(&value, arena_.data() + plan_->operations()[field_idx].data_offset, sizeof(T));
+            return value;
+        }
+
+        /**
+         * Reads an integral value
+         * @tparam T The value type, its size must match the field value container
+         * @param field_idx The field index
+         * @param value (output) The value
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        template <typename T>
+        ParserError MessageRecord::get(const size_t& field_idx, T& value) const
+        {
+            if (field_idx >= size())
+            {
+                return (NULL == plan_) ? ParserError_NullParameter : ParserError_InvalidDataType;
+            }
+            const FieldOperation& operation = plan_->operations()[field_idx];
+            if (FieldOperationKind_Integer != operation.kind)
+            {
+                return ParserError_InvalidDataType;
+            }
+            if (sizeof(T) != operation.data_length)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            value = get<T>(field_idx);
+            return ParserError_None;
+        }
+
+        /**
+         * Writes an integral value
+         * @tparam T The value type, its size must match the field value container
+         * @param field_idx The field index
+         * @param value The value
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        template <typename T>
+        ParserError MessageRecord::set(const size_t& field_idx, const T& value)
+        {
+            if (field_idx >= size())
+            {
+                return (NULL == plan_) ? ParserError_NullParameter : ParserError_InvalidDataType;
+            }
+            const FieldOperation& operation = plan_->operations()[field_idx];
+            if (FieldOperationKind_Integer != operation.kind)
+            {
+                return ParserError_InvalidDataType;
+            }
+            if (sizeof(T) != operation.data_length)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            memcpy(arena_.data() + operation.data_offset, &value, sizeof(T));
+            return ParserError_None;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_MESSAGE_RECORD_H*/
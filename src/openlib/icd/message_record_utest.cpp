@@ -0,0 +1,158 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "message_record.h"
+#include "decode_fixture_utest.h"
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const size_t RECORD_MESSAGES = 500;
+
+TEST_GROUP(message_record)
+{
+	DecodeFixture fixture;
+
+	void setup()
+	{
+		fixture.setup(RECORD_MESSAGES, 17);
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(message_record, Test_decode)
+{
+	MessageICD& message = fixture.message;
+	MessageRecord record(message);
+	CHECK_EQUAL(message.size(), record.size());
+	size_t values_length = 0;
+	for (size_t field_idx = 0; field_idx < message.size(); ++field_idx)
+	{
+		values_length += message.field(field_idx)->data_length();
+	}
+	CHECK(record.length() >= values_length);
+	for (size_t row = 0; row < RECORD_MESSAGES; ++row)
+	{
+		CHECK_EQUAL(ParserError_None, record.decode(fixture.frame(row), FIXTURE_LENGTH));
+		fixture.check_row(row, [&] (const size_t& field_idx) { return record.value(field_idx); });
+	}
+
+	//-The values of the descriptors are untouched by the record
+	const int16_t count = *message.field(message.find("count"))->as_int16();
+	CHECK_EQUAL(ParserError_None, record.decode(fixture.frame(0), FIXTURE_LENGTH));
+	CHECK_EQUAL(count, *message.field(message.find("count"))->as_int16());
+}
+
+TEST(message_record, Test_encode)
+{
+	MessageICD& message = fixture.message;
+	MessageRecord record(message.plan());
+	CHECK_EQUAL(ParserError_None, record.set<int16_t>(message.find("count"), -1234));
+	CHECK_EQUAL(ParserError_None, record.set<int>(message.find("mode"), 13));
+	CHECK_EQUAL(ParserError_None, record.set<int32_t>(message.find("wide"), 0x12345678));
+	memcpy(record.value(message.find("name")), "abc", 3);
+
+	uint8_t buffer[FIXTURE_LENGTH] = {0};
+	CHECK_EQUAL(ParserError_None, record.encode(buffer, sizeof(buffer)));
+
+	MessageRecord decoded(message);
+	CHECK_EQUAL(ParserError_None, decoded.decode(buffer, sizeof(buffer)));
+	CHECK_EQUAL(-1234, decoded.get<int16_t>(message.find("count")));
+	CHECK_EQUAL(13, decoded.get<int>(message.find("mode")));
+	CHECK_EQUAL(0x12345678, decoded.get<int32_t>(message.find("wide")));
+	CHECK(0 == memcmp("abc", decoded.value(message.find("name")), 3));
+
+	//-Same encoding as the message
+	uint8_t expected[FIXTURE_LENGTH] = {0};
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+	CHECK_EQUAL(ParserError_None, message.encode(expected, sizeof(expected)));
+	CHECK(0 == memcmp(expected, buffer, sizeof(buffer)));
+}
+
+TEST(message_record, Test_threads)
+{
+	const MessageICD& message = fixture.message;
+	//-Expected values, single threaded
+	const size_t length = message.plan().record_length();
+	vector<uint8_t> expected(RECORD_MESSAGES * length);
+	MessageRecord record(message);
+	for (size_t row = 0; row < RECORD_MESSAGES; ++row)
+	{
+		CHECK_EQUAL(ParserError_None, record.decode(fixture.frame(row), FIXTURE_LENGTH));
+		memcpy(&expected[row * length], record.data(), length);
+	}
+
+	//-All the threads share the same message, one record each
+	const MessagePlan& plan = message.plan();
+	vector<size_t> mismatches(4, 0);
+	vector<thread> threads;
+	for (size_t thread_idx = 0; thread_idx < mismatches.size(); ++thread_idx)
+	{
+		threads.push_back(thread([&, thread_idx] ()
+			{
+				MessageRecord local(plan);
+				for (size_t pass = 0; pass < 20; ++pass)
+				{
+					for (size_t row = thread_idx; row < RECORD_MESSAGES; row += 3)
+					{
+						local.decode(fixture.frame(row), FIXTURE_LENGTH);
+						mismatches[thread_idx] += (0 != memcmp(&expected[row * length], local.data(), length));
+					}
+				}
+			}));
+	}
+	for (size_t thread_idx = 0; thread_idx < threads.size(); ++thread_idx)
+	{
+		threads[thread_idx].join();
+		CHECK_EQUAL(0u, mismatches[thread_idx]);
+	}
+}
+
+TEST(message_record, Test_errors)
+{
+	const MessageICD& message = fixture.message;
+	MessageRecord empty;
+	CHECK_EQUAL(0u, empty.size());
+	CHECK_EQUAL(ParserError_NullParameter, empty.decode(fixture.buffers.data(), FIXTURE_LENGTH));
+	CHECK(NULL == empty.value(0));
+
+	MessageRecord record(message);
+	int32_t value = 0;
+	uint8_t small = 0;
+	CHECK_EQUAL(ParserError_NotEnoughData, record.decode(fixture.buffers.data(), FIXTURE_LENGTH - 1));
+	CHECK_EQUAL(ParserError_NullParameter, record.decode(NULL, FIXTURE_LENGTH));
+	CHECK_EQUAL(ParserError_InvalidDataType, record.get(message.find("name"), value));
+	CHECK_EQUAL(ParserError_InvalidDataType, record.get(message.size(), value));
+	CHECK_EQUAL(ParserError_ContainerTooSmall, record.get(message.find("count"), value));
+	CHECK_EQUAL(ParserError_ContainerTooSmall, record.set(message.find("wide"), small));
+	CHECK(NULL == record.value(message.size()));
+}
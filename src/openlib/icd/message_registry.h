@@ -0,0 +1,367 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_MESSAGE_REGISTRY_H
+#define OPENLIB_ICD_MESSAGE_REGISTRY_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/enum/endianess.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/message_icd.h"
+#include <algorithm>
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Routes the frames of a mixed stream onto the message they carry: the message ID is extracted
+         * from a header field common to all the messages, then resolved through a dense jump table
+         * (small ID ranges) or a flat open addressing hash table (sparse IDs), chosen on compile
+         * Owns the registered messages, counts the frames per ID
+         */
+        class MessageRegistry : public NonCopyable
+        {
+            public:
+                //-Constants
+                static const uint32_t NO_ROUTE = 0xFFFFFFFF;
+                static const uint64_t MAX_DENSE_SPAN = 65536;   //-Jump table entries limit
+
+                /**
+                 * Registered message
+                 */
+                struct Route
+                {
+                    uint64_t    id;
+                    MessageICD* icd_message;
+                    uint64_t    count;      //-Frames dispatched
+                    uint64_t    errors;     //-Frames that failed to decode
+                };
+                typedef std::vector<Route> RouteVector;
+
+                //-Constructor & Destructor
+                inline MessageRegistry(const size_t& byte_offset, const size_t& bit_offset, const size_t& num_bits, const Endianess& endianess);
+                virtual ~MessageRegistry() { clear(); };
+
+                //-Accessor
+                inline const RouteVector& routes() const    { return routes_;           }
+                inline size_t size() const                  { return routes_.size();    }
+                inline bool is_dense() const                { return !dense_.empty();   }
+                inline uint64_t unknown() const             { return unknown_;          }
+                inline const Route* route(const uint64_t& id) const;
+                inline MessageICD* find(const uint64_t& id) const;
+
+                //-Ancillary functions
+                inline ParserError add(const uint64_t& id, MessageICD* icd_message);
+                inline void clear();
+                inline void compile();
+                inline void reset_counters();
+                inline ParserError id(const uint8_t* buffer, const size_t& buffer_length, uint64_t& message_id) const;
+                inline ParserError dispatch(const uint8_t* buffer, const size_t& buffer_length, MessageICD*& icd_message);
+
+            protected:
+                //-Types
+                struct Slot
+                {
+                    uint64_t    id;
+                    uint32_t    route_idx;  //-NO_ROUTE: empty slot
+                };
+
+                //-Functions
+                inline uint32_t lookup(const uint64_t& id) const;
+                static inline uint64_t hash(const uint64_t& id) { return id * 0x9E3779B97F4A7C15ull; }
+
+                //-Fields
+                size_t              id_bit_offset_;     //-From the start of the frame
+                size_t              id_num_bits_;
+                Endianess           id_endianess_;
+                size_t              id_length_;         //-Bytes needed to extract the ID
+                RouteVector         routes_;
+                std::vector<uint32_t> dense_;           //-Route index per (id - dense_base_)
+                uint64_t            dense_base_;
+                std::vector<Slot>   slots_;             //-Hash table, power of 2 capacity
+                size_t              shift_;             //-Hash bits: 64 - log2(capacity)
+                uint64_t            unknown_;           //-Frames with an unregistered ID
+                bool                compiled_;
+
+        }; /*class MessageRegistry*/
+
+        /**
+         * Constructor
+         * @param byte_offset The byte index of the message ID field
+         * @param bit_offset The bit position of the message ID field within the byte (wire order)
+         * @param num_bits The number of bits of the message ID field [1..64]
+         * @param endianess The endianess of the message ID field on the wire
+         */
+        MessageRegistry::MessageRegistry(const size_t& byte_offset, const size_t& bit_offset, const size_t& num_bits, const Endianess& endianess) :
+            id_bit_offset_(BYTE2BIT(byte_offset) + bit_offset),
+            id_num_bits_(num_bits),
+            id_endianess_(endianess),
+            id_length_(0),
+            dense_base_(0),
+            shift_(64),
+            unknown_(0),
+            compiled_(false)
+        {
+            assert(num_bits > 0 && num_bits <= 64);
+            id_length_ = (id_bit_offset_ + id_num_bits_ + 7) / 8;
+        }
+
+        /**
+         * Registers a message, the registry takes its ownership
+         * @param id The message ID
+         * @param icd_message The message (allocated with new)
+         * @return ParserError (ParserError_None: SUCCESS, the message is deleted on failure)
+         */
+        ParserError MessageRegistry::add(const uint64_t& id, MessageICD* icd_message)
+        {
+            if (NULL == icd_message)
+            {
+                return ParserError_NullParameter;
+            }
+            for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+            {
+                if (id == routes_[route_idx].id)
+                {
+                    delete icd_message;
+                    return ParserError_DuplicatedMessage;
+                }
+            }
+            Route route = {id, icd_message, 0, 0};
+            routes_.push_back(route);
+            compiled_ = false;
+            return ParserError_None;
+        }
+
+        /**
+         * Deletes all the messages
+         */
+        void MessageRegistry::clear()
+        {
+            for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+            {
+                delete routes_[route_idx].icd_message;
+            }
+            routes_.clear();
+            dense_.clear();
+            slots_.clear();
+            unknown_ = 0;
+            compiled_ = false;
+        }
+
+        /**
+         * Builds the lookup table (done on the first dispatch after the messages change): a jump table
+         * when the IDs span up to MAX_DENSE_SPAN values with at least 1 in 4 used (or up to 256 values),
+         * a hash table with load factor <= 0.5 otherwise
+         */
+        void MessageRegistry::compile()
+        {
+            dense_.clear();
+            slots_.clear();
+            compiled_ = true;
+            if (routes_.empty())
+            {
+                return;
+            }
+
+            uint64_t min_id = routes_[0].id;
+            uint64_t max_id = routes_[0].id;
+            for (size_t route_idx = 1; route_idx < routes_.size(); ++route_idx)
+            {
+                min_id = std::min(min_id, routes_[route_idx].id);
+                max_id = std::max(max_id, routes_[route_idx].id);
+            }
+
+            const uint64_t span = max_id - min_id;
+            if (span < MAX_DENSE_SPAN && (span < 256 || span < 4 * (uint64_t) routes_.size()))
+            {
+                dense_base_ = min_id;
+                dense_.assign((size_t) span + 1, (uint32_t) NO_ROUTE);
+                for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+                {
+                    dense_[(size_t) (routes_[route_idx].id - min_id)] = (uint32_t) route_idx;
+                }
+                return;
+            }
+
+            size_t capacity = 2;
+            shift_ = 63;
+            while (capacity < 2 * routes_.size())
+            {
+                capacity <<= 1;
+                --shift_;
+            }
+            Slot empty = {0, (uint32_t) NO_ROUTE};
+            slots_.assign(capacity, empty);
+            for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+            {
+                size_t slot = (size_t) (hash(routes_[route_idx].id) >> shift_);
+                while (NO_ROUTE != slots_[slot].route_idx)
+                {
+                    slot = (slot + 1) & (capacity - 1);
+                }
+                slots_[slot].id = routes_[route_idx].id;
+                slots_[slot].route_idx = (uint32_t) route_idx;
+            }
+        }
+
+        /**
+         * Resets the frame counters
+         */
+        void MessageRegistry::reset_counters()
+        {
+            for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+            {
+                routes_[route_idx].count = 0;
+                routes_[route_idx].errors = 0;
+            }
+            unknown_ = 0;
+        }
+
+        /**
+         * Extracts the message ID of a frame
+         * @param buffer The frame
+         * @param buffer_length The length of the frame
+         * @param message_id (output) The message ID
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageRegistry::id(const uint8_t* buffer, const size_t& buffer_length, uint64_t& message_id) const
+        {
+            if (NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < id_length_)
+            {
+                return ParserError_NotEnoughData;
+            }
+            const uint64_t raw = buffer::extract_raw(buffer, buffer_length, id_bit_offset_, id_num_bits_);
+            message_id = buffer::raw_to_value<uint64_t>(raw, id_num_bits_, id_endianess_);
+            return ParserError_None;
+        }
+
+        /**
+         * Decodes a frame onto the message registered for its ID
+         * @param buffer The frame
+         * @param buffer_length The length of the frame
+         * @param icd_message (output) The message decoded, NULL if the ID is not registered
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageRegistry::dispatch(const uint8_t* buffer, const size_t& buffer_length, MessageICD*& icd_message)
+        {
+            icd_message = NULL;
+            if (!compiled_)
+            {
+                compile();
+            }
+
+            uint64_t message_id = 0;
+            const ParserError error = id(buffer, buffer_length, message_id);
+            if (ParserError_None != error)
+            {
+                return error;
+            }
+            const uint32_t route_idx = lookup(message_id);
+            if (NO_ROUTE == route_idx)
+            {
+                ++unknown_;
+                return ParserError_UnknownMessage;
+            }
+
+            Route& route = routes_[route_idx];
+            ++route.count;
+            icd_message = route.icd_message;
+            const ParserError decode_error = icd_message->decode(buffer, buffer_length);
+            if (ParserError_None != decode_error)
+            {
+                ++route.errors;
+            }
+            return decode_error;
+        }
+
+        /**
+         * Access to the route of a message ID (counters)
+         * @param id The message ID
+         * @return The route, NULL if not registered
+         */
+        const MessageRegistry::Route* MessageRegistry::route(const uint64_t& id) const
+        {
+            for (size_t route_idx = 0; route_idx < routes_.size(); ++route_idx)
+            {
+                if (id == routes_[route_idx].id)
+                {
+                    return &routes_[route_idx];
+                }
+            }
+            return NULL;
+        }
+
+        /**
+         * Access to the message of a message ID
+         * @param id The message ID
+         * @return The message, NULL if not registered
+         */
+        MessageICD* MessageRegistry::find(const uint64_t& id) const
+        {
+            const Route* found = route(id);
+            return (NULL == found) ? NULL : found->icd_message;
+        }
+
+        /**
+         * Resolves a message ID through the compiled table
+         * @param id The message ID
+         * @return uint32_t containing the route index, NO_ROUTE if not registered
+         */
+        uint32_t MessageRegistry::lookup(const uint64_t& id) const
+        {
+            if (!dense_.empty())
+            {
+                const uint64_t offset = id - dense_base_;
+                return (offset < dense_.size()) ? dense_[(size_t) offset] : (uint32_t) NO_ROUTE;
+            }
+            if (slots_.empty())
+            {
+                return NO_ROUTE;
+            }
+            const size_t mask = slots_.size() - 1;
+            size_t slot = (size_t) (hash(id) >> shift_);
+            while (NO_ROUTE != slots_[slot].route_idx)
+            {
+                if (id == slots_[slot].id)
+                {
+                    return slots_[slot].route_idx;
+                }
+                slot = (slot + 1) & mask;
+            }
+            return NO_ROUTE;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_MESSAGE_REGISTRY_H*/
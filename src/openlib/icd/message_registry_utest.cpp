@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "message_registry.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+/**
+ * Creates a message from its definition
+ * @param text The ICD definition
+ * @return The message (allocated with new)
+ */
+static MessageICD* create(const string& text)
+{
+	MessageICD* icd_message = new MessageICD();
+	TextICDParser parser;
+	parser.parse(text, icd_message[0]);
+	return icd_message;
+}
+
+TEST_GROUP(message_registry)
+{
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(message_registry, Test_dense)
+{
+	//-ID: 12 bits little-endian after a 4 bits version
+	MessageRegistry registry(0, 4, 12, Endianess_BigEndian);
+	CHECK_EQUAL(ParserError_None, registry.add(1, create("field id uint16 0 4 12 BE\nfield a uint8 2 0 8 BE")));
+	CHECK_EQUAL(ParserError_None, registry.add(2, create("field id uint16 0 4 12 BE\nfield b uint16 2 0 16 BE")));
+	CHECK_EQUAL(ParserError_None, registry.add(7, create("field id uint16 0 4 12 BE\nfield c int8 2 0 4 BE")));
+	CHECK_EQUAL(ParserError_DuplicatedMessage, registry.add(2, create("field id uint16 0 4 12 BE")));
+	CHECK_EQUAL(ParserError_NullParameter, registry.add(3, NULL));
+	CHECK_EQUAL(3u, registry.size());
+
+	const uint8_t frame_1[3] = {0xA0, 0x01, 0x55};
+	const uint8_t frame_2[4] = {0xA0, 0x02, 0x12, 0x34};
+	const uint8_t frame_7[3] = {0xA0, 0x07, 0xF0};
+	const uint8_t frame_9[3] = {0xA0, 0x09, 0x00};
+	MessageICD* icd_message = NULL;
+
+	CHECK_EQUAL(ParserError_None, registry.dispatch(frame_1, sizeof(frame_1), icd_message));
+	CHECK(registry.is_dense());
+	CHECK(registry.find(1) == icd_message);
+	CHECK_EQUAL(0x55, icd_message->field(icd_message->find("a"))->uint8());
+
+	CHECK_EQUAL(ParserError_None, registry.dispatch(frame_2, sizeof(frame_2), icd_message));
+	CHECK_EQUAL(0x1234, icd_message->field(icd_message->find("b"))->uint16());
+	CHECK_EQUAL(ParserError_None, registry.dispatch(frame_2, sizeof(frame_2), icd_message));
+
+	CHECK_EQUAL(ParserError_None, registry.dispatch(frame_7, sizeof(frame_7), icd_message));
+	CHECK_EQUAL(-1, icd_message->field(icd_message->find("c"))->int8());
+
+	//-Unknown ID, short frames
+	CHECK_EQUAL(ParserError_UnknownMessage, registry.dispatch(frame_9, sizeof(frame_9), icd_message));
+	CHECK(NULL == icd_message);
+	CHECK_EQUAL(ParserError_NotEnoughData, registry.dispatch(frame_2, 3, icd_message));
+	CHECK(registry.find(2) == icd_message);
+	CHECK_EQUAL(ParserError_NotEnoughData, registry.dispatch(frame_2, 1, icd_message));
+	CHECK_EQUAL(ParserError_NullParameter, registry.dispatch(NULL, 4, icd_message));
+
+	//-Counters
+	CHECK_EQUAL(1u, registry.route(1)->count);
+	CHECK_EQUAL(3u, registry.route(2)->count);
+	CHECK_EQUAL(1u, registry.route(2)->errors);
+	CHECK_EQUAL(1u, registry.route(7)->count);
+	CHECK_EQUAL(1u, registry.unknown());
+	CHECK(NULL == registry.route(9));
+	registry.reset_counters();
+	CHECK_EQUAL(0u, registry.route(2)->count);
+	CHECK_EQUAL(0u, registry.unknown());
+}
+
+TEST(message_registry, Test_sparse)
+{
+	//-ID: 32 bits little-endian
+	MessageRegistry registry(0, 0, 32, Endianess_LittleEndian);
+	const uint64_t ids[] = {0x10, 0xDEAD0000, 0x12345678, 0xFFFFFFFF, 0x80000000};
+	for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+	{
+		CHECK_EQUAL(ParserError_None, registry.add(ids[i], create("field id uint32 0 0 32 LE")));
+	}
+
+	MessageICD* icd_message = NULL;
+	for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+	{
+		const uint8_t frame[4] = {(uint8_t) ids[i], (uint8_t) (ids[i] >> 8), (uint8_t) (ids[i] >> 16), (uint8_t) (ids[i] >> 24)};
+		uint64_t message_id = 0;
+		CHECK_EQUAL(ParserError_None, registry.id(frame, sizeof(frame), message_id));
+		CHECK_EQUAL(ids[i], message_id);
+		CHECK_EQUAL(ParserError_None, registry.dispatch(frame, sizeof(frame), icd_message));
+		CHECK(registry.find(ids[i]) == icd_message);
+		CHECK_EQUAL((uint32_t) ids[i], icd_message->field(0)->uint32());
+		CHECK_EQUAL(1u, registry.route(ids[i])->count);
+	}
+	CHECK(!registry.is_dense());
+
+	const uint8_t unknown[4] = {0x11, 0, 0, 0};
+	CHECK_EQUAL(ParserError_UnknownMessage, registry.dispatch(unknown, sizeof(unknown), icd_message));
+	CHECK_EQUAL(1u, registry.unknown());
+
+	//-Adding recompiles
+	CHECK_EQUAL(ParserError_None, registry.add(0x11, create("field id uint32 0 0 32 LE")));
+	CHECK_EQUAL(ParserError_None, registry.dispatch(unknown, sizeof(unknown), icd_message));
+	registry.clear();
+	CHECK_EQUAL(0u, registry.size());
+	CHECK_EQUAL(ParserError_UnknownMessage, registry.dispatch(unknown, sizeof(unknown), icd_message));
+}
@@ -0,0 +1,432 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_MESSAGE_VALIDATOR_H
+#define OPENLIB_ICD_MESSAGE_VALIDATOR_H
+
+//-Supporting libraries
+#include "openlib/buffer/bit.h"
+#include "openlib/icd/column_batch.h"
+#include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/enum_table.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/enum/rule_kind.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/message_record.h"
+#include <algorithm>
+#include <limits>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Compiled validation of a message: the rules of the fields (@see DataDescriptor::add_rule) are
+         * flattened onto a vector of checks run over a whole message, a value record or a batch of
+         * messages (column by column, the compares vectorize). The result is a bitmap of failing fields,
+         * bit (i % 64) of word (i / 64) flags the field i (offset order, @see MessageICD::find)
+         */
+        class MessageValidator
+        {
+            public:
+                //-Constructor & Destructor
+                MessageValidator() : plan_(NULL), num_words_(0) {};
+                ~MessageValidator() {};
+
+                //-Accessor
+                inline const MessagePlan* plan() const          { return plan_;             }
+                inline size_t num_checks() const                { return checks_.size();    }
+                inline const size_t& num_words() const          { return num_words_;        }
+
+                //-Ancillary functions
+                inline ParserError compile(const MessagePlan& plan);
+                inline void clear();
+                inline ParserError validate(const uint8_t* buffer, const size_t& buffer_length, uint64_t* failing, size_t& num_failing) const;
+                inline ParserError validate(const MessageRecord& record, uint64_t* failing, size_t& num_failing) const;
+                inline ParserError validate(const ColumnBatch& batch, uint64_t* failing, size_t& num_failing) const;
+
+            protected:
+                /**
+                 * A flattened rule
+                 */
+                struct Check
+                {
+                    RuleKind            kind;
+                    size_t              field_idx;
+                    size_t              data_length;    //-Value container length
+                    bool                is_signed;
+                    int64_t             min;            //-Range, lowest enumeration value
+                    int64_t             max;            //-Range, highest enumeration value
+                    uint64_t            mask;           //-Reserved bits
+                    size_t              allowed;        //-First word of the enumeration bitmap (NO_BITMAP: table lookup)
+                    const EnumTable*    enum_table;
+                };
+
+                //-Functions
+                inline bool passes(const Check& check, const int64_t& value) const;
+                inline void mark(const size_t& field_idx, uint64_t* failing, size_t& num_failing) const;
+                template <typename T>
+                inline void check_column(const Check& check, const T* column, const size_t& num_rows, uint64_t* failing) const;
+
+                //-Constants
+                static const size_t NO_BITMAP = (size_t) -1;
+                static const size_t MAX_BITMAP_SPAN = 65536;
+
+                //-Fields
+                std::vector<Check>      checks_;
+                std::vector<uint64_t>   allowed_;   //-Enumeration bitmaps (bit (value - min))
+                const MessagePlan*      plan_;
+                size_t                  num_words_; //-Words of a field bitmap
+
+        }; /*class MessageValidator*/
+
+        /**
+         * Flattens the rules of the fields of a plan
+         * IMPORTANT: the plan (and its descriptors) must outlive the validator (or the next compile)
+         * @param plan The compiled plan (@see MessageICD::compile)
+         * @return ParserError (ParserError_None: SUCCESS, ParserError_InvalidDataType if a rule targets a byte array)
+         */
+        ParserError MessageValidator::compile(const MessagePlan& plan)
+        {
+            clear();
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                const FieldOperation& operation = operations[field_idx];
+                const DataDescriptor& descriptor = *operation.descriptor;
+                const DataDescriptor::ValidationRuleVector& rules = descriptor.rules();
+                for (size_t rule_idx = 0; rule_idx < rules.size(); ++rule_idx)
+                {
+                    const ValidationRule& rule = rules[rule_idx];
+                    if (FieldOperationKind_Integer != operation.kind)
+                    {
+                        clear();
+                        return ParserError_InvalidDataType;
+                    }
+
+                    Check check;
+                    check.kind          = rule.kind;
+                    check.field_idx     = field_idx;
+                    check.data_length   = operation.data_length;
+                    check.is_signed     = operation.is_signed;
+                    check.min           = rule.min;
+                    check.max           = rule.max;
+                    check.mask          = rule.mask & operation.mask;
+                    check.allowed       = NO_BITMAP;
+                    check.enum_table    = NULL;
+
+                    if (RuleKind_EnumSet == rule.kind)
+                    {
+                        const EnumTable& enum_table = descriptor.enum_table();
+                        check.enum_table = &enum_table;
+
+                        //-Values as decoded (container width, zero extended enumerations), the labels the field
+                        //-cannot hold are never matched
+                        std::vector<int64_t> values;
+                        for (size_t enum_idx = 0; enum_idx < enum_table.size(); ++enum_idx)
+                        {
+                            const int64_t value = MessagePlan::container_value(operation, (uint64_t) (int64_t) enum_table.entries()[enum_idx].value);
+                            if (operation.is_signed || (uint64_t) value <= operation.mask)
+                            {
+                                values.push_back(value);
+                            }
+                        }
+                        check.min = values.empty() ? 0 : *std::min_element(values.begin(), values.end());
+                        check.max = values.empty() ? -1 : *std::max_element(values.begin(), values.end());
+
+                        //-Compact enumerations are checked against a bitmap
+                        if (check.max - check.min < (int64_t) MAX_BITMAP_SPAN)
+                        {
+                            check.allowed = allowed_.size();
+                            allowed_.resize(allowed_.size() + (size_t) (check.max - check.min + 64) / 64, 0);
+                            for (size_t value_idx = 0; value_idx < values.size(); ++value_idx)
+                            {
+                                const size_t bit_idx = (size_t) (values[value_idx] - check.min);
+                                allowed_[check.allowed + bit_idx / 64] |= ((uint64_t) 1) << (bit_idx % 64);
+                            }
+                        }
+                    }
+                    else if (RuleKind_Range != rule.kind && RuleKind_NonZero != rule.kind && RuleKind_ReservedZero != rule.kind)
+                    {
+                        clear();
+                        return ParserError_InvalidDataType;
+                    }
+                    checks_.push_back(check);
+                }
+            }
+            plan_ = &plan;
+            num_words_ = (operations.size() + 63) / 64;
+            return ParserError_None;
+        }
+
+        /**
+         * Clears the checks
+         */
+        void MessageValidator::clear()
+        {
+            checks_.clear();
+            allowed_.clear();
+            plan_ = NULL;
+            num_words_ = 0;
+        }
+
+        /**
+         * Validates a message on the wire (the fields are extracted straight from the buffer)
+         * @param buffer The message
+         * @param buffer_length The length of the buffer
+         * @param failing (output) The bitmap of failing fields, num_words() words
+         * @param num_failing (output) The number of failing fields
+         * @return ParserError (ParserError_None: SUCCESS, whether the message is valid or not)
+         */
+        ParserError MessageValidator::validate(const uint8_t* buffer, const size_t& buffer_length, uint64_t* failing, size_t& num_failing) const
+        {
+            num_failing = 0;
+            if (NULL == plan_ || NULL == buffer || NULL == failing)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < plan_->min_buffer_length())
+            {
+                return ParserError_NotEnoughData;
+            }
+            memset(failing, 0, num_words_ * sizeof(uint64_t));
+            const MessagePlan::FieldOperationVector& operations = plan_->operations();
+            for (size_t check_idx = 0; check_idx < checks_.size(); ++check_idx)
+            {
+                const Check& check = checks_[check_idx];
+                const FieldOperation& operation = operations[check.field_idx];
+                const int64_t value = MessagePlan::container_value(operation, MessagePlan::decode_field(operation, buffer, buffer_length));
+                if (!passes(check, value))
+                {
+                    mark(check.field_idx, failing, num_failing);
+                }
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Validates a decoded message
+         * @param record The values (decoded with the plan of the validator)
+         * @param failing (output) The bitmap of failing fields, num_words() words
+         * @param num_failing (output) The number of failing fields
+         * @return ParserError (ParserError_None: SUCCESS, whether the message is valid or not)
+         */
+        ParserError MessageValidator::validate(const MessageRecord& record, uint64_t* failing, size_t& num_failing) const
+        {
+            num_failing = 0;
+            if (NULL == plan_ || NULL == failing)
+            {
+                return ParserError_NullParameter;
+            }
+            if (record.plan() != plan_)
+            {
+                return ParserError_InvalidLayout;
+            }
+            memset(failing, 0, num_words_ * sizeof(uint64_t));
+            const MessagePlan::FieldOperationVector& operations = plan_->operations();
+            for (size_t check_idx = 0; check_idx < checks_.size(); ++check_idx)
+            {
+                const Check& check = checks_[check_idx];
+                const FieldOperation& operation = operations[check.field_idx];
+                if (!passes(check, MessagePlan::container_value(operation, MessagePlan::load_value(record.value(check.field_idx), check.data_length))))
+                {
+                    mark(check.field_idx, failing, num_failing);
+                }
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Validates a batch of decoded messages, check by check over the columns
+         * @param batch The batch (decoded with the plan of the validator)
+         * @param failing (output) The bitmaps of failing fields, one per row (row i at word i * num_words())
+         * @param num_failing (output) The number of failing rows
+         * @return ParserError (ParserError_None: SUCCESS, whether the messages are valid or not)
+         */
+        ParserError MessageValidator::validate(const ColumnBatch& batch, uint64_t* failing, size_t& num_failing) const
+        {
+            num_failing = 0;
+            if (NULL == plan_ || NULL == failing)
+            {
+                return ParserError_NullParameter;
+            }
+            if (batch.num_columns() != plan_->operations().size())
+            {
+                return ParserError_InvalidLayout;
+            }
+            const size_t num_rows = batch.size();
+            memset(failing, 0, num_rows * num_words_ * sizeof(uint64_t));
+            for (size_t check_idx = 0; check_idx < checks_.size(); ++check_idx)
+            {
+                const Check& check = checks_[check_idx];
+                const uint8_t* column = batch.column(check.field_idx);
+                switch (check.data_length)
+                {
+                    case sizeof(uint8_t)  : (check.is_signed) ? check_column(check, (const int8_t*) column, num_rows, failing)  : check_column(check, (const uint8_t*) column, num_rows, failing);  break;
+                    case sizeof(uint16_t) : (check.is_signed) ? check_column(check, (const int16_t*) column, num_rows, failing) : check_column(check, (const uint16_t*) column, num_rows, failing); break;
+                    case sizeof(uint32_t) : (check.is_signed) ? check_column(check, (const int32_t*) column, num_rows, failing) : check_column(check, (const uint32_t*) column, num_rows, failing); break;
+                    default:
+                        return ParserError_InvalidDataType;
+                }
+            }
+            for (size_t row = 0; row < num_rows; ++row)
+            {
+                const uint64_t* row_failing = failing + row * num_words_;
+                num_failing += (row_failing + num_words_ != std::find_if(row_failing, row_failing + num_words_, [] (const uint64_t& word) { return 0 != word; }));
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Runs a check on a value
+         * @param check The check
+         * @param value The value (sign extended)
+         * @return true if the value passes
+         */
+        bool MessageValidator::passes(const Check& check, const int64_t& value) const
+        {
+            switch (check.kind)
+            {
+                case RuleKind_Range         : return value >= check.min && value <= check.max;
+                case RuleKind_NonZero       : return 0 != value;
+                case RuleKind_ReservedZero  : return 0 == (((uint64_t) value) & check.mask);
+                case RuleKind_EnumSet       :
+                    if (NO_BITMAP == check.allowed)
+                    {
+                        return NULL != check.enum_table->find((int) value);
+                    }
+                    if (value < check.min || value > check.max)
+                    {
+                        return false;
+                    }
+                    return 0 != (allowed_[check.allowed + (size_t) (value - check.min) / 64] & (((uint64_t) 1) << ((size_t) (value - check.min) % 64)));
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * Flags a failing field
+         * @param field_idx The field index
+         * @param failing (output) The bitmap of failing fields
+         * @param num_failing (output) The number of failing fields, incremented the first time
+         */
+        void MessageValidator::mark(const size_t& field_idx, uint64_t* failing, size_t& num_failing) const
+        {
+            const uint64_t field_mask = ((uint64_t) 1) << (field_idx % 64);
+            if (0 == (failing[field_idx / 64] & field_mask))
+            {
+                failing[field_idx / 64] |= field_mask;
+                ++num_failing;
+            }
+        }
+
+        /**
+         * Runs a check over a column, 64 rows at a time: the compares produce a byte mask (vectorized) that
+         * is packed onto a row mask (movemask with SSE2) and scattered onto the row bitmaps
+         * @tparam T The value type of the column
+         * @param check The check
+         * @param column The column
+         * @param num_rows The number of rows
+         * @param failing (output) The bitmaps of failing fields, one per row
+         */
+        template <typename T>
+        void MessageValidator::check_column(const Check& check, const T* column, const size_t& num_rows, uint64_t* failing) const
+        {
+            //-Bounds within the value type (an empty range fails every row)
+            const int64_t type_min = (int64_t) std::numeric_limits<T>::min();
+            const int64_t type_max = (int64_t) std::numeric_limits<T>::max();
+            const bool empty_range = (check.min > type_max || check.max < type_min || check.min > check.max);
+            const T low = (T) std::max(check.min, type_min);
+            const T high = (T) std::min(check.max, type_max);
+            const T mask = (T) check.mask;
+            const uint64_t field_mask = ((uint64_t) 1) << (check.field_idx % 64);
+            const size_t field_word = check.field_idx / 64;
+
+            uint8_t bad[64];
+            for (size_t base = 0; base < num_rows; base += 64)
+            {
+                const size_t count = std::min((size_t) 64, num_rows - base);
+                const T* values = column + base;
+                switch (check.kind)
+                {
+                    case RuleKind_Range:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            bad[i] = (uint8_t) -(uint8_t) (empty_range | (values[i] < low) | (values[i] > high));
+                        }
+                        break;
+                    case RuleKind_NonZero:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            bad[i] = (uint8_t) -(uint8_t) (0 == values[i]);
+                        }
+                        break;
+                    case RuleKind_ReservedZero:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            bad[i] = (uint8_t) -(uint8_t) (0 != (T) (values[i] & mask));
+                        }
+                        break;
+                    default:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            bad[i] = (uint8_t) -(uint8_t) !passes(check, (int64_t) values[i]);
+                        }
+                        break;
+                }
+                memset(bad + count, 0, sizeof(bad) - count);
+
+                //-Pack onto a row mask
+                uint64_t rows = 0;
+                #if defined(__SSE2__)
+                for (size_t i = 0; i < sizeof(bad); i += sizeof(__m128i))
+                {
+                    rows |= ((uint64_t) (uint16_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (bad + i)))) << i;
+                }
+                #else
+                for (size_t i = 0; i < sizeof(bad); ++i)
+                {
+                    rows |= ((uint64_t) (bad[i] & 0x01)) << i;
+                }
+                #endif
+
+                while (0 != rows)
+                {
+                    const size_t row = base + bit::count_trailing_zeros(rows);
+                    rows &= rows - 1;
+                    failing[row * num_words_ + field_word] |= field_mask;
+                }
+            }
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_MESSAGE_VALIDATOR_H*/
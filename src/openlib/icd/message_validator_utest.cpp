@@ -0,0 +1,180 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "message_validator.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const char* VALIDATOR_ICD =
+	"field id      uint8   0 0 8  BE\n"
+	"    rule nonzero\n"
+	"field count   int16   1 0 16 LE\n"
+	"    rule range -100 100\n"
+	"field flags   uint8   3 0 8  BE\n"
+	"    rule reserved 0xF0\n"
+	"field mode    enum    4 0 4  BE\n"
+	"    enum 0 IDLE\n"
+	"    enum 1 RUN\n"
+	"    enum 9 STOP\n"
+	"    enum 15 FAULT\n"
+	"    rule enum\n"
+	"field wide    uint32  5 0 32 BE\n"
+	"    rule range 10 0x7FFFFFFF\n"
+	"    rule nonzero\n"
+	"field name    ascii   9 0 16 BE\n";
+static const size_t VALIDATOR_MESSAGES = 300;
+static const size_t VALIDATOR_LENGTH = 11;
+
+TEST_GROUP(message_validator)
+{
+	MessageICD message;
+	MessageValidator validator;
+
+	void setup()
+	{
+		TextICDParser parser;
+		CHECK_EQUAL(ParserError_None, parser.parse(string(VALIDATOR_ICD), message));
+		CHECK_EQUAL(ParserError_None, message.compile());
+		CHECK_EQUAL(ParserError_None, validator.compile(message.plan()));
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(message_validator, Test_message)
+{
+	CHECK_EQUAL(6u, validator.num_checks());
+	CHECK_EQUAL(1u, validator.num_words());
+
+	//-id 1, count 100, flags 0x0F, mode RUN, wide 10
+	uint8_t buffer[VALIDATOR_LENGTH] = {1, 100, 0, 0x0F, 0x10, 0, 0, 0, 10, 'a', 'b'};
+	uint64_t failing = 0;
+	size_t num_failing = 0;
+	CHECK_EQUAL(ParserError_None, validator.validate(buffer, sizeof(buffer), &failing, num_failing));
+	CHECK_EQUAL(0u, num_failing);
+	CHECK_EQUAL(0u, failing);
+
+	//-id 0, count 101, flags 0x1F, mode 2, wide 0 (fails both rules, counted once)
+	uint8_t invalid[VALIDATOR_LENGTH] = {0, 101, 0, 0x1F, 0x20, 0, 0, 0, 0, 'a', 'b'};
+	CHECK_EQUAL(ParserError_None, validator.validate(invalid, sizeof(invalid), &failing, num_failing));
+	CHECK_EQUAL(5u, num_failing);
+	CHECK_EQUAL(0x1Fu, failing);
+
+	//-Signed values: count -100 passes. Enumerations with the top bit set (zero extended): mode FAULT
+	//-(0xF, 4 bits) and STOP (0x9) pass
+	uint8_t negative[VALIDATOR_LENGTH] = {1, 0x9C, 0xFF, 0, 0xF0, 0, 0, 0, 10, 'a', 'b'};
+	CHECK_EQUAL(ParserError_None, validator.validate(negative, sizeof(negative), &failing, num_failing));
+	CHECK_EQUAL(0u, failing);
+	uint8_t stop[VALIDATOR_LENGTH] = {1, 0, 0, 0, 0x90, 0, 0, 0, 10, 'a', 'b'};
+	CHECK_EQUAL(ParserError_None, validator.validate(stop, sizeof(stop), &failing, num_failing));
+	CHECK_EQUAL(0u, failing);
+	ColumnBatch batch;
+	batch.reserve(message.plan(), 2);
+	uint8_t rows[2 * VALIDATOR_LENGTH];
+	memcpy(rows, negative, VALIDATOR_LENGTH);
+	memcpy(rows + VALIDATOR_LENGTH, stop, VALIDATOR_LENGTH);
+	CHECK_EQUAL(ParserError_None, batch.decode(rows, VALIDATOR_LENGTH, 2));
+	uint64_t batch_failing[2] = {1, 1};
+	CHECK_EQUAL(ParserError_None, validator.validate(batch, batch_failing, num_failing));
+	CHECK_EQUAL(0u, num_failing);
+	CHECK_EQUAL(0u, batch_failing[0] | batch_failing[1]);
+
+	//-Decoded values
+	MessageRecord record(message);
+	CHECK_EQUAL(ParserError_None, record.decode(invalid, sizeof(invalid)));
+	CHECK_EQUAL(ParserError_None, validator.validate(record, &failing, num_failing));
+	CHECK_EQUAL(5u, num_failing);
+	CHECK_EQUAL(0x1Fu, failing);
+	CHECK_EQUAL(ParserError_None, record.decode(negative, sizeof(negative)));
+	CHECK_EQUAL(ParserError_None, validator.validate(record, &failing, num_failing));
+	CHECK_EQUAL(0u, failing);
+}
+
+TEST(message_validator, Test_batch)
+{
+	srand(23);
+	vector<uint8_t> buffers(VALIDATOR_MESSAGES * VALIDATOR_LENGTH);
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		buffers[i] = (uint8_t) (((rand() % 4) == 0) ? 0 : (rand() % 8));
+	}
+	ColumnBatch batch;
+	batch.reserve(message.plan(), VALIDATOR_MESSAGES);
+	CHECK_EQUAL(ParserError_None, batch.decode(buffers.data(), VALIDATOR_LENGTH, VALIDATOR_MESSAGES));
+
+	vector<uint64_t> failing(VALIDATOR_MESSAGES * validator.num_words());
+	size_t num_failing = 0;
+	CHECK_EQUAL(ParserError_None, validator.validate(batch, failing.data(), num_failing));
+
+	//-Same result as message by message
+	size_t expected_failing = 0;
+	for (size_t row = 0; row < VALIDATOR_MESSAGES; ++row)
+	{
+		uint64_t row_failing = 0;
+		size_t row_num_failing = 0;
+		CHECK_EQUAL(ParserError_None, validator.validate(&buffers[row * VALIDATOR_LENGTH], VALIDATOR_LENGTH, &row_failing, row_num_failing));
+		CHECK_EQUAL(row_failing, failing[row]);
+		expected_failing += (0 != row_failing);
+	}
+	CHECK_EQUAL(expected_failing, num_failing);
+	CHECK(num_failing > 0 && num_failing < VALIDATOR_MESSAGES);
+}
+
+TEST(message_validator, Test_errors)
+{
+	uint64_t failing = 0;
+	size_t num_failing = 0;
+	uint8_t buffer[VALIDATOR_LENGTH] = {0};
+	CHECK_EQUAL(ParserError_NotEnoughData, validator.validate(buffer, VALIDATOR_LENGTH - 1, &failing, num_failing));
+	CHECK_EQUAL(ParserError_NullParameter, validator.validate(buffer, VALIDATOR_LENGTH, NULL, num_failing));
+	ColumnBatch empty;
+	CHECK_EQUAL(ParserError_InvalidLayout, validator.validate(empty, &failing, num_failing));
+	MessageRecord record;
+	CHECK_EQUAL(ParserError_InvalidLayout, validator.validate(record, &failing, num_failing));
+
+	//-Rules on byte arrays
+	message.field(message.find("name"))->add_rule(ValidationRule::non_zero());
+	CHECK_EQUAL(ParserError_InvalidDataType, validator.compile(message.plan()));
+	CHECK_EQUAL(0u, validator.num_checks());
+	CHECK_EQUAL(ParserError_NullParameter, validator.validate(buffer, VALIDATOR_LENGTH, &failing, num_failing));
+
+	//-Parser
+	MessageICD other;
+	TextICDParser parser;
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("rule nonzero\n"), other));
+	CHECK_EQUAL(ParserError_InvalidDataType, parser.parse(string("field a ascii 0 0 8 BE\nrule nonzero\n"), other));
+	CHECK_EQUAL(ParserError_InvalidNumber, parser.parse(string("field a uint8 0 0 8 BE\nrule range 5 1\n"), other));
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("field a uint8 0 0 8 BE\nrule enum\n"), other));
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("field a uint8 0 0 8 BE\nrule odd\n"), other));
+}
@@ -0,0 +1,182 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_MESSAGE_VIEW_H
+#define OPENLIB_ICD_MESSAGE_VIEW_H
+
+//-Supporting libraries
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/enum/parser_error.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Lazy, zero-copy view of a message on the wire: fields are extracted on demand straight from the
+         * buffer, no intermediate storage, no allocation. The view does not own the buffer nor the layout,
+         * both must outlive it (the MessageICD must be compiled @see MessageICD::compile)
+         * Field indexes follow the offset order of the layout (@see MessagePlan::index_of)
+         */
+        class MessageView
+        {
+            public:
+                //-Constructor
+                MessageView() : buffer_(NULL), buffer_length_(0), plan_(NULL) {};
+                MessageView(const uint8_t* buffer, const size_t& buffer_length, const MessageICD& icd_message) :
+                    buffer_(buffer), buffer_length_(buffer_length), plan_(&icd_message.plan()) {};
+                MessageView(const uint8_t* buffer, const size_t& buffer_length, const MessagePlan& plan) :
+                    buffer_(buffer), buffer_length_(buffer_length), plan_(&plan) {};
+
+                //-Accessor
+                inline const uint8_t* buffer() const            { return buffer_;           }
+                inline const size_t& buffer_length() const      { return buffer_length_;    }
+                inline const MessagePlan* plan() const          { return plan_;             }
+
+                //-Ancillary functions
+                inline bool valid() const;
+                inline size_t size() const;
+                template <typename T> inline T get(const size_t& field_idx) const;
+                template <typename T> inline ParserError get(const size_t& field_idx, T& value) const;
+                inline const uint8_t* bytes(const size_t& field_idx) const;
+                inline ParserError copy_bytes(const size_t& field_idx, void* output, const size_t& output_length) const;
+
+            private:
+                //-Fields
+                const uint8_t*      buffer_;
+                size_t              buffer_length_;
+                const MessagePlan*  plan_;
+
+        }; /*class MessageView*/
+
+        /**
+         * Whether the view holds a buffer long enough for its layout
+         * @return true if the fields can be accessed
+         */
+        bool MessageView::valid() const
+        {
+            return NULL != buffer_ && NULL != plan_ && buffer_length_ >= plan_->min_buffer_length();
+        }
+
+        /**
+         * Number of fields of the layout
+         * @return size_t containing the number of fields
+         */
+        size_t MessageView::size() const
+        {
+            return (NULL == plan_) ? 0 : plan_->operations().size();
+        }
+
+        /**
+         * Extracts an integral field, widened as its value type (signed fields are sign extended onto wider types)
+         * IMPORTANT: NO CHECKS!!!!!!!! the view must be valid() and the field integral
+         * @tparam T The value type (integral type)
+         * @param field_idx The field index
+         * @return T containing the value
+         */
+        template <typename T>
+        T MessageView::get(const size_t& field_idx) const
+        {
+            const FieldOperation& operation = plan_->operations()[field_idx];
+            return (T) MessagePlan::container_value(operation, MessagePlan::decode_field(operation, buffer_, buffer_length_));
+        }
+
+        /**
+         * Extracts an integral field, widened as its value type (signed fields are sign extended onto wider types)
+         * @tparam T The value type (integral type), at least as wide as the value of the field
+         * @param field_idx The field index
+         * @param value (output) The value
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        template <typename T>
+        ParserError MessageView::get(const size_t& field_idx, T& value) const
+        {
+            if (!valid())
+            {
+                return (NULL == buffer_ || NULL == plan_) ? ParserError_NullParameter : ParserError_NotEnoughData;
+            }
+            if (field_idx >= size() || FieldOperationKind_Integer != plan_->operations()[field_idx].kind)
+            {
+                return ParserError_InvalidDataType;
+            }
+            if (sizeof(T) < plan_->operations()[field_idx].data_length)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            value = get<T>(field_idx);
+            return ParserError_None;
+        }
+
+        /**
+         * Direct access to a byte aligned byte array field (zero-copy)
+         * @param field_idx The field index
+         * @return The pointer within the buffer, NULL if the view is not valid or the field is not a byte aligned array
+         */
+        const uint8_t* MessageView::bytes(const size_t& field_idx) const
+        {
+            if (!valid() || field_idx >= size())
+            {
+                return NULL;
+            }
+            const FieldOperation& operation = plan_->operations()[field_idx];
+            if (FieldOperationKind_Bytes != operation.kind || 0 != operation.bit_offset)
+            {
+                return NULL;
+            }
+            return buffer_ + operation.byte_index;
+        }
+
+        /**
+         * Copies a byte array field (any bit offset)
+         * @param field_idx The field index
+         * @param output The output buffer
+         * @param output_length The length of the output buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError MessageView::copy_bytes(const size_t& field_idx, void* output, const size_t& output_length) const
+        {
+            if (!valid() || NULL == output)
+            {
+                return (NULL == buffer_ || NULL == plan_ || NULL == output) ? ParserError_NullParameter : ParserError_NotEnoughData;
+            }
+            if (field_idx >= size() || FieldOperationKind_Bytes != plan_->operations()[field_idx].kind)
+            {
+                return ParserError_InvalidDataType;
+            }
+            if (output_length < plan_->operations()[field_idx].data_length)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            MessagePlan::decode_bytes(plan_->operations()[field_idx], buffer_, buffer_length_, (uint8_t*) output);
+            return ParserError_None;
+        }
+
+        static_assert(std::is_trivially_copyable<MessageView>::value, "MessageView must be trivially copyable");
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_MESSAGE_VIEW_H*/
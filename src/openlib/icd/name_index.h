@@ -0,0 +1,161 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_NAME_INDEX_H
+#define OPENLIB_ICD_NAME_INDEX_H
+
+//-Supporting libraries
+#include "openlib/icd/message_plan.h"
+#include "openlib/utils/string_fnc.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Field name index: open addressing (linear probing) hash table over the names of the fields of a
+         * compiled plan. Names are not copied, the table points to the data descriptor names.
+         * Lookups return the field index (offset order), a stable handle while the plan is not recompiled
+         */
+        class NameIndex
+        {
+            public:
+                static constexpr size_t NOT_FOUND = (size_t) -1;
+
+                //-Constructor & Destructor
+                NameIndex() : mask_(0) {};
+                ~NameIndex() {};
+
+                //-Ancillary functions
+                inline void build(const MessagePlan& plan);
+                inline void clear();
+                inline size_t find(const char* name, const size_t& name_length) const;
+                inline size_t find(const std::string& name) const   { return find(name.data(), name.length()); }
+                static inline uint64_t hash(const char* name, const size_t& name_length);
+
+            private:
+                /**
+                 * Table slot
+                 */
+                struct Entry
+                {
+                    uint64_t    hash;
+                    const char* name;           //-NULL: empty slot
+                    size_t      name_length;
+                    size_t      field_idx;
+                };
+
+                //-Fields
+                std::vector<Entry>  entries_;
+                size_t              mask_;
+
+        }; /*class NameIndex*/
+
+        /**
+         * Builds the index over the fields of a plan (the first field wins on duplicated names)
+         * @param plan The compiled plan
+         */
+        void NameIndex::build(const MessagePlan& plan)
+        {
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+
+            //-Power of 2 capacity, load factor <= 0.5
+            size_t capacity = 2;
+            while (capacity < 2 * operations.size())
+            {
+                capacity <<= 1;
+            }
+            Entry empty = {0, NULL, 0, NOT_FOUND};
+            entries_.assign(capacity, empty);
+            mask_ = capacity - 1;
+
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                //-Single hash per name, the probe stops on the first free slot or on the same name
+                const std::string& name = operations[field_idx].descriptor->name();
+                const Entry entry = {hash(name.data(), name.length()), name.data(), name.length(), field_idx};
+                size_t slot = entry.hash & mask_;
+                while (NULL != entries_[slot].name && !(entries_[slot].hash == entry.hash && entries_[slot].name_length == entry.name_length &&
+                                                         0 == memcmp(entries_[slot].name, entry.name, entry.name_length)))
+                {
+                    slot = (slot + 1) & mask_;
+                }
+                if (NULL == entries_[slot].name)
+                {
+                    entries_[slot] = entry;
+                }
+            }
+        }
+
+        /**
+         * Clears the index
+         */
+        void NameIndex::clear()
+        {
+            entries_.clear();
+            mask_ = 0;
+        }
+
+        /**
+         * Finds a field by name
+         * @param name The field name (not necessarily null terminated)
+         * @param name_length The length of the name
+         * @return size_t containing the field index, NOT_FOUND if not found
+         */
+        size_t NameIndex::find(const char* name, const size_t& name_length) const
+        {
+            if (entries_.empty() || NULL == name)
+            {
+                return NOT_FOUND;
+            }
+            const uint64_t name_hash = hash(name, name_length);
+            for (size_t slot = name_hash & mask_; NULL != entries_[slot].name; slot = (slot + 1) & mask_)
+            {
+                const Entry& entry = entries_[slot];
+                if (entry.hash == name_hash && entry.name_length == name_length && 0 == memcmp(entry.name, name, name_length))
+                {
+                    return entry.field_idx;
+                }
+            }
+            return NOT_FOUND;
+        }
+
+        /**
+         * Hashes a name (FNV-1a 64 bits)
+         * @param name The name
+         * @param name_length The length of the name
+         * @return uint64_t containing the hash
+         */
+        uint64_t NameIndex::hash(const char* name, const size_t& name_length)
+        {
+            return string_fnc::hash(name, name_length);
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_NAME_INDEX_H*/
@@ -0,0 +1,234 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_PARALLEL_DECODER_H
+#define OPENLIB_ICD_PARALLEL_DECODER_H
+
+//-Supporting libraries
+#include "openlib/icd/column_batch.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/thread-pool/thread_pool.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Parallel batch decode of large captures: the messages are split in chunks of consecutive rows
+         * decoded by the threads of a pool onto disjoint row ranges of the same columns, so the output
+         * keeps the capture order without any merge step
+         * The compiled plan is shared read only by all the threads (the decode kernels do not touch the
+         * values of the descriptors), each chunk writes its own rows only
+         */
+        class ParallelDecoder
+        {
+            public:
+                //-Constructor & Destructor
+                inline explicit ParallelDecoder(ThreadPool& pool, const size_t& chunk_length = 16384);
+                ~ParallelDecoder() {};
+
+                //-Accessor
+                inline size_t chunk_length() const          { return chunk_length_; }
+
+                //-Ancillary functions
+                inline ParserError decode(const MessagePlan& plan, const uint8_t* buffer, const size_t& stride, const size_t& num_messages, uint8_t* const* columns) const;
+                inline ParserError decode(const MessagePlan& plan, const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, uint8_t* const* columns) const;
+                inline ParserError decode(const uint8_t* buffer, const size_t& stride, const size_t& num_messages, ColumnBatch& batch) const;
+                inline ParserError decode(const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, ColumnBatch& batch) const;
+
+            private:
+                template <typename ChunkDecoder>
+                inline ParserError run(const MessagePlan& plan, const size_t& num_messages, uint8_t* const* columns, const ChunkDecoder& chunk_decoder) const;
+
+                //-Fields
+                ThreadPool& pool_;
+                size_t      chunk_length_;  //-Messages per chunk
+
+        }; /*class ParallelDecoder*/
+
+        /**
+         * Constructor
+         * @param pool The pool running the chunks (must outlive the decoder)
+         * @param chunk_length The number of messages per chunk (big enough to amortize the scheduling,
+         *                     small enough for the stealing to balance the load)
+         */
+        ParallelDecoder::ParallelDecoder(ThreadPool& pool, const size_t& chunk_length) :
+            pool_(pool),
+            chunk_length_((0 == chunk_length) ? 1 : chunk_length)
+        {
+        }
+
+        /**
+         * Decodes messages back to back on a buffer onto columns
+         * @param plan The compiled plan
+         * @param buffer The first message
+         * @param stride The distance between messages (>= plan min_buffer_length)
+         * @param num_messages The number of messages
+         * @param columns The columns, one per field of the plan with room for 'num_messages' rows
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ParallelDecoder::decode(const MessagePlan& plan, const uint8_t* buffer, const size_t& stride, const size_t& num_messages, uint8_t* const* columns) const
+        {
+            if (NULL == buffer || NULL == columns)
+            {
+                return ParserError_NullParameter;
+            }
+            return run(plan, num_messages, columns,
+                [&plan, buffer, stride] (const size_t& begin, const size_t& count, uint8_t* const* chunk_columns)
+                {
+                    return ColumnBatch::decode(plan, buffer + begin * stride, stride, count, chunk_columns);
+                });
+        }
+
+        /**
+         * Decodes messages on their own buffers onto columns
+         * @param plan The compiled plan
+         * @param buffers The messages
+         * @param buffer_length The length of every message buffer (>= plan min_buffer_length)
+         * @param num_messages The number of messages
+         * @param columns The columns, one per field of the plan with room for 'num_messages' rows
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ParallelDecoder::decode(const MessagePlan& plan, const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, uint8_t* const* columns) const
+        {
+            if (NULL == buffers || NULL == columns)
+            {
+                return ParserError_NullParameter;
+            }
+            return run(plan, num_messages, columns,
+                [&plan, buffers, buffer_length] (const size_t& begin, const size_t& count, uint8_t* const* chunk_columns)
+                {
+                    return ColumnBatch::decode(plan, buffers + begin, buffer_length, count, chunk_columns);
+                });
+        }
+
+        /**
+         * Decodes messages back to back on a buffer onto the columns of a batch
+         * @param buffer The first message
+         * @param stride The distance between messages (>= plan min_buffer_length)
+         * @param num_messages The number of messages (<= batch capacity)
+         * @param batch The batch (@see ColumnBatch::reserve)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ParallelDecoder::decode(const uint8_t* buffer, const size_t& stride, const size_t& num_messages, ColumnBatch& batch) const
+        {
+            batch.size_ = 0;
+            if (NULL == batch.plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            if (num_messages > batch.capacity_)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            const ParserError error = decode(*batch.plan_, buffer, stride, num_messages, batch.columns_.data());
+            if (ParserError_None == error)
+            {
+                batch.size_ = num_messages;
+            }
+            return error;
+        }
+
+        /**
+         * Decodes messages on their own buffers onto the columns of a batch
+         * @param buffers The messages
+         * @param buffer_length The length of every message buffer (>= plan min_buffer_length)
+         * @param num_messages The number of messages (<= batch capacity)
+         * @param batch The batch (@see ColumnBatch::reserve)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError ParallelDecoder::decode(const uint8_t* const* buffers, const size_t& buffer_length, const size_t& num_messages, ColumnBatch& batch) const
+        {
+            batch.size_ = 0;
+            if (NULL == batch.plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            if (num_messages > batch.capacity_)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            const ParserError error = decode(*batch.plan_, buffers, buffer_length, num_messages, batch.columns_.data());
+            if (ParserError_None == error)
+            {
+                batch.size_ = num_messages;
+            }
+            return error;
+        }
+
+        /**
+         * Splits the messages in chunks and runs them on the pool
+         * @param plan The compiled plan
+         * @param num_messages The number of messages
+         * @param columns The columns
+         * @param chunk_decoder The chunk decode (first row, number of rows, columns at the first row)
+         * @return ParserError (the error of the first failed chunk, ParserError_None: SUCCESS)
+         */
+        template <typename ChunkDecoder>
+        ParserError ParallelDecoder::run(const MessagePlan& plan, const size_t& num_messages, uint8_t* const* columns, const ChunkDecoder& chunk_decoder) const
+        {
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+            const size_t num_fields = operations.size();
+            const size_t num_chunks = (num_messages + chunk_length_ - 1) / chunk_length_;
+            if (0 == num_chunks)
+            {
+                return ParserError_None;
+            }
+
+            //-Column pointers of every chunk, laid out up front (no allocation on the threads)
+            std::vector<uint8_t*> chunk_columns(num_chunks * num_fields);
+            for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+            {
+                for (size_t field_idx = 0; field_idx < num_fields; ++field_idx)
+                {
+                    chunk_columns[chunk_idx * num_fields + field_idx] = columns[field_idx] + chunk_idx * chunk_length_ * operations[field_idx].data_length;
+                }
+            }
+
+            std::vector<ParserError> errors(num_chunks, ParserError_None);
+            const size_t chunk_length = chunk_length_;
+            pool_.run(num_chunks,
+                [&] (const size_t& chunk_idx)
+                {
+                    const size_t begin = chunk_idx * chunk_length;
+                    const size_t count = std::min(chunk_length, num_messages - begin);
+                    errors[chunk_idx] = chunk_decoder(begin, count, chunk_columns.data() + chunk_idx * num_fields);
+                });
+
+            for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+            {
+                if (ParserError_None != errors[chunk_idx])
+                {
+                    return errors[chunk_idx];
+                }
+            }
+            return ParserError_None;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_PARALLEL_DECODER_H*/
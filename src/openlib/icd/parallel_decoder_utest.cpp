@@ -0,0 +1,96 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "parallel_decoder.h"
+#include "column_batch.h"
+#include "decode_fixture_utest.h"
+#include <stdint.h>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const size_t PARALLEL_MESSAGES = 1001;
+
+TEST_GROUP(parallel_decoder)
+{
+	DecodeFixture fixture;
+
+	void setup()
+	{
+		fixture.setup(PARALLEL_MESSAGES, 5);
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(parallel_decoder, Test_strided)
+{
+	ThreadPool pool(4);
+	const size_t chunk_lengths[] = {1, 7, 64, 1000, 5000};
+	for (size_t i = 0; i < sizeof(chunk_lengths) / sizeof(chunk_lengths[0]); ++i)
+	{
+		ParallelDecoder decoder(pool, chunk_lengths[i]);
+		ColumnBatch batch;
+		batch.reserve(fixture.message.plan(), PARALLEL_MESSAGES);
+		CHECK_EQUAL(ParserError_None, decoder.decode(fixture.buffers.data(), FIXTURE_LENGTH, PARALLEL_MESSAGES, batch));
+		fixture.check_columns(batch);
+	}
+}
+
+TEST(parallel_decoder, Test_pointers)
+{
+	ThreadPool pool(3);
+	ParallelDecoder decoder(pool, 50);
+	vector<const uint8_t*> rows(PARALLEL_MESSAGES);
+	for (size_t row = 0; row < PARALLEL_MESSAGES; ++row)
+	{
+		rows[row] = fixture.frame(row);
+	}
+	ColumnBatch batch;
+	batch.reserve(fixture.message.plan(), PARALLEL_MESSAGES);
+	CHECK_EQUAL(ParserError_None, decoder.decode(rows.data(), FIXTURE_LENGTH, PARALLEL_MESSAGES, batch));
+	fixture.check_columns(batch);
+}
+
+TEST(parallel_decoder, Test_errors)
+{
+	ThreadPool pool(2);
+	ParallelDecoder decoder(pool, 10);
+	ColumnBatch batch;
+	CHECK_EQUAL(ParserError_NullParameter, decoder.decode(fixture.buffers.data(), FIXTURE_LENGTH, 1, batch));
+	batch.reserve(fixture.message.plan(), 100);
+	CHECK_EQUAL(ParserError_ContainerTooSmall, decoder.decode(fixture.buffers.data(), FIXTURE_LENGTH, 101, batch));
+	CHECK_EQUAL(ParserError_NotEnoughData, decoder.decode(fixture.buffers.data(), FIXTURE_LENGTH - 1, 100, batch));
+
+	//-A bad row on a late chunk fails the whole decode
+	vector<const uint8_t*> rows(100, fixture.buffers.data());
+	rows[95] = NULL;
+	CHECK_EQUAL(ParserError_NullParameter, decoder.decode(rows.data(), FIXTURE_LENGTH, 100, batch));
+	CHECK_EQUAL(0u, batch.size());
+	CHECK_EQUAL(ParserError_None, decoder.decode(fixture.buffers.data(), FIXTURE_LENGTH, 0, batch));
+}
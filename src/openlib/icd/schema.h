@@ -0,0 +1,383 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_SCHEMA_H
+#define OPENLIB_ICD_SCHEMA_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/enum/endianess.h"
+#include "openlib/icd/enum/data_type.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/struct/schema_format.h"
+#include "openlib/utils/mapped_file.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Read only view of a binary schema (@see SchemaWriter), the entries are used in place: opening
+         * only validates the bounds of the tables, nothing is parsed nor allocated
+         */
+        class Schema : public NonCopyable
+        {
+            public:
+                //-Constructor & Destructor
+                Schema() : header_(NULL), messages_(NULL), fields_(NULL), enums_(NULL), strings_(NULL) {};
+                virtual ~Schema() { close(); };
+
+                //-Accessor
+                inline bool is_open() const                 { return NULL != header_; }
+                inline uint32_t num_messages() const        { return (NULL == header_) ? 0 : header_->num_messages; }
+                inline const SchemaMessage* message(const size_t& message_idx) const;
+                inline const SchemaMessage* find(const char* name) const;
+                inline const SchemaField* field(const SchemaMessage& message, const size_t& field_idx) const;
+                inline const SchemaField* find(const SchemaMessage& message, const char* name) const;
+                inline const char* name(const SchemaMessage& message) const  { return strings_ + message.name_offset; }
+                inline const char* name(const SchemaField& field) const      { return strings_ + field.name_offset;   }
+                inline const char* label(const SchemaField& field, const int& value) const;
+
+                //-Ancillary functions
+                inline ParserError open(const void* data, const size_t& data_length);
+                inline ParserError open_file(const std::string& path);
+                inline void close();
+                inline ParserError decode(const SchemaField& field, const uint8_t* buffer, const size_t& buffer_length, int64_t& value) const;
+
+            protected:
+                //-Functions
+                inline ParserError bind(const void* data, const size_t& data_length);
+                inline bool is_string(const uint32_t& offset, const uint32_t& length) const;
+                static inline bool is_table(const SchemaHeader& header, const uint64_t& offset, const uint64_t& table_length);
+
+                //-Fields
+                utils::MappedFile       file_;      //-Backing file (@see open_file)
+                const SchemaHeader*     header_;
+                const SchemaMessage*    messages_;
+                const SchemaField*      fields_;
+                const SchemaEnum*       enums_;
+                const char*             strings_;
+
+        }; /*class Schema*/
+
+        /**
+         * Uses a binary schema in place, the data must outlive the schema (or the next open/close)
+         * @param data The binary schema (8 bytes aligned)
+         * @param data_length The length of the binary schema
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError Schema::open(const void* data, const size_t& data_length)
+        {
+            close();
+            return bind(data, data_length);
+        }
+
+        /**
+         * Maps a binary schema file and uses it in place
+         * @param path The path to the binary schema
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError Schema::open_file(const std::string& path)
+        {
+            close();
+            if (!file_.open(path))
+            {
+                return ParserError_CannotOpen;
+            }
+            const ParserError error = bind(file_.data(), file_.length());
+            if (ParserError_None != error)
+            {
+                file_.close();
+            }
+            return error;
+        }
+
+        /**
+         * Stops using the binary schema (unmaps the file if mapped by open_file)
+         */
+        void Schema::close()
+        {
+            header_   = NULL;
+            messages_ = NULL;
+            fields_   = NULL;
+            enums_    = NULL;
+            strings_  = NULL;
+            file_.close();
+        }
+
+        /**
+         * Validates the bounds of a binary schema and points the tables at it
+         * @param data The binary schema (8 bytes aligned)
+         * @param data_length The length of the binary schema
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError Schema::bind(const void* data, const size_t& data_length)
+        {
+            if (NULL == data)
+            {
+                return ParserError_NullParameter;
+            }
+            if (data_length < sizeof(SchemaHeader))
+            {
+                return ParserError_NotEnoughData;
+            }
+            if (0 != (reinterpret_cast<uintptr_t> (data) % 8))
+            {
+                return ParserError_InvalidSchema;
+            }
+
+            //-Header
+            const SchemaHeader* header = (const SchemaHeader*) data;
+            if (0 != memcmp(header->magic, SCHEMA_MAGIC, sizeof(header->magic)) || SCHEMA_BYTE_ORDER != header->byte_order)
+            {
+                return ParserError_InvalidSchema;
+            }
+            if (SCHEMA_VERSION != header->version)
+            {
+                return ParserError_UnsupportedVersion;
+            }
+            if (header->length > data_length)
+            {
+                return ParserError_NotEnoughData;
+            }
+            if (!is_table(*header, header->messages_offset, (uint64_t) header->num_messages * sizeof(SchemaMessage)) ||
+                !is_table(*header, header->fields_offset, (uint64_t) header->num_fields * sizeof(SchemaField)) ||
+                !is_table(*header, header->enums_offset, (uint64_t) header->num_enums * sizeof(SchemaEnum)) ||
+                !is_table(*header, header->strings_offset, header->strings_length))
+            {
+                return ParserError_InvalidSchema;
+            }
+            header_   = header;
+            messages_ = (const SchemaMessage*) ((const uint8_t*) data + header->messages_offset);
+            fields_   = (const SchemaField*) ((const uint8_t*) data + header->fields_offset);
+            enums_    = (const SchemaEnum*) ((const uint8_t*) data + header->enums_offset);
+            strings_  = (const char*) data + header->strings_offset;
+
+            //-Entries (indexes and strings within bounds)
+            bool valid = true;
+            for (uint32_t message_idx = 0; valid && message_idx < header->num_messages; ++message_idx)
+            {
+                const SchemaMessage& message = messages_[message_idx];
+                valid = is_string(message.name_offset, message.name_length) &&
+                        (uint64_t) message.first_field + message.num_fields <= header->num_fields;
+            }
+            for (uint32_t field_idx = 0; valid && field_idx < header->num_fields; ++field_idx)
+            {
+                const SchemaField& field = fields_[field_idx];
+                valid = is_string(field.name_offset, field.name_length) &&
+                        field.data_type < DataType_Max && field.endianess < Endianess_Max &&
+                        field.bit_offset < 8 && field.num_bits > 0 &&
+                        (field.num_bits <= 64 || DataType_ascii == field.data_type || DataType_binary == field.data_type) &&
+                        (uint64_t) field.first_enum + field.num_enums <= header->num_enums;
+            }
+            for (uint32_t enum_idx = 0; valid && enum_idx < header->num_enums; ++enum_idx)
+            {
+                valid = is_string(enums_[enum_idx].label_offset, enums_[enum_idx].label_length);
+            }
+            if (!valid)
+            {
+                header_ = NULL;
+                return ParserError_InvalidSchema;
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Access to a message by index
+         * @param message_idx The message index
+         * @return The message, NULL if out of range
+         */
+        const SchemaMessage* Schema::message(const size_t& message_idx) const
+        {
+            if (message_idx >= num_messages())
+            {
+                return NULL;
+            }
+            return &messages_[message_idx];
+        }
+
+        /**
+         * Finds a message by name (linear)
+         * @param name The name of the message
+         * @return The message, NULL if not found
+         */
+        const SchemaMessage* Schema::find(const char* name) const
+        {
+            for (uint32_t message_idx = 0; NULL != name && message_idx < num_messages(); ++message_idx)
+            {
+                if (0 == strcmp(name, strings_ + messages_[message_idx].name_offset))
+                {
+                    return &messages_[message_idx];
+                }
+            }
+            return NULL;
+        }
+
+        /**
+         * Access to a field of a message by index (offset order)
+         * @param message The message
+         * @param field_idx The field index within the message
+         * @return The field, NULL if out of range
+         */
+        const SchemaField* Schema::field(const SchemaMessage& message, const size_t& field_idx) const
+        {
+            if (NULL == header_ || field_idx >= message.num_fields)
+            {
+                return NULL;
+            }
+            return &fields_[message.first_field + field_idx];
+        }
+
+        /**
+         * Finds a field of a message by name (linear)
+         * @param message The message
+         * @param name The name of the field
+         * @return The field, NULL if not found
+         */
+        const SchemaField* Schema::find(const SchemaMessage& message, const char* name) const
+        {
+            for (uint32_t field_idx = 0; NULL != header_ && NULL != name && field_idx < message.num_fields; ++field_idx)
+            {
+                const SchemaField& field = fields_[message.first_field + field_idx];
+                if (0 == strcmp(name, strings_ + field.name_offset))
+                {
+                    return &field;
+                }
+            }
+            return NULL;
+        }
+
+        /**
+         * Label of an enumeration value (binary search, the entries are in value order)
+         * @param field The field
+         * @param value The value
+         * @return The label, NULL if not found
+         */
+        const char* Schema::label(const SchemaField& field, const int& value) const
+        {
+            if (NULL == header_)
+            {
+                return NULL;
+            }
+            const SchemaEnum* first = enums_ + field.first_enum;
+            size_t low = 0;
+            size_t high = field.num_enums;
+            while (low < high)
+            {
+                const size_t middle = low + (high - low) / 2;
+                if (first[middle].value < value)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            if (low < field.num_enums && value == first[low].value)
+            {
+                return strings_ + first[low].label_offset;
+            }
+            return NULL;
+        }
+
+        /**
+         * Decodes an integral field of a buffer straight from the schema
+         * @param field The field
+         * @param buffer The buffer from where to decode
+         * @param buffer_length The length of the buffer
+         * @param value (output) The value, sign extended for the signed data types
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError Schema::decode(const SchemaField& field, const uint8_t* buffer, const size_t& buffer_length, int64_t& value) const
+        {
+            if (NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (BYTE2BIT((uint64_t) buffer_length) < BYTE2BIT((uint64_t) field.byte_offset) + field.bit_offset + field.num_bits)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            bool is_signed = false;
+            switch (field.data_type)
+            {
+                case DataType_int8   :
+                case DataType_int16  :
+                case DataType_int32  :
+                    is_signed = true;
+                    break;
+
+                case DataType_uint8  :
+                case DataType_uint16 :
+                case DataType_uint32 :
+                case DataType_enum   :  //-Zero extended (@see MessagePlan::add)
+                    break;
+
+                default:
+                    return ParserError_InvalidDataType;
+            }
+
+            const uint64_t raw = buffer::extract_raw(buffer, buffer_length, BYTE2BIT((size_t) field.byte_offset) + field.bit_offset, field.num_bits);
+            if (is_signed)
+            {
+                value = buffer::raw_to_value<int64_t>(raw, field.num_bits, (Endianess) field.endianess);
+            }
+            else
+            {
+                value = (int64_t) buffer::raw_to_value<uint64_t>(raw, field.num_bits, (Endianess) field.endianess);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Whether a string lies within the string pool (null terminated)
+         * @param offset The offset within the pool
+         * @param length The length of the string
+         * @return true if valid
+         */
+        bool Schema::is_string(const uint32_t& offset, const uint32_t& length) const
+        {
+            return (uint64_t) offset + length < header_->strings_length && '\0' == strings_[offset + length];
+        }
+
+        /**
+         * Whether a table lies within the file
+         * @param header The file header
+         * @param offset The offset of the table
+         * @param table_length The length of the table
+         * @return true if valid
+         */
+        bool Schema::is_table(const SchemaHeader& header, const uint64_t& offset, const uint64_t& table_length)
+        {
+            return 0 == (offset % 8) && offset >= sizeof(SchemaHeader) && offset <= header.length && table_length <= header.length - offset;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_SCHEMA_H*/
@@ -0,0 +1,201 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "schema.h"
+#include "schema_writer.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+/**
+ * Same layout as the message_icd tests
+ */
+static const char* TEST_ICD =
+	"message Test\n"
+	"    field id      uint8   0 0 8  BE\n"
+	"    field count   int16   1 0 16 LE\n"
+	"    field flags   uint8   3 0 3  BE\n"
+	"    field delta   int8    3 3 5  BE\n"
+	"    field range   uint32  4 0 20 BE\n"
+	"    field mode    enum    6 4 4  BE\n"
+	"        enum 3 RUN\n"
+	"        enum 9 FAULT\n"
+	"        enum 0 IDLE\n"
+	"    field payload binary  7 0 96 BE\n"
+	"end\n";
+
+TEST_GROUP(schema)
+{
+	MessageICD test;
+	MessageICD other;
+	vector<uint8_t> binary;
+
+	void setup()
+	{
+		TextICDParser parser;
+		CHECK_EQUAL(ParserError_None, parser.parse(string(TEST_ICD), test));
+		CHECK_EQUAL(ParserError_None, parser.parse(string("field a uint16 2 0 16 LE"), other));
+
+		SchemaWriter writer;
+		writer.add("Test", test);
+		writer.add("Other", other);
+		CHECK_EQUAL(2u, writer.size());
+		writer.write(binary);
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(schema, Test_layout)
+{
+	Schema schema;
+	CHECK_EQUAL(ParserError_None, schema.open(binary.data(), binary.size()));
+	CHECK(schema.is_open());
+	CHECK_EQUAL(2u, schema.num_messages());
+	CHECK(NULL == schema.message(2));
+	CHECK(NULL == schema.find("Unknown"));
+
+	const SchemaMessage* message = schema.find("Test");
+	CHECK(NULL != message);
+	STRCMP_EQUAL("Test", schema.name(*message));
+	CHECK_EQUAL(7u, message->num_fields);
+	CHECK_EQUAL(19u, message->min_buffer_length);
+
+	//-Same layout as the descriptors, in offset order
+	size_t field_idx = 0;
+	for (MessageICD::DataFieldSetConstIterator it = test.data_field_set().begin(); it != test.data_field_set().end(); ++it, ++field_idx)
+	{
+		const SchemaField* field = schema.field(*message, field_idx);
+		CHECK(NULL != field);
+		STRCMP_EQUAL((*it)->name().c_str(), schema.name(*field));
+		CHECK_EQUAL((*it)->byte_offset(), field->byte_offset);
+		CHECK_EQUAL((*it)->bit_offset(), field->bit_offset);
+		CHECK_EQUAL((*it)->num_bits(), field->num_bits);
+		CHECK_EQUAL((*it)->data_type(), field->data_type);
+		CHECK_EQUAL((*it)->endianess(), field->endianess);
+	}
+	CHECK(NULL == schema.field(*message, field_idx));
+
+	//-Enumeration labels
+	const SchemaField* mode = schema.find(*message, "mode");
+	CHECK(NULL != mode);
+	CHECK_EQUAL(3u, mode->num_enums);
+	STRCMP_EQUAL("FAULT", schema.label(*mode, 9));
+	STRCMP_EQUAL("IDLE", schema.label(*mode, 0));
+	STRCMP_EQUAL("RUN", schema.label(*mode, 3));
+	CHECK(NULL == schema.label(*mode, 1));
+
+	const SchemaMessage* other_message = schema.message(1);
+	STRCMP_EQUAL("Other", schema.name(*other_message));
+	STRCMP_EQUAL("a", schema.name(*schema.field(*other_message, 0)));
+	CHECK_EQUAL(4u, other_message->min_buffer_length);
+}
+
+TEST(schema, Test_decode)
+{
+	const uint8_t wire[19] = {0x7E, 0x34, 0x92, 0b10111010, 0xAB, 0xCD, 0xE9, 0xDE, 0xAD, 0xBE, 0xEF};
+	Schema schema;
+	CHECK_EQUAL(ParserError_None, schema.open(binary.data(), binary.size()));
+	const SchemaMessage& message = *schema.find("Test");
+
+	//-Same values as the message
+	CHECK_EQUAL(ParserError_None, test.decode(wire, sizeof(wire)));
+	int64_t value = 0;
+	for (size_t field_idx = 0; field_idx + 1 < message.num_fields; ++field_idx)
+	{
+		const DataDescriptor& data_descriptor = *test.field(field_idx);
+		CHECK_EQUAL(ParserError_None, schema.decode(*schema.field(message, field_idx), wire, sizeof(wire), value));
+		switch (data_descriptor.data_type())
+		{
+			case DataType_uint8  : CHECK_EQUAL(*data_descriptor.data(), value); break;
+			case DataType_int8   : CHECK_EQUAL(*(const int8_t*) data_descriptor.data(), value); break;
+			case DataType_int16  : CHECK_EQUAL(*(const int16_t*) data_descriptor.data(), value); break;
+			case DataType_uint32 : CHECK_EQUAL(*(const uint32_t*) data_descriptor.data(), value); break;
+			case DataType_enum   : CHECK_EQUAL(*(const int*) data_descriptor.data(), value); break;
+			default: FAIL("unexpected data type");
+		}
+	}
+	CHECK_EQUAL(9, value);
+
+	CHECK_EQUAL(ParserError_InvalidDataType, schema.decode(*schema.find(message, "payload"), wire, sizeof(wire), value));
+	CHECK_EQUAL(ParserError_NotEnoughData, schema.decode(*schema.find(message, "mode"), wire, 6, value));
+	CHECK_EQUAL(ParserError_NullParameter, schema.decode(*schema.find(message, "mode"), NULL, 7, value));
+}
+
+TEST(schema, Test_invalid)
+{
+	Schema schema;
+	CHECK_EQUAL(ParserError_NullParameter, schema.open(NULL, 0));
+	CHECK_EQUAL(ParserError_NotEnoughData, schema.open(binary.data(), sizeof(SchemaHeader) - 1));
+	CHECK_EQUAL(ParserError_NotEnoughData, schema.open(binary.data(), binary.size() - 1));
+	CHECK(!schema.is_open());
+
+	vector<uint8_t> corrupted(binary);
+	corrupted[0] = 'X';
+	CHECK_EQUAL(ParserError_InvalidSchema, schema.open(corrupted.data(), corrupted.size()));
+
+	corrupted = binary;
+	((SchemaHeader*) corrupted.data())->version = SCHEMA_VERSION + 1;
+	CHECK_EQUAL(ParserError_UnsupportedVersion, schema.open(corrupted.data(), corrupted.size()));
+
+	corrupted = binary;
+	((SchemaHeader*) corrupted.data())->num_fields = 1000;
+	CHECK_EQUAL(ParserError_InvalidSchema, schema.open(corrupted.data(), corrupted.size()));
+
+	corrupted = binary;
+	SchemaHeader* header = (SchemaHeader*) corrupted.data();
+	((SchemaField*) (corrupted.data() + header->fields_offset))->name_offset = header->strings_length;
+	CHECK_EQUAL(ParserError_InvalidSchema, schema.open(corrupted.data(), corrupted.size()));
+	CHECK(!schema.is_open());
+}
+
+TEST(schema, Test_file)
+{
+	char path[] = "/tmp/schema_XXXXXX";
+	FILE* file = fdopen(mkstemp(path), "w");
+	CHECK(NULL != file);
+	fclose(file);
+
+	SchemaWriter writer;
+	writer.add("Test", test);
+	CHECK(writer.write_file(path));
+
+	Schema schema;
+	CHECK_EQUAL(ParserError_None, schema.open_file(path));
+	CHECK_EQUAL(1u, schema.num_messages());
+	CHECK_EQUAL(7u, schema.find("Test")->num_fields);
+	schema.close();
+	CHECK(!schema.is_open());
+	remove(path);
+	CHECK_EQUAL(ParserError_CannotOpen, schema.open_file(path));
+}
@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_SCHEMA_WRITER_H
+#define OPENLIB_ICD_SCHEMA_WRITER_H
+
+//-Supporting libraries
+#include "openlib/icd/struct/schema_format.h"
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/data_descriptor.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Serializes message layouts onto a binary schema (@see Schema to use it)
+         */
+        class SchemaWriter
+        {
+            public:
+                //-Constructor & Destructor
+                SchemaWriter() {};
+                virtual ~SchemaWriter() {};
+
+                //-Accessor
+                inline size_t size() const  { return messages_.size(); }
+
+                //-Ancillary functions
+                inline void add(const std::string& name, const MessageICD& icd_message);
+                inline void clear();
+                inline void write(std::vector<uint8_t>& output) const;
+                inline bool write_file(const std::string& path) const;
+
+            protected:
+                //-Functions
+                inline uint32_t add_string(const std::string& value);
+                static inline uint64_t align(const uint64_t& offset) { return (offset + 7) & ~((uint64_t) 7); }
+
+                //-Fields
+                std::vector<SchemaMessage>  messages_;
+                std::vector<SchemaField>    fields_;
+                std::vector<SchemaEnum>     enums_;
+                std::string                 strings_;
+
+        }; /*class SchemaWriter*/
+
+        /**
+         * Adds the layout of a message (the values are not serialized)
+         * @param name The name of the message
+         * @param icd_message The message
+         */
+        void SchemaWriter::add(const std::string& name, const MessageICD& icd_message)
+        {
+            SchemaMessage message;
+            memset(&message, 0, sizeof(message));
+            message.name_offset = add_string(name);
+            message.name_length = (uint32_t) name.length();
+            message.first_field = (uint32_t) fields_.size();
+
+            const MessageICD::DataFieldSet& data_field_set = icd_message.data_field_set();
+            for (MessageICD::DataFieldSetConstIterator it = data_field_set.begin(); it != data_field_set.end(); ++it)
+            {
+                const DataDescriptor& data_descriptor = **it;
+                SchemaField field;
+                memset(&field, 0, sizeof(field));
+                field.name_offset   = add_string(data_descriptor.name());
+                field.name_length   = (uint32_t) data_descriptor.name().length();
+                field.byte_offset   = (uint32_t) (data_descriptor.byte_offset() + BIT2BYTE(data_descriptor.bit_offset()));
+                field.bit_offset    = (uint32_t) (data_descriptor.bit_offset() % 8);
+                field.num_bits      = (uint32_t) data_descriptor.num_bits();
+                field.data_type     = (uint8_t) data_descriptor.data_type();
+                field.endianess     = (uint8_t) data_descriptor.endianess();
+                field.first_enum    = (uint32_t) enums_.size();
+                const EnumTable& enum_table = data_descriptor.enum_table();
+                field.num_enums     = (uint32_t) enum_table.size();
+                for (size_t enum_idx = 0; enum_idx < enum_table.size(); ++enum_idx)
+                {
+                    const EnumTable::Entry& enum_entry = enum_table.entries()[enum_idx];
+                    SchemaEnum entry;
+                    memset(&entry, 0, sizeof(entry));
+                    entry.value         = (int32_t) enum_entry.value;
+                    entry.label_offset  = add_string(std::string(enum_table.label(enum_entry), enum_entry.label_length));
+                    entry.label_length  = enum_entry.label_length;
+                    enums_.push_back(entry);
+                }
+                fields_.push_back(field);
+
+                const uint32_t end_byte = field.byte_offset + (field.bit_offset + field.num_bits + 7) / 8;
+                if (end_byte > message.min_buffer_length)
+                {
+                    message.min_buffer_length = end_byte;
+                }
+                ++message.num_fields;
+            }
+            messages_.push_back(message);
+        }
+
+        /**
+         * Removes all the messages
+         */
+        void SchemaWriter::clear()
+        {
+            messages_.clear();
+            fields_.clear();
+            enums_.clear();
+            strings_.clear();
+        }
+
+        /**
+         * Serializes the messages
+         * @param output (output) The binary schema
+         */
+        void SchemaWriter::write(std::vector<uint8_t>& output) const
+        {
+            SchemaHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, SCHEMA_MAGIC, sizeof(header.magic));
+            header.version          = SCHEMA_VERSION;
+            header.byte_order       = SCHEMA_BYTE_ORDER;
+            header.num_messages     = (uint32_t) messages_.size();
+            header.num_fields       = (uint32_t) fields_.size();
+            header.num_enums        = (uint32_t) enums_.size();
+            header.strings_length   = (uint32_t) strings_.length();
+            header.messages_offset  = align(sizeof(header));
+            header.fields_offset    = align(header.messages_offset + messages_.size() * sizeof(SchemaMessage));
+            header.enums_offset     = align(header.fields_offset + fields_.size() * sizeof(SchemaField));
+            header.strings_offset   = align(header.enums_offset + enums_.size() * sizeof(SchemaEnum));
+            header.length           = header.strings_offset + strings_.length();
+
+            output.assign((size_t) header.length, 0);
+            memcpy(&output[0], &header, sizeof(header));
+            if (!messages_.empty())
+            {
+                memcpy(&output[(size_t) header.messages_offset], &messages_[0], messages_.size() * sizeof(SchemaMessage));
+            }
+            if (!fields_.empty())
+            {
+                memcpy(&output[(size_t) header.fields_offset], &fields_[0], fields_.size() * sizeof(SchemaField));
+            }
+            if (!enums_.empty())
+            {
+                memcpy(&output[(size_t) header.enums_offset], &enums_[0], enums_.size() * sizeof(SchemaEnum));
+            }
+            if (!strings_.empty())
+            {
+                memcpy(&output[(size_t) header.strings_offset], strings_.data(), strings_.length());
+            }
+        }
+
+        /**
+         * Serializes the messages onto a file
+         * @param path The path of the file
+         * @return true on success
+         */
+        bool SchemaWriter::write_file(const std::string& path) const
+        {
+            std::vector<uint8_t> output;
+            write(output);
+            FILE* file = fopen(path.c_str(), "wb");
+            if (NULL == file)
+            {
+                return false;
+            }
+            const bool written = (output.size() == fwrite(&output[0], 1, output.size(), file));
+            return (0 == fclose(file)) && written;
+        }
+
+        /**
+         * Appends a string to the pool (null terminated)
+         * @param value The string
+         * @return uint32_t containing its offset within the pool
+         */
+        uint32_t SchemaWriter::add_string(const std::string& value)
+        {
+            const uint32_t offset = (uint32_t) strings_.length();
+            strings_.append(value);
+            strings_.push_back('\0');
+            return offset;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_SCHEMA_WRITER_H*/
@@ -0,0 +1,92 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_FIELD_H
+#define OPENLIB_ICD_FIELD_H
+
+//-Supporting libraries
+#include "openlib/common.h"
+#include "openlib/enum/endianess.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+//-Namespace/s
+namespace openlib
+{
+	namespace icd
+	{
+		/**
+		 * A data field entry with the layout fixed at compile time (@see ICDDataEntry for the runtime one)
+		 * Impossible layouts are rejected at compile time, byte aligned full width fields are accessed
+		 * with a plain load plus byte swap (@see buffer::extract/buffer::insert)
+		 * @tparam BYTE_OFFSET The byte index (0 based) of the field
+		 * @tparam BIT_OFFSET The bit position within the byte [0..7], on the wire order
+		 * @tparam NUM_BITS The number of bits of the field [1..64]
+		 * @tparam ENDIANESS The endianess of the field on the wire
+		 * @tparam T The value type (integral type)
+		 */
+		template <size_t BYTE_OFFSET, size_t BIT_OFFSET, size_t NUM_BITS, Endianess ENDIANESS, typename T>
+		struct ICDField
+		{
+			//-Layout checks
+			static_assert(std::is_integral<T>::value, "ICDField: the value type must be integral");
+			static_assert(BIT_OFFSET < 8, "ICDField: the bit offset must be within the byte [0..7]");
+			static_assert(NUM_BITS > 0 && NUM_BITS <= 64, "ICDField: the number of bits must be [1..64]");
+			static_assert(NUM_BITS <= BYTE2BIT(sizeof(T)), "ICDField: the value type is too small for the number of bits");
+			static_assert(Endianess_BigEndian == ENDIANESS || Endianess_LittleEndian == ENDIANESS, "ICDField: undefined endianess");
+			static_assert(Endianess_BigEndian == ENDIANESS || NUM_BITS <= 8 || NUM_BITS % 8 == 0, "ICDField: little-endian fields must span whole bytes");
+
+			//-Types
+			typedef T value_type;
+
+			//-Layout
+			static const size_t     byte_offset = BYTE_OFFSET;
+			static const size_t     bit_offset  = BIT_OFFSET;
+			static const size_t     num_bits    = NUM_BITS;
+			static const Endianess  endianess   = ENDIANESS;
+
+			//-Derived layout
+			static const size_t     byte_length = (BIT_OFFSET + NUM_BITS + 7) / 8;    //-Bytes spanned by the field
+			static const size_t     min_buffer_length = BYTE_OFFSET + byte_length;    //-Buffer length needed to hold the field
+			static const bool       aligned     = (0 == BIT_OFFSET && BYTE2BIT(sizeof(T)) == NUM_BITS);
+
+			ICDField() : value(0)
+			{
+			}
+
+			T                   value;
+
+		};/*ICDField*/
+
+		//-Class Field Initialization
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const size_t ICDField<B, b, N, E, T>::byte_offset;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const size_t ICDField<B, b, N, E, T>::bit_offset;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const size_t ICDField<B, b, N, E, T>::num_bits;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const Endianess ICDField<B, b, N, E, T>::endianess;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const size_t ICDField<B, b, N, E, T>::byte_length;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const size_t ICDField<B, b, N, E, T>::min_buffer_length;
+		template <size_t B, size_t b, size_t N, Endianess E, typename T> const bool ICDField<B, b, N, E, T>::aligned;
+
+	};/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_FIELD_H*/
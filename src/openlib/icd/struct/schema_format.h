@@ -0,0 +1,119 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_SCHEMA_FORMAT_H
+#define OPENLIB_ICD_SCHEMA_FORMAT_H
+
+//-Supporting libraries
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+//-Namespace/s
+namespace openlib
+{
+	namespace icd
+	{
+		/**
+		 * Binary schema file layout (@see Schema, SchemaWriter), all the offsets are relative to the start of
+		 * the file and every table starts 8 bytes aligned, the integers are in the byte order of the writer
+		 * (checked on load through 'byte_order')
+		 *
+		 *   SchemaHeader | SchemaMessage[num_messages] | SchemaField[num_fields] | SchemaEnum[num_enums] | strings
+		 *
+		 * Strings (names and labels) are null terminated within the string pool
+		 */
+		static const char     SCHEMA_MAGIC[8]    = {'O', 'L', 'I', 'C', 'D', 'S', 'C', 'H'};
+		static const uint32_t SCHEMA_VERSION     = 1;
+		static const uint32_t SCHEMA_BYTE_ORDER  = 0x01020304;
+
+		/**
+		 * File header
+		 */
+		struct SchemaHeader
+		{
+			char        magic[8];           //-SCHEMA_MAGIC
+			uint32_t    version;            //-SCHEMA_VERSION
+			uint32_t    byte_order;         //-SCHEMA_BYTE_ORDER as written
+			uint64_t    length;             //-Length of the whole file
+			uint32_t    num_messages;
+			uint32_t    num_fields;
+			uint32_t    num_enums;
+			uint32_t    strings_length;
+			uint64_t    messages_offset;
+			uint64_t    fields_offset;
+			uint64_t    enums_offset;
+			uint64_t    strings_offset;
+		};/*SchemaHeader*/
+
+		/**
+		 * Message entry, its fields are contiguous and in offset order
+		 */
+		struct SchemaMessage
+		{
+			uint32_t    name_offset;        //-Within the string pool
+			uint32_t    name_length;
+			uint32_t    first_field;        //-Index of the first field
+			uint32_t    num_fields;
+			uint32_t    min_buffer_length;  //-Bytes spanned by the fields
+			uint32_t    reserved;
+		};/*SchemaMessage*/
+
+		/**
+		 * Field entry, its enumeration entries are contiguous and in value order
+		 */
+		struct SchemaField
+		{
+			uint32_t    name_offset;        //-Within the string pool
+			uint32_t    name_length;
+			uint32_t    byte_offset;
+			uint32_t    bit_offset;
+			uint32_t    num_bits;
+			uint8_t     data_type;          //-DataType
+			uint8_t     endianess;          //-Endianess
+			uint16_t    reserved;
+			uint32_t    first_enum;         //-Index of the first enumeration entry
+			uint32_t    num_enums;
+		};/*SchemaField*/
+
+		/**
+		 * Enumeration entry
+		 */
+		struct SchemaEnum
+		{
+			int32_t     value;
+			uint32_t    label_offset;       //-Within the string pool
+			uint32_t    label_length;
+			uint32_t    reserved;
+		};/*SchemaEnum*/
+
+		//-The layout must not depend on the compiler
+		static_assert(sizeof(SchemaHeader) == 72, "SchemaHeader: unexpected padding");
+		static_assert(sizeof(SchemaMessage) == 24, "SchemaMessage: unexpected padding");
+		static_assert(sizeof(SchemaField) == 32, "SchemaField: unexpected padding");
+		static_assert(sizeof(SchemaEnum) == 16, "SchemaEnum: unexpected padding");
+		static_assert(std::is_trivially_copyable<SchemaHeader>::value && std::is_trivially_copyable<SchemaField>::value,
+		              "Schema entries are used in place");
+
+	};/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_SCHEMA_FORMAT_H*/
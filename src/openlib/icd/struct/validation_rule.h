@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_VALIDATION_RULE_H
+#define OPENLIB_ICD_VALIDATION_RULE_H
+
+//-Supporting libraries
+#include "openlib/icd/enum/rule_kind.h"
+#include <stdint.h>
+
+//-Namespace/s
+namespace openlib
+{
+	namespace icd
+	{
+		/**
+		 * Declarative validation rule of an integral field (@see DataDescriptor::add_rule, MessageValidator)
+		 */
+		struct ValidationRule
+		{
+			RuleKind    kind;
+			int64_t     min;        //-RuleKind_Range
+			int64_t     max;        //-RuleKind_Range
+			uint64_t    mask;       //-RuleKind_ReservedZero (bits of the field, right aligned)
+
+			static inline ValidationRule range(const int64_t& min, const int64_t& max)  { ValidationRule rule = {RuleKind_Range, min, max, 0}; return rule; }
+			static inline ValidationRule non_zero()                                     { ValidationRule rule = {RuleKind_NonZero, 0, 0, 0}; return rule; }
+			static inline ValidationRule reserved_zero(const uint64_t& mask)            { ValidationRule rule = {RuleKind_ReservedZero, 0, 0, mask}; return rule; }
+			static inline ValidationRule enum_set()                                     { ValidationRule rule = {RuleKind_EnumSet, 0, 0, 0}; return rule; }
+		};/*ValidationRule*/
+
+	};/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_VALIDATION_RULE_H*/
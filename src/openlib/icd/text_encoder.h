@@ -0,0 +1,731 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_TEXT_ENCODER_H
+#define OPENLIB_ICD_TEXT_ENCODER_H
+
+//-Supporting libraries
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/enum_table.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/enum/text_format.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/name_index.h"
+#include "openlib/utils/hex_codec.h"
+#include "openlib/utils/utils.h"
+#include <algorithm>
+#include <charconv>
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Encodes text lines (JSON objects or CSV rows, @see TextSerializer) straight onto wire buffers:
+         * the fields are found through the name index of the plan, the numbers parsed with std::from_chars
+         * and the enumeration labels resolved through the label hash of the descriptors. No locale, no
+         * stream, no allocation per message
+         *
+         *   JSON: {"id":7,"mode":"RUN","name":"abc","payload":"0a1b"}   (keys in any order)
+         *   CSV:  7,RUN,abc,0a1b                                        (@see set_header)
+         *
+         * Integers are decimal (or hexadecimal with a 0x prefix) and must fit the field, enumerations take
+         * a label or a number, ascii fields are null padded and binary fields take 2 hexadecimal digits
+         * per byte. The fields missing from a line (unknown names, JSON null, empty CSV fields) are not
+         * written: the buffer keeps its previous bits
+         */
+        class TextEncoder
+        {
+            public:
+                //-Constructor & Destructor
+                TextEncoder() : plan_(NULL), format_(TextFormat_Json) {};
+                ~TextEncoder() {};
+
+                //-Accessor
+                inline const MessagePlan* plan() const          { return plan_;     }
+                inline const TextFormat& format() const         { return format_;   }
+
+                //-Ancillary functions
+                inline ParserError compile(const MessagePlan& plan, const TextFormat& format);
+                inline ParserError set_header(const char* line, const size_t& line_length);
+                inline void clear();
+                inline ParserError encode(const char* line, const size_t& line_length, uint8_t* buffer, const size_t& buffer_length) const;
+                inline ParserError encode(const char* text, const size_t& text_length, uint8_t* buffers, const size_t& stride,
+                                          const size_t& max_messages, size_t& num_messages, size_t& consumed) const;
+
+            protected:
+                /**
+                 * Text value (without the quotes)
+                 */
+                struct Token
+                {
+                    const char* data;
+                    size_t      length;
+                    bool        quoted;
+                    bool        escaped;    //-JSON escape sequences / CSV doubled quotes
+                };
+
+                //-Functions
+                inline ParserError encode_json(const char* cursor, const char* end, uint8_t* buffer, const size_t& buffer_length) const;
+                inline ParserError encode_csv(const char* cursor, const char* end, uint8_t* buffer, const size_t& buffer_length) const;
+                inline ParserError next_json(const char*& cursor, const char* end, Token& token) const;
+                inline ParserError next_csv(const char*& cursor, const char* end, Token& token) const;
+                inline ParserError assign(const FieldOperation& operation, const Token& token, uint8_t* buffer, const size_t& buffer_length) const;
+                inline int next_char(const Token& token, size_t& idx) const;
+                inline size_t unescape(const Token& token, char* output, const size_t& output_length) const;
+                static inline bool is_space(const char& character)     { return ' ' == character || '\t' == character; }
+                static inline bool parse_integer(const Token& token, int64_t& value);
+                static inline void put_byte(const FieldOperation& operation, const size_t& byte_idx, const uint8_t& value, uint8_t* buffer, const size_t& buffer_length);
+
+                //-Constants
+                static const int END_OF_TOKEN = -1;
+                static const int INVALID_ESCAPE = -2;
+                static const size_t MAX_NAME_LENGTH = 256;     //-Escaped names / labels
+
+                //-Fields
+                NameIndex           index_;
+                std::vector<size_t> columns_;   //-Field of each CSV column (NameIndex::NOT_FOUND: ignored)
+                const MessagePlan*  plan_;
+                TextFormat          format_;
+
+        }; /*class TextEncoder*/
+
+        /**
+         * Indexes the fields of a plan, the CSV columns follow the plan order (@see set_header)
+         * IMPORTANT: the plan (and its descriptors) must outlive the encoder (or the next compile)
+         * @param plan The compiled plan (@see MessageICD::compile)
+         * @param format The text format
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::compile(const MessagePlan& plan, const TextFormat& format)
+        {
+            clear();
+            if (TextFormat_Json != format && TextFormat_Csv != format)
+            {
+                return ParserError_InvalidDataType;
+            }
+            format_ = format;
+            index_.build(plan);
+            columns_.resize(plan.operations().size());
+            for (size_t field_idx = 0; field_idx < columns_.size(); ++field_idx)
+            {
+                columns_[field_idx] = field_idx;
+            }
+            plan_ = &plan;
+            return ParserError_None;
+        }
+
+        /**
+         * Maps the CSV columns onto fields by name (the columns of unknown names are ignored)
+         * @param line The names row (without the new line)
+         * @param line_length The length of the line
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::set_header(const char* line, const size_t& line_length)
+        {
+            if (NULL == plan_ || NULL == line)
+            {
+                return ParserError_NullParameter;
+            }
+            if (TextFormat_Csv != format_)
+            {
+                return ParserError_InvalidDataType;
+            }
+            std::vector<size_t> columns;
+            const char* cursor = line;
+            const char* end = line + line_length;
+            char name[MAX_NAME_LENGTH];
+            do
+            {
+                Token token;
+                const ParserError error = next_csv(cursor, end, token);
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+                const size_t name_length = unescape(token, name, sizeof(name));
+                const size_t field_idx = (sizeof(name) < name_length) ? NameIndex::NOT_FOUND : index_.find(name, name_length);
+                columns.push_back(field_idx);
+            }
+            while (cursor++ < end);
+            columns_.swap(columns);
+            return ParserError_None;
+        }
+
+        /**
+         * Clears the encoder
+         */
+        void TextEncoder::clear()
+        {
+            index_.clear();
+            columns_.clear();
+            plan_ = NULL;
+        }
+
+        /**
+         * Encodes a line onto a buffer (only the fields of the line are written)
+         * @param line The line (the new line, if any, is ignored)
+         * @param line_length The length of the line
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::encode(const char* line, const size_t& line_length, uint8_t* buffer, const size_t& buffer_length) const
+        {
+            if (NULL == plan_ || NULL == line || NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < plan_->min_buffer_length())
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            const char* end = line + line_length;
+            while (end != line && ('\n' == end[-1] || '\r' == end[-1]))
+            {
+                --end;
+            }
+            return (TextFormat_Json == format_) ? encode_json(line, end, buffer, buffer_length) : encode_csv(line, end, buffer, buffer_length);
+        }
+
+        /**
+         * Encodes the lines of a text onto consecutive buffers (the empty lines are skipped)
+         * @param text The text (the last line does not need a new line)
+         * @param text_length The length of the text
+         * @param buffers The buffers, 'stride' bytes apart
+         * @param stride The distance between buffers (>= min_buffer_length())
+         * @param max_messages The number of buffers
+         * @param num_messages (output) The number of messages encoded
+         * @param consumed (output) The characters consumed: up to the failing line on errors, less than
+         * text_length when the buffers run out
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::encode(const char* text, const size_t& text_length, uint8_t* buffers, const size_t& stride,
+                                        const size_t& max_messages, size_t& num_messages, size_t& consumed) const
+        {
+            num_messages = 0;
+            consumed = 0;
+            if (NULL == plan_ || NULL == text || NULL == buffers)
+            {
+                return ParserError_NullParameter;
+            }
+            if (stride < plan_->min_buffer_length())
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            while (consumed < text_length)
+            {
+                const char* line = text + consumed;
+                const char* new_line = (const char*) memchr(line, '\n', text_length - consumed);
+                const size_t line_length = (NULL == new_line) ? text_length - consumed : (size_t) (new_line - line);
+                if (0 != line_length && !(1 == line_length && '\r' == *line))
+                {
+                    if (num_messages == max_messages)
+                    {
+                        break;
+                    }
+                    const ParserError error = encode(line, line_length, buffers + num_messages * stride, stride);
+                    if (ParserError_None != error)
+                    {
+                        return error;
+                    }
+                    ++num_messages;
+                }
+                consumed += line_length + ((NULL == new_line) ? 0 : 1);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Encodes a JSON object (flat: string and number values)
+         * @param cursor The start of the line
+         * @param end The end of the line
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::encode_json(const char* cursor, const char* end, uint8_t* buffer, const size_t& buffer_length) const
+        {
+            const MessagePlan::FieldOperationVector& operations = plan_->operations();
+            char name[MAX_NAME_LENGTH];
+            while (cursor != end && is_space(*cursor))
+            {
+                ++cursor;
+            }
+            if (cursor == end)
+            {
+                return ParserError_UnexpectedEnd;
+            }
+            if ('{' != *cursor++)
+            {
+                return ParserError_SyntaxError;
+            }
+            bool first = true;
+            while (true)
+            {
+                //-Key (or the end of an empty object)
+                Token key;
+                ParserError error = next_json(cursor, end, key);
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+                if (first && !key.quoted && 0 == key.length && cursor != end && '}' == *cursor)
+                {
+                    ++cursor;
+                    break;
+                }
+                if (!key.quoted)
+                {
+                    return ParserError_SyntaxError;
+                }
+                if (cursor == end)
+                {
+                    return ParserError_UnexpectedEnd;
+                }
+                if (':' != *cursor++)
+                {
+                    return ParserError_SyntaxError;
+                }
+
+                //-Value
+                Token value;
+                error = next_json(cursor, end, value);
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+                const size_t name_length = unescape(key, name, sizeof(name));
+                const size_t field_idx = (sizeof(name) < name_length) ? NameIndex::NOT_FOUND : index_.find(name, name_length);
+                const bool is_null = !value.quoted && 4 == value.length && 0 == memcmp(value.data, "null", 4);
+                if (NameIndex::NOT_FOUND != field_idx && !is_null)
+                {
+                    error = assign(operations[field_idx], value, buffer, buffer_length);
+                    if (ParserError_None != error)
+                    {
+                        return error;
+                    }
+                }
+
+                if (cursor == end)
+                {
+                    return ParserError_UnexpectedEnd;
+                }
+                first = false;
+                const char separator = *cursor++;
+                if ('}' == separator)
+                {
+                    break;
+                }
+                if (',' != separator)
+                {
+                    return ParserError_SyntaxError;
+                }
+            }
+            while (cursor != end && is_space(*cursor))
+            {
+                ++cursor;
+            }
+            return (cursor == end) ? ParserError_None : ParserError_SyntaxError;
+        }
+
+        /**
+         * Encodes a CSV row
+         * @param cursor The start of the line
+         * @param end The end of the line
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::encode_csv(const char* cursor, const char* end, uint8_t* buffer, const size_t& buffer_length) const
+        {
+            const MessagePlan::FieldOperationVector& operations = plan_->operations();
+            size_t column_idx = 0;
+            do
+            {
+                Token token;
+                ParserError error = next_csv(cursor, end, token);
+                if (ParserError_None != error)
+                {
+                    return error;
+                }
+                const size_t field_idx = (column_idx < columns_.size()) ? columns_[column_idx] : NameIndex::NOT_FOUND;
+                if (NameIndex::NOT_FOUND != field_idx && (0 != token.length || token.quoted))
+                {
+                    error = assign(operations[field_idx], token, buffer, buffer_length);
+                    if (ParserError_None != error)
+                    {
+                        return error;
+                    }
+                }
+                ++column_idx;
+            }
+            while (cursor++ < end);
+            return ParserError_None;
+        }
+
+        /**
+         * Reads a JSON string or a bare value (number, literal) and the white spaces after it
+         * @param cursor (input/output) The position, on the character after the token
+         * @param end The end of the line
+         * @param token (output) The token
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::next_json(const char*& cursor, const char* end, Token& token) const
+        {
+            while (cursor != end && is_space(*cursor))
+            {
+                ++cursor;
+            }
+            token.quoted = (cursor != end && '"' == *cursor);
+            token.escaped = false;
+            if (token.quoted)
+            {
+                token.data = ++cursor;
+                while (cursor != end && '"' != *cursor)
+                {
+                    if ('\\' == *cursor)
+                    {
+                        token.escaped = true;
+                        ++cursor;
+                        if (cursor == end)
+                        {
+                            break;
+                        }
+                    }
+                    ++cursor;
+                }
+                if (cursor == end)
+                {
+                    return ParserError_UnexpectedEnd;
+                }
+                token.length = cursor++ - token.data;
+            }
+            else
+            {
+                token.data = cursor;
+                while (cursor != end && ',' != *cursor && ':' != *cursor && '}' != *cursor && !is_space(*cursor))
+                {
+                    //-Nested values are not supported
+                    if ('{' == *cursor || '[' == *cursor || '"' == *cursor)
+                    {
+                        return ParserError_SyntaxError;
+                    }
+                    ++cursor;
+                }
+                token.length = cursor - token.data;
+            }
+            while (cursor != end && is_space(*cursor))
+            {
+                ++cursor;
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Reads a CSV field (RFC 4180 quoting)
+         * @param cursor (input/output) The position, on the separator after the field (or the end)
+         * @param end The end of the line
+         * @param token (output) The token
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::next_csv(const char*& cursor, const char* end, Token& token) const
+        {
+            token.quoted = (cursor != end && '"' == *cursor);
+            token.escaped = false;
+            if (token.quoted)
+            {
+                token.data = ++cursor;
+                while (true)
+                {
+                    cursor = (const char*) memchr(cursor, '"', end - cursor);
+                    if (NULL == cursor)
+                    {
+                        cursor = end;
+                        return ParserError_UnexpectedEnd;
+                    }
+                    if (cursor + 1 == end || '"' != cursor[1])
+                    {
+                        break;
+                    }
+                    token.escaped = true;
+                    cursor += 2;
+                }
+                token.length = cursor++ - token.data;
+                if (cursor != end && ',' != *cursor)
+                {
+                    return ParserError_SyntaxError;
+                }
+            }
+            else
+            {
+                token.data = cursor;
+                const char* separator = (const char*) memchr(cursor, ',', end - cursor);
+                cursor = (NULL == separator) ? end : separator;
+                token.length = cursor - token.data;
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Encodes a value onto its field
+         * @param operation The field operation
+         * @param token The value
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextEncoder::assign(const FieldOperation& operation, const Token& token, uint8_t* buffer, const size_t& buffer_length) const
+        {
+            const DataType data_type = operation.descriptor->data_type();
+            if (FieldOperationKind_Integer == operation.kind)
+            {
+                int64_t value = 0;
+                const bool is_label = (DataType_enum == data_type) &&
+                                      (0 == token.length || !(isdigit((unsigned char) token.data[0]) || '-' == token.data[0]));
+                if (is_label)
+                {
+                    //-Escaped labels are copied first
+                    char label[MAX_NAME_LENGTH];
+                    const char* label_data = token.data;
+                    size_t label_length = token.length;
+                    if (token.escaped)
+                    {
+                        label_length = unescape(token, label, sizeof(label));
+                        label_data = label;
+                    }
+                    int enum_value = 0;
+                    if (sizeof(label) < label_length || !operation.descriptor->enum_table().value_of(label_data, label_length, enum_value))
+                    {
+                        return ParserError_UnknownKeyword;
+                    }
+                    //-Labels are range checked as the field bit pattern (@see MessagePlan::add)
+                    value = MessagePlan::container_value(operation, (uint64_t) (int64_t) enum_value);
+                }
+                else if (!parse_integer(token, value))
+                {
+                    return ParserError_InvalidNumber;
+                }
+
+                //-Range of the field
+                const size_t num_bits = operation.num_bits;
+                const int64_t min_value = operation.is_signed ? -((int64_t) 1 << (num_bits - 1)) : 0;
+                const int64_t max_value = operation.is_signed ? ((int64_t) 1 << (num_bits - 1)) - 1 :
+                                          (num_bits >= 63) ? INT64_MAX : ((int64_t) 1 << num_bits) - 1;
+                if (value < min_value || value > max_value)
+                {
+                    return ParserError_InvalidNumber;
+                }
+                uint8_t container[sizeof(uint64_t)];
+                MessagePlan::store_value(container, operation.data_length, (uint64_t) value);
+                MessagePlan::encode_field(operation, container, buffer, buffer_length);
+                return ParserError_None;
+            }
+
+            if (DataType_binary == data_type)
+            {
+                //-2 hexadecimal digits per byte
+                if (2 * operation.data_length != token.length)
+                {
+                    return ParserError_InvalidNumber;
+                }
+                if (0 == operation.bit_offset)
+                {
+                    return (token.length == hex_codec::decode_digits(token.data, operation.data_length, buffer + operation.byte_index)) ?
+                           ParserError_None : ParserError_InvalidNumber;
+                }
+                const uint8_t* digits = hex_codec::digit_table();
+                for (size_t byte_idx = 0; byte_idx < operation.data_length; ++byte_idx)
+                {
+                    const uint8_t high = digits[(uint8_t) token.data[2 * byte_idx]];
+                    const uint8_t low = digits[(uint8_t) token.data[2 * byte_idx + 1]];
+                    if (hex_codec::INVALID_DIGIT == high || hex_codec::INVALID_DIGIT == low)
+                    {
+                        return ParserError_InvalidNumber;
+                    }
+                    put_byte(operation, byte_idx, (uint8_t) ((high << 4) | low), buffer, buffer_length);
+                }
+                return ParserError_None;
+            }
+
+            //-Ascii, null padded
+            size_t idx = 0;
+            size_t byte_idx = 0;
+            for (int character = next_char(token, idx); END_OF_TOKEN != character; character = next_char(token, idx))
+            {
+                if (INVALID_ESCAPE == character)
+                {
+                    return ParserError_SyntaxError;
+                }
+                if (byte_idx == operation.data_length)
+                {
+                    return ParserError_ContainerTooSmall;
+                }
+                put_byte(operation, byte_idx++, (uint8_t) character, buffer, buffer_length);
+            }
+            for (; byte_idx < operation.data_length; ++byte_idx)
+            {
+                put_byte(operation, byte_idx, 0, buffer, buffer_length);
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Reads the next character of a token, resolving the escape sequences (JSON \uXXXX up to ÿ)
+         * @param token The token
+         * @param idx (input/output) The position within the token
+         * @return int containing the character, END_OF_TOKEN or INVALID_ESCAPE
+         */
+        int TextEncoder::next_char(const Token& token, size_t& idx) const
+        {
+            if (idx >= token.length)
+            {
+                return END_OF_TOKEN;
+            }
+            const unsigned char character = (unsigned char) token.data[idx++];
+            if (!token.escaped)
+            {
+                return character;
+            }
+            if (TextFormat_Csv == format_)
+            {
+                //-Doubled quotes
+                idx += ('"' == character) ? 1 : 0;
+                return character;
+            }
+            if ('\\' != character)
+            {
+                return character;
+            }
+            if (idx >= token.length)
+            {
+                return INVALID_ESCAPE;
+            }
+            switch (token.data[idx++])
+            {
+                case '"'  : return '"';
+                case '\\' : return '\\';
+                case '/'  : return '/';
+                case 'b'  : return '\b';
+                case 'f'  : return '\f';
+                case 'n'  : return '\n';
+                case 'r'  : return '\r';
+                case 't'  : return '\t';
+                case 'u'  :
+                {
+                    unsigned int code = 0;
+                    const std::from_chars_result result = std::from_chars(token.data + idx, token.data + std::min(idx + 4, token.length), code, 16);
+                    if (std::errc() != result.ec || token.data + idx + 4 != result.ptr || code > 0xFF)
+                    {
+                        return INVALID_ESCAPE;
+                    }
+                    idx += 4;
+                    return (int) code;
+                }
+                default   : return INVALID_ESCAPE;
+            }
+        }
+
+        /**
+         * Copies a token resolving its escape sequences (names and labels)
+         * @param token The token
+         * @param output The output
+         * @param output_length The length of the output
+         * @return size_t containing the length of the text, > output_length if it does not fit or on an
+         * invalid escape sequence
+         */
+        size_t TextEncoder::unescape(const Token& token, char* output, const size_t& output_length) const
+        {
+            if (!token.escaped)
+            {
+                if (token.length <= output_length)
+                {
+                    memcpy(output, token.data, token.length);
+                }
+                return token.length;
+            }
+            size_t idx = 0;
+            size_t length = 0;
+            for (int character = next_char(token, idx); END_OF_TOKEN != character; character = next_char(token, idx))
+            {
+                if (INVALID_ESCAPE == character || length == output_length)
+                {
+                    return output_length + 1;
+                }
+                output[length++] = (char) character;
+            }
+            return length;
+        }
+
+        /**
+         * Parses an integer: decimal or hexadecimal with a 0x prefix, the whole token
+         * @param token The token
+         * @param value (output) The value
+         * @return true if valid
+         */
+        bool TextEncoder::parse_integer(const Token& token, int64_t& value)
+        {
+            const char* end = token.data + token.length;
+            if (token.length > 2 && '0' == token.data[0] && ('x' == token.data[1] || 'X' == token.data[1]))
+            {
+                uint64_t bits = 0;
+                if (!utils::parse_hex(token.data, end, bits) || bits > (uint64_t) INT64_MAX)
+                {
+                    return false;
+                }
+                value = (int64_t) bits;
+                return true;
+            }
+            return utils::parse_int(token.data, end, value);
+        }
+
+        /**
+         * Writes a byte of a byte array field
+         * IMPORTANT: NO CHECKS!!!!!!!! the buffer must hold at least 'min_buffer_length()' bytes
+         * @param operation The field operation
+         * @param byte_idx The byte within the field
+         * @param value The byte
+         * @param buffer The buffer where to encode
+         * @param buffer_length The length of the buffer
+         */
+        void TextEncoder::put_byte(const FieldOperation& operation, const size_t& byte_idx, const uint8_t& value, uint8_t* buffer, const size_t& buffer_length)
+        {
+            if (0 == operation.bit_offset)
+            {
+                buffer[operation.byte_index + byte_idx] = value;
+            }
+            else
+            {
+                buffer::insert_raw(buffer + operation.byte_index, buffer_length - operation.byte_index, BYTE2BIT(byte_idx) + operation.bit_offset, 8, value);
+            }
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_TEXT_ENCODER_H*/
@@ -0,0 +1,247 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "text_encoder.h"
+#include "text_icd_parser.h"
+#include "text_serializer.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const char* ENCODER_ICD =
+	"field id      uint8   0 0 8  BE\n"
+	"field count   int16   1 0 16 LE\n"
+	"field mode    enum    3 0 4  BE\n"
+	"    enum 1 RUN\n"
+	"    enum 2 A,B\n"
+	"    enum 9 STOP\n"
+	"    enum 15 FAULT\n"
+	"field delta   int8    3 4 4  BE\n"
+	"field name    ascii   4 0 32 BE\n"
+	"field payload binary  8 4 16 BE\n";
+static const size_t ENCODER_LENGTH = 11;
+static const size_t ENCODER_MESSAGES = 200;
+
+TEST_GROUP(text_encoder)
+{
+	MessageICD message;
+	TextEncoder encoder;
+
+	void setup()
+	{
+		TextICDParser parser;
+		CHECK_EQUAL(ParserError_None, parser.parse(string(ENCODER_ICD), message));
+		CHECK_EQUAL(ParserError_None, message.compile());
+	}
+
+	void teardown()
+	{
+	}
+
+	/**
+	 * Encodes a line onto a zeroed buffer
+	 */
+	ParserError encode(const char* line, uint8_t* buffer)
+	{
+		memset(buffer, 0, ENCODER_LENGTH);
+		return encoder.encode(line, strlen(line), buffer, ENCODER_LENGTH);
+	}
+};
+
+TEST(text_encoder, Test_json)
+{
+	CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), TextFormat_Json));
+
+	//-Any key order, white spaces, escape sequences, unknown keys and nulls skipped
+	uint8_t buffer[ENCODER_LENGTH];
+	CHECK_EQUAL(ParserError_None, encode(" { \"payload\" : \"abcd\", \"name\":\"a\\\"\\u00e9\",\"mode\":\"FAULT\",\"count\":-100,"
+	                                     "\"id\":0x7,\"other\":12,\"delta\":null,\"de\\u006cta\":-3}\r\n", buffer));
+	const uint8_t expected[ENCODER_LENGTH] = {7, 0x9C, 0xFF, 0xFD, 'a', '"', 0xE9, 0, 0x0A, 0xBC, 0xD0};
+	MEMCMP_EQUAL(expected, buffer, sizeof(buffer));
+
+	//-Numeric enumeration, empty object
+	CHECK_EQUAL(ParserError_None, encode("{\"mode\":5}", buffer));
+	CHECK_EQUAL(0x50, buffer[3]);
+	CHECK_EQUAL(ParserError_None, encode("{}", buffer));
+}
+
+TEST(text_encoder, Test_csv)
+{
+	CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), TextFormat_Csv));
+
+	//-Plan order
+	uint8_t buffer[ENCODER_LENGTH];
+	CHECK_EQUAL(ParserError_None, encode("7,-100,\"A,B\",-3,\"a\"\"b\",abcd", buffer));
+	const uint8_t expected[ENCODER_LENGTH] = {7, 0x9C, 0xFF, 0x2D, 'a', '"', 'b', 0, 0x0A, 0xBC, 0xD0};
+	MEMCMP_EQUAL(expected, buffer, sizeof(buffer));
+
+	//-Header order, unknown and empty columns
+	const char* header = "name,other,\"id\",mode";
+	CHECK_EQUAL(ParserError_None, encoder.set_header(header, strlen(header)));
+	CHECK_EQUAL(ParserError_None, encode("xyz,123,9,", buffer));
+	const uint8_t reordered[ENCODER_LENGTH] = {9, 0, 0, 0, 'x', 'y', 'z', 0, 0, 0, 0};
+	MEMCMP_EQUAL(reordered, buffer, sizeof(buffer));
+}
+
+TEST(text_encoder, Test_round_trip)
+{
+	srand(29);
+	vector<uint8_t> buffers(ENCODER_MESSAGES * ENCODER_LENGTH);
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		buffers[i] = (uint8_t) rand();
+	}
+	for (size_t row = 0; row < ENCODER_MESSAGES; ++row)
+	{
+		//-Ascii without null characters (rendered up to the first one), unused bits cleared
+		uint8_t* buffer = &buffers[row * ENCODER_LENGTH];
+		for (size_t i = 4; i < 8; ++i)
+		{
+			buffer[i] = (uint8_t) ('a' + buffer[i] % 26);
+		}
+		buffer[8] &= 0x0F;
+		buffer[10] &= 0xF0;
+	}
+
+	for (size_t format = TextFormat_Json; format <= TextFormat_Csv; ++format)
+	{
+		TextSerializer serializer;
+		CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), (TextFormat) format));
+		CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), (TextFormat) format));
+		string text = serializer.header();
+		for (size_t row = 0; row < ENCODER_MESSAGES; ++row)
+		{
+			char line[256];
+			size_t written = 0;
+			CHECK_EQUAL(ParserError_None, serializer.write(&buffers[row * ENCODER_LENGTH], ENCODER_LENGTH, line, sizeof(line), written));
+			text.append(line, written);
+			text += (0 == row % 7) ? "\n" : "";
+		}
+
+		//-Bulk, the header first
+		const char* lines = text.data();
+		size_t text_length = text.length();
+		if (TextFormat_Csv == format)
+		{
+			const size_t header_length = serializer.header().length();
+			CHECK_EQUAL(ParserError_None, encoder.set_header(lines, header_length - 1));
+			lines += header_length;
+			text_length -= header_length;
+		}
+		vector<uint8_t> encoded(buffers.size(), 0);
+		size_t num_messages = 0;
+		size_t consumed = 0;
+		CHECK_EQUAL(ParserError_None, encoder.encode(lines, text_length, encoded.data(), ENCODER_LENGTH, ENCODER_MESSAGES / 2, num_messages, consumed));
+		CHECK_EQUAL(ENCODER_MESSAGES / 2, num_messages);
+		CHECK(consumed < text_length);
+		size_t remaining = 0;
+		CHECK_EQUAL(ParserError_None, encoder.encode(lines + consumed, text_length - consumed, &encoded[num_messages * ENCODER_LENGTH], ENCODER_LENGTH, ENCODER_MESSAGES, remaining, consumed));
+		CHECK_EQUAL(ENCODER_MESSAGES / 2, remaining);
+		MEMCMP_EQUAL(buffers.data(), encoded.data(), buffers.size());
+	}
+}
+
+TEST(text_encoder, Test_enum)
+{
+	//-Values with the top bit set, by label and by number
+	for (size_t format = TextFormat_Json; format <= TextFormat_Csv; ++format)
+	{
+		TextSerializer serializer;
+		CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), (TextFormat) format));
+		CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), (TextFormat) format));
+		const char* lines[] = {"{\"mode\":\"STOP\"}", "{\"mode\":9}", ",,STOP,,,", ",,9,,,"};
+		for (size_t idx = 2 * (format - TextFormat_Json); idx < 2 * (format - TextFormat_Json + 1); ++idx)
+		{
+			uint8_t buffer[ENCODER_LENGTH];
+			CHECK_EQUAL(ParserError_None, encode(lines[idx], buffer));
+			CHECK_EQUAL(0x90, buffer[3]);
+
+			//-Rendered back with its label and encoded again
+			char line[256];
+			size_t written = 0;
+			CHECK_EQUAL(ParserError_None, serializer.write(buffer, ENCODER_LENGTH, line, sizeof(line), written));
+			CHECK(NULL != strstr(string(line, written).c_str(), "STOP"));
+			uint8_t encoded[ENCODER_LENGTH];
+			memset(encoded, 0, sizeof(encoded));
+			CHECK_EQUAL(ParserError_None, encoder.encode(line, written, encoded, ENCODER_LENGTH));
+			MEMCMP_EQUAL(buffer, encoded, sizeof(buffer));
+		}
+	}
+}
+
+TEST(text_encoder, Test_errors)
+{
+	uint8_t buffer[ENCODER_LENGTH];
+	CHECK_EQUAL(ParserError_NullParameter, encode("{}", buffer));
+	CHECK_EQUAL(ParserError_InvalidDataType, encoder.compile(message.plan(), TextFormat_Undefined));
+	CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), TextFormat_Json));
+	CHECK_EQUAL(ParserError_ContainerTooSmall, encoder.encode("{}", 2, buffer, ENCODER_LENGTH - 1));
+	CHECK_EQUAL(ParserError_InvalidDataType, encoder.set_header("id", 2));
+
+	//-Values
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"id\":256}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"id\":-1}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"delta\":8}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"count\":12a}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"count\":true}", buffer));
+	CHECK_EQUAL(ParserError_UnknownKeyword, encode("{\"mode\":\"HALT\"}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"mode\":16}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"mode\":-1}", buffer));
+	CHECK_EQUAL(ParserError_ContainerTooSmall, encode("{\"name\":\"abcde\"}", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{\"name\":\"\\u0100\"}", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{\"name\":\"\\q\"}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"payload\":\"abc\"}", buffer));
+	CHECK_EQUAL(ParserError_InvalidNumber, encode("{\"payload\":\"abcg\"}", buffer));
+
+	//-Syntax
+	CHECK_EQUAL(ParserError_SyntaxError, encode("[]", buffer));
+	CHECK_EQUAL(ParserError_UnexpectedEnd, encode("", buffer));
+	CHECK_EQUAL(ParserError_UnexpectedEnd, encode("{\"id\":1", buffer));
+	CHECK_EQUAL(ParserError_UnexpectedEnd, encode("{\"id", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{id:1}", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{\"id\":{}}", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{\"id\":1} x", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("{\"id\" 1}", buffer));
+
+	//-Bulk: the failing line is not consumed
+	const char* text = "{\"id\":1}\n\n{\"id\":2}\n{\"id\":x}\n";
+	vector<uint8_t> buffers(4 * ENCODER_LENGTH);
+	size_t num_messages = 0;
+	size_t consumed = 0;
+	CHECK_EQUAL(ParserError_InvalidNumber, encoder.encode(text, strlen(text), buffers.data(), ENCODER_LENGTH, 4, num_messages, consumed));
+	CHECK_EQUAL(2u, num_messages);
+	CHECK_EQUAL(19u, consumed);
+
+	//-CSV
+	CHECK_EQUAL(ParserError_None, encoder.compile(message.plan(), TextFormat_Csv));
+	CHECK_EQUAL(ParserError_UnexpectedEnd, encode("1,2,\"RUN", buffer));
+	CHECK_EQUAL(ParserError_SyntaxError, encode("1,2,\"RUN\"x", buffer));
+	CHECK_EQUAL(ParserError_NullParameter, encoder.set_header(NULL, 0));
+}
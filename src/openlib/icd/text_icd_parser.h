@@ -0,0 +1,494 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_TEXT_ICD_PARSER_H
+#define OPENLIB_ICD_TEXT_ICD_PARSER_H
+
+//-Supporting libraries
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/icd/base_parser.h"
+#include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/message_icd.h"
+#include "openlib/utils/mapped_file.h"
+#include "openlib/utils/utils.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Single pass parser of text ICD definitions, tokenizes in place over the text (only the field
+         * and enum names are copied) and compiles the message once all its fields are added
+         *
+         * Format (whitespace separated, '#' starts a comment):
+         *   message <Name>                         (optional)
+         *       field <name> <data_type> <byte_offset> <bit_offset> <num_bits> <BE|LE>
+         *           enum <value> <label>           (after an enum field, the value shall fit the field)
+         *           rule range <min> <max>         (after an integral field, @see ValidationRule)
+         *           rule nonzero
+         *           rule reserved <mask>
+         *           rule enum                      (after an enum field)
+         *   end                                    (optional if the message ends with the text)
+         * Little-endian integers wider than a byte shall span whole bytes (@see buffer::is_valid_layout)
+         */
+        class TextICDParser : public BaseICDParser
+        {
+            public:
+                //-Constructor & Destructor
+                TextICDParser() : line_(0) {};
+                virtual ~TextICDParser() {};
+
+                //-Accessor
+                inline const size_t& line() const   { return line_; }
+
+                //-Ancillary functions
+                virtual inline ParserError parse(const std::string& text, MessageICD& icd_message);
+                virtual inline ParserError parse(const void* data, const size_t data_length, MessageICD& icd_message);
+                inline ParserError parse(const void* data, const size_t data_length, size_t& position, MessageICD& icd_message);
+                inline ParserError parse_file(const std::string& path, MessageICD& icd_message);
+
+            protected:
+                //-Types
+                struct Token
+                {
+                    const char* begin;
+                    size_t      length;
+                };
+                static const size_t MAX_TOKENS = 8;
+
+                //-Functions
+                static inline size_t next_line(const char*& cursor, const char* end, Token* tokens);
+                static inline size_t count_fields(const char* cursor, const char* end);
+                static inline bool equals(const Token& token, const char* literal);
+                static inline bool to_number(const Token& token, int64_t& value);
+                static inline DataType to_data_type(const Token& token);
+                inline ParserError parse_field(const Token* tokens, const size_t& num_tokens, MessageICD& icd_message, DataDescriptor*& data_descriptor);
+                static inline ParserError parse_rule(const Token* tokens, const size_t& num_tokens, DataDescriptor* data_descriptor);
+
+                //-Fields
+                size_t line_;   //-Last line parsed (1 based), the line of the error on failure
+
+        }; /*class TextICDParser*/
+
+        /**
+         * Parses the first message of a text
+         * @param text The ICD definition
+         * @param icd_message (output) The message (cleared first)
+         * @return ParserError (ParserError_None: SUCCESS, @see line for the line of the error)
+         */
+        ParserError TextICDParser::parse(const std::string& text, MessageICD& icd_message)
+        {
+            return parse(text.data(), text.length(), icd_message);
+        }
+
+        /**
+         * Parses the first message of a text
+         * @param data The ICD definition
+         * @param data_length The length of the definition
+         * @param icd_message (output) The message (cleared first)
+         * @return ParserError (ParserError_None: SUCCESS, @see line for the line of the error)
+         */
+        ParserError TextICDParser::parse(const void* data, const size_t data_length, MessageICD& icd_message)
+        {
+            size_t position = 0;
+            return parse(data, data_length, position, icd_message);
+        }
+
+        /**
+         * Parses the next message of a text holding several ones, call in sequence from position 0
+         * until ParserError_NotEnoughData (no message left) to load a whole ICD set
+         * @param data The ICD definition
+         * @param data_length The length of the definition
+         * @param position (input/output) The position where to start, past the parsed message on success
+         * @param icd_message (output) The message (cleared first)
+         * @return ParserError (ParserError_None: SUCCESS, @see line for the line of the error)
+         */
+        ParserError TextICDParser::parse(const void* data, const size_t data_length, size_t& position, MessageICD& icd_message)
+        {
+            clear(icd_message);
+            if (0 == position)
+            {
+                line_ = 0;
+            }
+            if (NULL == data && 0 != data_length)
+            {
+                return ParserError_NullParameter;
+            }
+            if (position > data_length)
+            {
+                return ParserError_NotEnoughData;
+            }
+
+            const char* begin = (const char*) data;
+            const char* cursor = begin + position;
+            const char* end = begin + data_length;
+            Token tokens[MAX_TOKENS];
+            DataDescriptor* data_descriptor = NULL;     //-Last field, target of the enum entries
+            reserve(icd_message, count_fields(cursor, end));
+            bool in_message = false;
+            bool found = false;
+            while (cursor < end)
+            {
+                const size_t num_tokens = next_line(cursor, end, tokens);
+                ++line_;
+                if (0 == num_tokens)
+                {
+                    continue;
+                }
+
+                if (equals(tokens[0], "field"))
+                {
+                    const ParserError error = parse_field(tokens, num_tokens, icd_message, data_descriptor);
+                    if (ParserError_None != error)
+                    {
+                        return error;
+                    }
+                    found = true;
+                }
+                else if (equals(tokens[0], "enum"))
+                {
+                    int64_t value = 0;
+                    if (NULL == data_descriptor || DataType_enum != data_descriptor->data_type() || 3 != num_tokens)
+                    {
+                        return ParserError_SyntaxError;
+                    }
+                    //-Values are zero extended, they shall fit the field
+                    const size_t num_bits = data_descriptor->num_bits();
+                    if (!to_number(tokens[1], value) || value < 0 || (num_bits < 64 && 0 != ((uint64_t) value >> num_bits)))
+                    {
+                        return ParserError_InvalidNumber;
+                    }
+                    data_descriptor->set_enum((int) (uint32_t) value, std::string(tokens[2].begin, tokens[2].length));
+                }
+                else if (equals(tokens[0], "rule"))
+                {
+                    const ParserError error = parse_rule(tokens, num_tokens, data_descriptor);
+                    if (ParserError_None != error)
+                    {
+                        return error;
+                    }
+                }
+                else if (equals(tokens[0], "message"))
+                {
+                    if (found || 2 != num_tokens)
+                    {
+                        return ParserError_SyntaxError;
+                    }
+                    in_message = true;
+                    found = true;
+                }
+                else if (equals(tokens[0], "end"))
+                {
+                    if (1 != num_tokens)
+                    {
+                        return ParserError_SyntaxError;
+                    }
+                    position = cursor - begin;
+                    return icd_message.compile();
+                }
+                else
+                {
+                    return ParserError_UnknownKeyword;
+                }
+            }
+
+            //-End of the text
+            position = data_length;
+            if (in_message)
+            {
+                return ParserError_UnexpectedEnd;
+            }
+            if (!found)
+            {
+                return ParserError_NotEnoughData;
+            }
+            return icd_message.compile();
+        }
+
+        /**
+         * Parses the first message of a file (mapped, not read)
+         * @param path The path to the ICD definition
+         * @param icd_message (output) The message (cleared first)
+         * @return ParserError (ParserError_None: SUCCESS, @see line for the line of the error)
+         */
+        ParserError TextICDParser::parse_file(const std::string& path, MessageICD& icd_message)
+        {
+            utils::MappedFile file;
+            if (!file.open(path))
+            {
+                clear(icd_message);
+                line_ = 0;
+                return ParserError_CannotOpen;
+            }
+            return parse(file.data(), file.length(), icd_message);
+        }
+
+        /**
+         * Splits the next line onto tokens, in place
+         * @param cursor (input/output) The start of the line, the start of the next line on return
+         * @param end The end of the text
+         * @param tokens (output) The tokens (up to MAX_TOKENS)
+         * @return size_t containing the number of tokens of the line (may exceed MAX_TOKENS)
+         */
+        size_t TextICDParser::next_line(const char*& cursor, const char* end, Token* tokens)
+        {
+            size_t num_tokens = 0;
+            while (cursor < end)
+            {
+                const char value = *cursor;
+                if ('\n' == value)
+                {
+                    ++cursor;
+                    break;
+                }
+                if (' ' == value || '\t' == value || '\r' == value)
+                {
+                    ++cursor;
+                    continue;
+                }
+                if ('#' == value)
+                {
+                    const void* new_line = memchr(cursor, '\n', end - cursor);
+                    cursor = (NULL == new_line) ? end : (const char*) new_line;
+                    continue;
+                }
+
+                const char* token_begin = cursor;
+                while (cursor < end && ' ' != *cursor && '\t' != *cursor && '\r' != *cursor && '\n' != *cursor && '#' != *cursor)
+                {
+                    ++cursor;
+                }
+                if (num_tokens < MAX_TOKENS)
+                {
+                    tokens[num_tokens].begin = token_begin;
+                    tokens[num_tokens].length = cursor - token_begin;
+                }
+                ++num_tokens;
+            }
+            return num_tokens;
+        }
+
+        /**
+         * Counts the field lines of the message starting at a position, up to its 'end' line (a hint to
+         * reserve the descriptors, the lines are not validated)
+         * @param cursor The start of the message
+         * @param end The end of the text
+         * @return size_t containing the number of field lines
+         */
+        size_t TextICDParser::count_fields(const char* cursor, const char* end)
+        {
+            size_t num_fields = 0;
+            while (cursor < end)
+            {
+                while (cursor < end && (' ' == *cursor || '\t' == *cursor))
+                {
+                    ++cursor;
+                }
+                const size_t length = end - cursor;
+                if (length > 5 && 0 == memcmp(cursor, "field", 5))
+                {
+                    ++num_fields;
+                }
+                else if (length >= 3 && 0 == memcmp(cursor, "end", 3) && (3 == length || isspace((unsigned char) cursor[3])))
+                {
+                    break;
+                }
+                const void* new_line = memchr(cursor, '\n', length);
+                if (NULL == new_line)
+                {
+                    break;
+                }
+                cursor = (const char*) new_line + 1;
+            }
+            return num_fields;
+        }
+
+        /**
+         * Compares a token with a literal
+         * @param token The token
+         * @param literal The literal (null terminated)
+         * @return true if equal
+         */
+        bool TextICDParser::equals(const Token& token, const char* literal)
+        {
+            return 0 == strncmp(token.begin, literal, token.length) && '\0' == literal[token.length];
+        }
+
+        /**
+         * Parses a rule line onto the last field
+         * @param tokens The tokens of the line
+         * @param num_tokens The number of tokens
+         * @param data_descriptor The last field (NULL if none)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextICDParser::parse_rule(const Token* tokens, const size_t& num_tokens, DataDescriptor* data_descriptor)
+        {
+            if (NULL == data_descriptor || num_tokens < 2)
+            {
+                return ParserError_SyntaxError;
+            }
+            if (DataType_ascii == data_descriptor->data_type() || DataType_binary == data_descriptor->data_type())
+            {
+                return ParserError_InvalidDataType;
+            }
+
+            int64_t first = 0;
+            int64_t second = 0;
+            if (equals(tokens[1], "range") && 4 == num_tokens)
+            {
+                if (!to_number(tokens[2], first) || !to_number(tokens[3], second) || first > second)
+                {
+                    return ParserError_InvalidNumber;
+                }
+                data_descriptor->add_rule(ValidationRule::range(first, second));
+            }
+            else if (equals(tokens[1], "nonzero") && 2 == num_tokens)
+            {
+                data_descriptor->add_rule(ValidationRule::non_zero());
+            }
+            else if (equals(tokens[1], "reserved") && 3 == num_tokens)
+            {
+                if (!to_number(tokens[2], first))
+                {
+                    return ParserError_InvalidNumber;
+                }
+                data_descriptor->add_rule(ValidationRule::reserved_zero((uint64_t) first));
+            }
+            else if (equals(tokens[1], "enum") && 2 == num_tokens && DataType_enum == data_descriptor->data_type())
+            {
+                data_descriptor->add_rule(ValidationRule::enum_set());
+            }
+            else
+            {
+                return ParserError_SyntaxError;
+            }
+            return ParserError_None;
+        }
+
+        /**
+         * Converts a decimal or hexadecimal (0x prefix) token, optionally negative
+         * @param token The token
+         * @param value (output) The value
+         * @return true if valid
+         */
+        bool TextICDParser::to_number(const Token& token, int64_t& value)
+        {
+            const char* digit = token.begin;
+            const char* end = token.begin + token.length;
+            const bool negative = (digit < end && '-' == *digit);
+            if (negative)
+            {
+                ++digit;
+            }
+
+            uint64_t magnitude = 0;
+            const bool is_hex = (end - digit > 2 && '0' == digit[0] && ('x' == digit[1] || 'X' == digit[1]));
+            if (!(is_hex ? utils::parse_hex(digit, end, magnitude) : utils::parse_int(digit, end, magnitude)) || magnitude > (uint64_t) INT64_MAX)
+            {
+                return false;
+            }
+            value = negative ? -((int64_t) magnitude) : (int64_t) magnitude;
+            return true;
+        }
+
+        /**
+         * Converts a data type token (@see to_string), without allocations
+         * @param token The token
+         * @return DataType, DataType_Undefined if unknown
+         */
+        DataType TextICDParser::to_data_type(const Token& token)
+        {
+            static const char* const NAMES[DataType_Max] = {"uint8", "int8", "uint16", "int16", "uint32", "int32", "enum", "ascii", "binary"};
+            for (int data_type = 0; data_type < DataType_Max; ++data_type)
+            {
+                if (equals(token, NAMES[data_type]))
+                {
+                    return (DataType) data_type;
+                }
+            }
+            return DataType_Undefined;
+        }
+
+        /**
+         * Parses a field line onto a data descriptor owned by the message
+         * @param tokens The tokens of the line
+         * @param num_tokens The number of tokens of the line
+         * @param icd_message The message
+         * @param data_descriptor (output) The data descriptor, NULL on failure
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextICDParser::parse_field(const Token* tokens, const size_t& num_tokens, MessageICD& icd_message, DataDescriptor*& data_descriptor)
+        {
+            data_descriptor = NULL;
+            if (7 != num_tokens)
+            {
+                return ParserError_SyntaxError;
+            }
+
+            const DataType data_type = to_data_type(tokens[2]);
+            if (DataType_Undefined == data_type)
+            {
+                return ParserError_InvalidDataType;
+            }
+            int64_t byte_offset = 0;
+            int64_t bit_offset = 0;
+            int64_t num_bits = 0;
+            if (!to_number(tokens[3], byte_offset) || !to_number(tokens[4], bit_offset) || !to_number(tokens[5], num_bits) ||
+                byte_offset < 0 || bit_offset < 0 || num_bits < 0)
+            {
+                return ParserError_InvalidNumber;
+            }
+            Endianess endianess;
+            if (equals(tokens[6], "BE"))
+            {
+                endianess = Endianess_BigEndian;
+            }
+            else if (equals(tokens[6], "LE"))
+            {
+                endianess = Endianess_LittleEndian;
+            }
+            else
+            {
+                return ParserError_SyntaxError;
+            }
+
+            //-Byte arrays and little-endian integers span whole bytes (integer widths are checked on compile)
+            if (0 == num_bits || ((DataType_ascii == data_type || DataType_binary == data_type) && 0 != num_bits % 8) ||
+                !buffer::is_valid_layout((size_t) num_bits, endianess))
+            {
+                return ParserError_InvalidLayout;
+            }
+
+            //-Built on the descriptor blocks of the message
+            data_descriptor = emplace(icd_message, data_type, std::string(tokens[1].begin, tokens[1].length),
+                                      (size_t) byte_offset, (size_t) bit_offset, (size_t) num_bits, endianess);
+            return (NULL == data_descriptor) ? ParserError_DuplicatedField : ParserError_None;
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_TEXT_ICD_PARSER_H*/
@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+/**
+ * Same layout as the message_icd tests
+ */
+static const char* TEST_ICD =
+	"# Test message\n"
+	"message Test\n"
+	"    field id      uint8   0 0 8  BE\n"
+	"    field count   int16   1 0 16 LE\n"
+	"    field flags   uint8   3 0 3  BE   # trailing comment\n"
+	"    field delta   int8    3 3 5  BE\n"
+	"    field range   uint32  4 0 20 BE\n"
+	"    field mode    enum    6 4 4  BE\n"
+	"        enum 0 IDLE\n"
+	"        enum 0x9 RUN\n"
+	"    field payload binary  7 0 32 BE\r\n"
+	"end\n";
+
+TEST_GROUP(text_icd_parser)
+{
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(text_icd_parser, Test_parse)
+{
+	TextICDParser parser;
+	MessageICD message;
+	CHECK_EQUAL(ParserError_None, parser.parse(string(TEST_ICD), message));
+	CHECK_EQUAL(7u, message.size());
+	CHECK_EQUAL(11u, message.plan().min_buffer_length());
+
+	const uint8_t wire[11] = {0x7E, 0x34, 0x92, 0b10111010, 0xAB, 0xCD, 0xE9, 0xDE, 0xAD, 0xBE, 0xEF};
+	CHECK_EQUAL(ParserError_None, message.decode(wire, sizeof(wire)));
+	CHECK_EQUAL(0x7E, message.field(message.find("id"))->uint8());
+	CHECK_EQUAL((int16_t) 0x9234, message.field(message.find("count"))->int16());
+	CHECK_EQUAL(-6, message.field(message.find("delta"))->int8());
+	CHECK_EQUAL(0xABCDEu, message.field(message.find("range"))->uint32());
+	CHECK_EQUAL(9, message.field(message.find("mode"))->enum_val());
+	CHECK_EQUAL(0xEF, message.field(message.find("payload"))->as_binary()[3]);
+
+	bool found = false;
+	STRCMP_EQUAL("RUN", message.field(message.find("mode"))->get_enum(9, found).c_str());
+	CHECK(found);
+
+	//-Re-parsing replaces the fields
+	CHECK_EQUAL(ParserError_None, parser.parse(string("field a uint16 0 0 16 BE"), message));
+	CHECK_EQUAL(1u, message.size());
+	CHECK_EQUAL(0u, message.find("a"));
+}
+
+TEST(text_icd_parser, Test_parse_set)
+{
+	const string text = string(TEST_ICD) + "\n\nmessage Other\n field a uint8 0 0 8 BE\nend\n# done\n";
+	TextICDParser parser;
+	MessageICD message;
+	size_t position = 0;
+	CHECK_EQUAL(ParserError_None, parser.parse(text.data(), text.length(), position, message));
+	CHECK_EQUAL(7u, message.size());
+	CHECK_EQUAL(ParserError_None, parser.parse(text.data(), text.length(), position, message));
+	CHECK_EQUAL(1u, message.size());
+	CHECK_EQUAL(ParserError_NotEnoughData, parser.parse(text.data(), text.length(), position, message));
+	CHECK_EQUAL(text.length(), position);
+
+	//-Smaller and larger messages reuse the descriptors of the previous ones
+	string wide = "message Wide\n";
+	for (size_t i = 0; i < 40; ++i)
+	{
+		wide += " field f" + to_string(i) + " uint8 " + to_string(i) + " 0 8 BE\n";
+	}
+	wide += "end\n";
+	for (size_t pass = 0; pass < 2; ++pass)
+	{
+		CHECK_EQUAL(ParserError_None, parser.parse(wide, message));
+		CHECK_EQUAL(40u, message.size());
+		uint8_t buffer[40];
+		for (size_t i = 0; i < sizeof(buffer); ++i)
+		{
+			buffer[i] = (uint8_t) (3 * i);
+		}
+		CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+		CHECK_EQUAL(39u, message.find("f39"));
+		CHECK_EQUAL(117, *message.field(39)->as_uint8());
+		CHECK_EQUAL(ParserError_None, parser.parse(string(TEST_ICD), message));
+		CHECK_EQUAL(7u, message.size());
+	}
+}
+
+TEST(text_icd_parser, Test_errors)
+{
+	TextICDParser parser;
+	MessageICD message;
+	CHECK_EQUAL(ParserError_NullParameter, parser.parse(NULL, 1, message));
+	CHECK_EQUAL(ParserError_NotEnoughData, parser.parse(string(" # nothing\n\n"), message));
+	CHECK_EQUAL(ParserError_UnknownKeyword, parser.parse(string("message A\n\n  feld a uint8 0 0 8 BE\n"), message));
+	CHECK_EQUAL(3u, parser.line());
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("field a uint8 0 0 8"), message));
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("field a uint8 0 0 8 XE"), message));
+	CHECK_EQUAL(ParserError_InvalidDataType, parser.parse(string("field a uint64 0 0 8 BE"), message));
+	CHECK_EQUAL(ParserError_InvalidNumber, parser.parse(string("field a uint8 0 -1 8 BE"), message));
+	CHECK_EQUAL(ParserError_InvalidNumber, parser.parse(string("field a uint8 0x 0 8 BE"), message));
+	CHECK_EQUAL(ParserError_InvalidLayout, parser.parse(string("field a binary 0 0 12 BE"), message));
+	CHECK_EQUAL(ParserError_InvalidLayout, parser.parse(string("field x uint8 0 0 4 BE\nfield a uint16 0 4 12 LE\n"), message));
+	CHECK_EQUAL(ParserError_InvalidNumber, parser.parse(string("field a enum 0 0 4 BE\nenum 16 SIXTEEN\n"), message));
+	CHECK_EQUAL(ParserError_InvalidNumber, parser.parse(string("field a enum 0 0 4 BE\nenum -1 LOST\n"), message));
+	CHECK_EQUAL(2u, parser.line());
+	CHECK_EQUAL(ParserError_ContainerTooSmall, parser.parse(string("field a uint8 0 0 9 BE"), message));
+	CHECK_EQUAL(ParserError_DuplicatedField, parser.parse(string("field a uint8 0 0 8 BE\nfield b uint8 0 0 8 BE\n"), message));
+	CHECK_EQUAL(2u, parser.line());
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("field a uint8 0 0 8 BE\nenum 1 ONE\n"), message));
+	CHECK_EQUAL(ParserError_UnexpectedEnd, parser.parse(string("message A\nfield a uint8 0 0 8 BE\n"), message));
+	CHECK_EQUAL(ParserError_SyntaxError, parser.parse(string("message A\nmessage B\n"), message));
+	CHECK_EQUAL(0u, message.size());
+	CHECK_EQUAL(ParserError_CannotOpen, parser.parse_file("/nonexistent/file.icd", message));
+}
+
+TEST(text_icd_parser, Test_parse_file)
+{
+	char path[] = "/tmp/text_icd_parser_XXXXXX";
+	FILE* file = fdopen(mkstemp(path), "w");
+	CHECK(NULL != file);
+	fputs(TEST_ICD, file);
+	fclose(file);
+
+	TextICDParser parser;
+	MessageICD message;
+	CHECK_EQUAL(ParserError_None, parser.parse_file(path, message));
+	CHECK_EQUAL(7u, message.size());
+	remove(path);
+}
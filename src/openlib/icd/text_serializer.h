@@ -0,0 +1,562 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_TEXT_SERIALIZER_H
+#define OPENLIB_ICD_TEXT_SERIALIZER_H
+
+//-Supporting libraries
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/icd/data_descriptor.h"
+#include "openlib/icd/enum_table.h"
+#include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/enum/text_format.h"
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/message_record.h"
+#include "openlib/icd/message_view.h"
+#include "openlib/utils/hex_codec.h"
+#include "openlib/utils/utils.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Renders messages as text lines (JSON objects or CSV rows) straight onto a caller buffer: the field
+         * name prefixes and the enumeration labels are escaped once when compiled, the numbers rendered
+         * with std::to_chars. No locale, no stream, no allocation per message
+         *
+         *   JSON: {"id":7,"mode":"RUN","name":"abc","payload":"0a1b"}
+         *   CSV:  7,RUN,abc,0a1b            (@see header for the names row)
+         *
+         * Enumeration values without a label are rendered as numbers, ascii fields end at the first null
+         * character and binary fields are rendered in hexadecimal
+         */
+        class TextSerializer
+        {
+            public:
+                //-Constructor & Destructor
+                TextSerializer() : plan_(NULL), format_(TextFormat_Json) {};
+                ~TextSerializer() {};
+
+                //-Accessor
+                inline const MessagePlan* plan() const          { return plan_;     }
+                inline const TextFormat& format() const         { return format_;   }
+                inline const std::string& header() const        { return header_;   }
+
+                //-Ancillary functions
+                inline ParserError compile(const MessagePlan& plan, const TextFormat& format);
+                inline void clear();
+                inline ParserError write(const uint8_t* buffer, const size_t& buffer_length, char* output, const size_t& output_length, size_t& written) const;
+                inline ParserError write(const MessageView& view, char* output, const size_t& output_length, size_t& written) const;
+                inline ParserError write(const MessageRecord& record, char* output, const size_t& output_length, size_t& written) const;
+                inline ParserError write(const MessageICD& icd_message, char* output, const size_t& output_length, size_t& written) const;
+
+            protected:
+                /**
+                 * Rendering of a field
+                 */
+                struct Column
+                {
+                    size_t      prefix_offset;  //-Within the prefix pool ('{"name":' / ',"name":' / ',')
+                    size_t      prefix_length;
+                    EnumTable   labels;         //-Rendered enumeration labels (quoted / escaped)
+                };
+
+                /**
+                 * Bounded output cursor
+                 */
+                struct Output
+                {
+                    char*   cursor;
+                    char*   end;
+
+                    inline bool append(const char* text, const size_t& text_length)
+                    {
+                        if ((size_t) (end - cursor) < text_length)
+                        {
+                            return false;
+                        }
+                        memcpy(cursor, text, text_length);
+                        cursor += text_length;
+                        return true;
+                    }
+                    inline bool put(const char& character)
+                    {
+                        if (cursor == end)
+                        {
+                            return false;
+                        }
+                        *cursor++ = character;
+                        return true;
+                    }
+                };
+
+                /**
+                 * Values straight from a message on the wire
+                 */
+                struct WireSource
+                {
+                    const uint8_t*  buffer;
+                    size_t          buffer_length;
+
+                    inline int64_t integer(const FieldOperation& operation) const
+                    {
+                        return MessagePlan::container_value(operation, MessagePlan::decode_field(operation, buffer, buffer_length));
+                    }
+                    inline const uint8_t* bytes(const FieldOperation& operation) const
+                    {
+                        return (0 == operation.bit_offset) ? buffer + operation.byte_index : NULL;
+                    }
+                    inline uint8_t byte(const FieldOperation& operation, const size_t& byte_idx) const
+                    {
+                        if (0 == operation.bit_offset)
+                        {
+                            return buffer[operation.byte_index + byte_idx];
+                        }
+                        return (uint8_t) buffer::extract_raw(buffer + operation.byte_index, buffer_length - operation.byte_index, BYTE2BIT(byte_idx) + operation.bit_offset, 8);
+                    }
+                };
+
+                /**
+                 * Decoded values, from a value record or from the descriptors (NULL record)
+                 */
+                struct ValueSource
+                {
+                    const uint8_t*  record;
+
+                    inline const uint8_t* data(const FieldOperation& operation) const
+                    {
+                        return (NULL == record) ? operation.data : record + operation.data_offset;
+                    }
+                    inline int64_t integer(const FieldOperation& operation) const
+                    {
+                        return MessagePlan::container_value(operation, MessagePlan::load_value(data(operation), operation.data_length));
+                    }
+                    inline const uint8_t* bytes(const FieldOperation& operation) const
+                    {
+                        return data(operation);
+                    }
+                    inline uint8_t byte(const FieldOperation& operation, const size_t& byte_idx) const
+                    {
+                        return data(operation)[byte_idx];
+                    }
+                };
+
+                //-Functions
+                template <typename Source>
+                inline ParserError render(const Source& source, char* output, const size_t& output_length, size_t& written) const;
+                template <typename Source>
+                inline bool render_ascii(const Source& source, const FieldOperation& operation, Output& output) const;
+                template <typename Source>
+                inline bool render_binary(const Source& source, const FieldOperation& operation, Output& output) const;
+                inline void escape(const char* text, const size_t& text_length, std::string& output) const;
+
+                //-Fields
+                std::vector<Column> columns_;
+                std::string         prefixes_;  //-Prefix pool
+                std::string         header_;    //-CSV names row
+                const MessagePlan*  plan_;
+                TextFormat          format_;
+
+        }; /*class TextSerializer*/
+
+        /**
+         * Lays out the rendering of the fields of a plan
+         * IMPORTANT: the plan (and its descriptors) must outlive the serializer (or the next compile)
+         * @param plan The compiled plan (@see MessageICD::compile)
+         * @param format The text format
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextSerializer::compile(const MessagePlan& plan, const TextFormat& format)
+        {
+            clear();
+            if (TextFormat_Json != format && TextFormat_Csv != format)
+            {
+                return ParserError_InvalidDataType;
+            }
+            format_ = format;
+
+            const MessagePlan::FieldOperationVector& operations = plan.operations();
+            columns_.resize(operations.size());
+            std::string escaped;
+            for (size_t field_idx = 0; field_idx < operations.size(); ++field_idx)
+            {
+                const DataDescriptor& descriptor = *operations[field_idx].descriptor;
+                Column& column = columns_[field_idx];
+
+                escaped.clear();
+                escape(descriptor.name().data(), descriptor.name().length(), escaped);
+                column.prefix_offset = prefixes_.size();
+                if (TextFormat_Json == format_)
+                {
+                    prefixes_ += (0 == field_idx) ? "{" : ",";
+                    prefixes_ += escaped;
+                    prefixes_ += ":";
+                }
+                else if (0 != field_idx)
+                {
+                    prefixes_ += ",";
+                }
+                column.prefix_length = prefixes_.size() - column.prefix_offset;
+                header_ += ((0 == field_idx) ? "" : ",") + escaped;
+
+                const EnumTable& enum_table = descriptor.enum_table();
+                for (size_t enum_idx = 0; enum_idx < enum_table.size(); ++enum_idx)
+                {
+                    const EnumTable::Entry& entry = enum_table.entries()[enum_idx];
+                    escaped.clear();
+                    escape(enum_table.label(entry), entry.label_length, escaped);
+                    column.labels.set(entry.value, escaped);
+                }
+                column.labels.build();
+            }
+            if (TextFormat_Csv == format_)
+            {
+                header_ += "\n";
+            }
+            else
+            {
+                header_.clear();
+            }
+            plan_ = &plan;
+            return ParserError_None;
+        }
+
+        /**
+         * Clears the layout
+         */
+        void TextSerializer::clear()
+        {
+            columns_.clear();
+            prefixes_.clear();
+            header_.clear();
+            plan_ = NULL;
+        }
+
+        /**
+         * Renders a message on the wire (the fields are extracted straight from the buffer)
+         * @param buffer The message
+         * @param buffer_length The length of the buffer
+         * @param output The output
+         * @param output_length The length of the output
+         * @param written (output) The number of characters written, including the new line (not null terminated)
+         * @return ParserError (ParserError_None: SUCCESS, ParserError_ContainerTooSmall if the output is too short)
+         */
+        ParserError TextSerializer::write(const uint8_t* buffer, const size_t& buffer_length, char* output, const size_t& output_length, size_t& written) const
+        {
+            written = 0;
+            if (NULL == plan_ || NULL == buffer)
+            {
+                return ParserError_NullParameter;
+            }
+            if (buffer_length < plan_->min_buffer_length())
+            {
+                return ParserError_NotEnoughData;
+            }
+            const WireSource source = {buffer, buffer_length};
+            return render(source, output, output_length, written);
+        }
+
+        /**
+         * Renders a lazy view of a message
+         * @param view The view (of the plan of the serializer)
+         * @param output The output
+         * @param output_length The length of the output
+         * @param written (output) The number of characters written, including the new line (not null terminated)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextSerializer::write(const MessageView& view, char* output, const size_t& output_length, size_t& written) const
+        {
+            written = 0;
+            if (view.plan() != plan_)
+            {
+                return ParserError_InvalidLayout;
+            }
+            return write(view.buffer(), view.buffer_length(), output, output_length, written);
+        }
+
+        /**
+         * Renders a decoded message
+         * @param record The values (decoded with the plan of the serializer)
+         * @param output The output
+         * @param output_length The length of the output
+         * @param written (output) The number of characters written, including the new line (not null terminated)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextSerializer::write(const MessageRecord& record, char* output, const size_t& output_length, size_t& written) const
+        {
+            written = 0;
+            if (NULL == plan_ || NULL == record.data())
+            {
+                return ParserError_NullParameter;
+            }
+            if (record.plan() != plan_)
+            {
+                return ParserError_InvalidLayout;
+            }
+            const ValueSource source = {record.data()};
+            return render(source, output, output_length, written);
+        }
+
+        /**
+         * Renders the values of a message
+         * @param icd_message The message (compiled, the plan of the serializer)
+         * @param output The output
+         * @param output_length The length of the output
+         * @param written (output) The number of characters written, including the new line (not null terminated)
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        ParserError TextSerializer::write(const MessageICD& icd_message, char* output, const size_t& output_length, size_t& written) const
+        {
+            written = 0;
+            if (NULL == plan_)
+            {
+                return ParserError_NullParameter;
+            }
+            if (&icd_message.plan() != plan_)
+            {
+                return ParserError_InvalidLayout;
+            }
+            const ValueSource source = {NULL};
+            return render(source, output, output_length, written);
+        }
+
+        /**
+         * Renders the fields of a message
+         * @tparam Source The values (WireSource, ValueSource)
+         * @param source The values
+         * @param output The output
+         * @param output_length The length of the output
+         * @param written (output) The number of characters written
+         * @return ParserError (ParserError_None: SUCCESS)
+         */
+        template <typename Source>
+        ParserError TextSerializer::render(const Source& source, char* output, const size_t& output_length, size_t& written) const
+        {
+            if (NULL == output)
+            {
+                return ParserError_NullParameter;
+            }
+            Output out = {output, output + output_length};
+            const MessagePlan::FieldOperationVector& operations = plan_->operations();
+            bool fits = true;
+            for (size_t field_idx = 0; field_idx < operations.size() && fits; ++field_idx)
+            {
+                const FieldOperation& operation = operations[field_idx];
+                const Column& column = columns_[field_idx];
+                fits = out.append(prefixes_.data() + column.prefix_offset, column.prefix_length);
+                if (FieldOperationKind_Integer == operation.kind)
+                {
+                    const int64_t value = source.integer(operation);
+                    const EnumTable::Entry* entry = column.labels.empty() ? NULL : column.labels.find((int) value);
+                    if (NULL != entry)
+                    {
+                        fits = fits && out.append(column.labels.label(*entry), entry->label_length);
+                    }
+                    else if (fits)
+                    {
+                        const size_t length = utils::format_int(out.cursor, out.end - out.cursor, value);
+                        fits = (0 != length);
+                        out.cursor += length;
+                    }
+                }
+                else if (DataType_ascii == operation.descriptor->data_type())
+                {
+                    fits = fits && render_ascii(source, operation, out);
+                }
+                else
+                {
+                    fits = fits && render_binary(source, operation, out);
+                }
+            }
+            if (TextFormat_Json == format_)
+            {
+                fits = fits && (!operations.empty() || out.put('{')) && out.put('}');
+            }
+            fits = fits && out.put('\n');
+            if (!fits)
+            {
+                return ParserError_ContainerTooSmall;
+            }
+            written = out.cursor - output;
+            return ParserError_None;
+        }
+
+        /**
+         * Renders an ascii field (up to the first null character), JSON escaped or CSV quoted if needed
+         * @param source The values
+         * @param operation The field operation
+         * @param output The output
+         * @return true if it fits
+         */
+        template <typename Source>
+        bool TextSerializer::render_ascii(const Source& source, const FieldOperation& operation, Output& output) const
+        {
+            static const char HEX[] = "0123456789abcdef";
+            size_t length = 0;
+            bool quote = (TextFormat_Json == format_);
+            while (length < operation.data_length)
+            {
+                const char character = (char) source.byte(operation, length);
+                if ('\0' == character)
+                {
+                    break;
+                }
+                quote = quote || ',' == character || '"' == character || '\n' == character || '\r' == character;
+                ++length;
+            }
+
+            bool fits = !quote || output.put('"');
+            for (size_t i = 0; i < length && fits; ++i)
+            {
+                const uint8_t character = source.byte(operation, i);
+                if (TextFormat_Csv == format_)
+                {
+                    fits = ('"' != character || output.put('"')) && output.put((char) character);
+                }
+                else if ('"' == character || '\\' == character)
+                {
+                    fits = output.put('\\') && output.put((char) character);
+                }
+                else if (character < 0x20 || character >= 0x7F)
+                {
+                    const char unicode[6] = {'\\', 'u', '0', '0', HEX[character >> 4], HEX[character & 0x0F]};
+                    fits = output.append(unicode, sizeof(unicode));
+                }
+                else
+                {
+                    fits = output.put((char) character);
+                }
+            }
+            return fits && (!quote || output.put('"'));
+        }
+
+        /**
+         * Renders a binary field in hexadecimal (quoted in JSON), contiguous bytes through hex_codec
+         * @param source The values
+         * @param operation The field operation
+         * @param output The output
+         * @return true if it fits
+         */
+        template <typename Source>
+        bool TextSerializer::render_binary(const Source& source, const FieldOperation& operation, Output& output) const
+        {
+            static const char HEX[] = "0123456789abcdef";
+            const bool quote = (TextFormat_Json == format_);
+            if ((size_t) (output.end - output.cursor) < 2 * operation.data_length + (quote ? 2 : 0))
+            {
+                return false;
+            }
+            if (quote)
+            {
+                *output.cursor++ = '"';
+            }
+            const uint8_t* bytes = source.bytes(operation);
+            if (NULL != bytes)
+            {
+                hex_codec::encode(bytes, operation.data_length, output.cursor);
+                output.cursor += 2 * operation.data_length;
+            }
+            else
+            {
+                //-Unaligned field
+                for (size_t i = 0; i < operation.data_length; ++i)
+                {
+                    const uint8_t value = source.byte(operation, i);
+                    *output.cursor++ = HEX[value >> 4];
+                    *output.cursor++ = HEX[value & 0x0F];
+                }
+            }
+            if (quote)
+            {
+                *output.cursor++ = '"';
+            }
+            return true;
+        }
+
+        /**
+         * Escapes a name or a label (JSON string, CSV field quoted if needed)
+         * @param text The text
+         * @param text_length The length of the text
+         * @param output (output) The escaped text, appended
+         */
+        void TextSerializer::escape(const char* text, const size_t& text_length, std::string& output) const
+        {
+            static const char HEX[] = "0123456789abcdef";
+            if (TextFormat_Csv == format_)
+            {
+                bool quote = false;
+                for (size_t i = 0; i < text_length; ++i)
+                {
+                    quote = quote || ',' == text[i] || '"' == text[i] || '\n' == text[i] || '\r' == text[i];
+                }
+                if (quote)
+                {
+                    output += '"';
+                }
+                for (size_t i = 0; i < text_length; ++i)
+                {
+                    if ('"' == text[i])
+                    {
+                        output += '"';
+                    }
+                    output += text[i];
+                }
+                if (quote)
+                {
+                    output += '"';
+                }
+                return;
+            }
+            output += '"';
+            for (size_t i = 0; i < text_length; ++i)
+            {
+                const uint8_t character = (uint8_t) text[i];
+                if ('"' == character || '\\' == character)
+                {
+                    output += '\\';
+                    output += (char) character;
+                }
+                else if (character < 0x20 || character >= 0x7F)
+                {
+                    output += "\\u00";
+                    output += HEX[character >> 4];
+                    output += HEX[character & 0x0F];
+                }
+                else
+                {
+                    output += (char) character;
+                }
+            }
+            output += '"';
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_TEXT_SERIALIZER_H*/
@@ -0,0 +1,152 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "text_serializer.h"
+#include "text_icd_parser.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+
+static const char* SERIALIZER_ICD =
+	"field id      uint8   0 0 8  BE\n"
+	"field count   int16   1 0 16 LE\n"
+	"field mode    enum    3 0 4  BE\n"
+	"    enum 1 RUN\n"
+	"    enum 2 A,B\n"
+	"    enum 9 STOP\n"
+	"    enum 15 FAULT\n"
+	"field name    ascii   4 0 32 BE\n"
+	"field payload binary  8 4 16 BE\n";
+static const size_t SERIALIZER_LENGTH = 11;
+static const size_t SERIALIZER_OUTPUT = 256;
+
+TEST_GROUP(text_serializer)
+{
+	MessageICD message;
+	TextSerializer serializer;
+	char output[SERIALIZER_OUTPUT];
+	size_t written;
+
+	void setup()
+	{
+		TextICDParser parser;
+		CHECK_EQUAL(ParserError_None, parser.parse(string(SERIALIZER_ICD), message));
+		CHECK_EQUAL(ParserError_None, message.compile());
+		written = 0;
+	}
+
+	void teardown()
+	{
+	}
+
+	/**
+	 * Renders a message on the wire
+	 */
+	string render(const uint8_t* buffer)
+	{
+		const ParserError error = serializer.write(buffer, SERIALIZER_LENGTH, output, sizeof(output), written);
+		return (ParserError_None == error) ? string(output, written) : to_string(error);
+	}
+};
+
+TEST(text_serializer, Test_json)
+{
+	CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), TextFormat_Json));
+	CHECK(serializer.header().empty());
+
+	//-id 7, count -100, mode RUN, name a"b, payload 0xABCD (unaligned)
+	const uint8_t buffer[SERIALIZER_LENGTH] = {7, 0x9C, 0xFF, 0x10, 'a', '"', 'b', 0, 0x0A, 0xBC, 0xD0};
+	STRCMP_EQUAL("{\"id\":7,\"count\":-100,\"mode\":\"RUN\",\"name\":\"a\\\"b\",\"payload\":\"abcd\"}\n", render(buffer).c_str());
+
+	//-Enumerations with the top bit set, unknown value, control and non ascii characters
+	const uint8_t other[SERIALIZER_LENGTH] = {255, 0xFF, 0x7F, 0xF0, '\n', 0xE9, '\\', 'x', 0, 0, 0};
+	STRCMP_EQUAL("{\"id\":255,\"count\":32767,\"mode\":\"FAULT\",\"name\":\"\\u000a\\u00e9\\\\x\",\"payload\":\"0000\"}\n", render(other).c_str());
+	const uint8_t stop[SERIALIZER_LENGTH] = {1, 0, 0, 0x90};
+	STRCMP_EQUAL("{\"id\":1,\"count\":0,\"mode\":\"STOP\",\"name\":\"\",\"payload\":\"0000\"}\n", render(stop).c_str());
+	const uint8_t unknown[SERIALIZER_LENGTH] = {0, 0, 0, 0x50};
+	STRCMP_EQUAL("{\"id\":0,\"count\":0,\"mode\":5,\"name\":\"\",\"payload\":\"0000\"}\n", render(unknown).c_str());
+}
+
+TEST(text_serializer, Test_csv)
+{
+	CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), TextFormat_Csv));
+	STRCMP_EQUAL("id,count,mode,name,payload\n", serializer.header().c_str());
+
+	const uint8_t buffer[SERIALIZER_LENGTH] = {7, 0x9C, 0xFF, 0x20, 'a', '"', 'b', 0, 0x0A, 0xBC, 0xD0};
+	STRCMP_EQUAL("7,-100,\"A,B\",\"a\"\"b\",abcd\n", render(buffer).c_str());
+	const uint8_t plain[SERIALIZER_LENGTH] = {1, 2, 0, 0x10, 'a', 'b', 'c', 'd', 0x0F, 0xFF, 0xF0};
+	STRCMP_EQUAL("1,2,RUN,abcd,ffff\n", render(plain).c_str());
+}
+
+TEST(text_serializer, Test_sources)
+{
+	CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), TextFormat_Json));
+	const uint8_t buffer[SERIALIZER_LENGTH] = {7, 0x9C, 0xFF, 0xF0, 'a', '"', 'b', 0, 0x0A, 0xBC, 0xD0};
+	const string expected = render(buffer);
+
+	//-Lazy view, value record and descriptors render the same line
+	CHECK_EQUAL(ParserError_None, serializer.write(MessageView(buffer, sizeof(buffer), message), output, sizeof(output), written));
+	STRCMP_EQUAL(expected.c_str(), string(output, written).c_str());
+
+	MessageRecord record(message);
+	CHECK_EQUAL(ParserError_None, record.decode(buffer, sizeof(buffer)));
+	CHECK_EQUAL(ParserError_None, serializer.write(record, output, sizeof(output), written));
+	STRCMP_EQUAL(expected.c_str(), string(output, written).c_str());
+
+	CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+	CHECK_EQUAL(ParserError_None, serializer.write(message, output, sizeof(output), written));
+	STRCMP_EQUAL(expected.c_str(), string(output, written).c_str());
+}
+
+TEST(text_serializer, Test_errors)
+{
+	const uint8_t buffer[SERIALIZER_LENGTH] = {7, 0x9C, 0xFF, 0x20, 'a', '"', 'b', 0, 0x0A, 0xBC, 0xD0};
+	CHECK_EQUAL(ParserError_NullParameter, serializer.write(buffer, sizeof(buffer), output, sizeof(output), written));
+	CHECK_EQUAL(ParserError_InvalidDataType, serializer.compile(message.plan(), TextFormat_Undefined));
+
+	//-Every truncated output is rejected
+	for (size_t format = TextFormat_Json; format <= TextFormat_Csv; ++format)
+	{
+		CHECK_EQUAL(ParserError_None, serializer.compile(message.plan(), (TextFormat) format));
+		const size_t length = render(buffer).length();
+		for (size_t output_length = 0; output_length < length; ++output_length)
+		{
+			CHECK_EQUAL(ParserError_ContainerTooSmall, serializer.write(buffer, sizeof(buffer), output, output_length, written));
+			CHECK_EQUAL(0u, written);
+		}
+	}
+
+	CHECK_EQUAL(ParserError_NotEnoughData, serializer.write(buffer, sizeof(buffer) - 1, output, sizeof(output), written));
+	CHECK_EQUAL(ParserError_NullParameter, serializer.write(buffer, sizeof(buffer), NULL, sizeof(output), written));
+	MessageICD other;
+	TextICDParser parser;
+	CHECK_EQUAL(ParserError_None, parser.parse(string("field a uint8 0 0 8 BE\n"), other));
+	CHECK_EQUAL(ParserError_None, other.compile());
+	CHECK_EQUAL(ParserError_InvalidLayout, serializer.write(other, output, sizeof(output), written));
+	CHECK_EQUAL(ParserError_InvalidLayout, serializer.write(MessageView(buffer, sizeof(buffer), other), output, sizeof(output), written));
+}
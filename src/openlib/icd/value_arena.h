@@ -0,0 +1,150 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_ICD_VALUE_ARENA_H
+#define OPENLIB_ICD_VALUE_ARENA_H
+
+//-Supporting libraries
+#include "openlib/common.h"
+#include "openlib/non-copyable/non_copyable.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace icd
+    {
+        /**
+         * Contiguous, cache line aligned block holding the values of a message (single allocation)
+         * Values are carved with a bump pointer, the whole block is released at once
+         */
+        class ValueArena: public NonCopyable
+        {
+            public:
+                static const size_t ALIGNMENT = 64;
+
+                //-Constructor & Destructor
+                ValueArena() : block_(NULL), data_(NULL), capacity_(0), used_(0) {};
+                virtual ~ValueArena() { release(); };
+
+                //-Accessor
+                inline uint8_t* data() const                { return data_;     }
+                inline const size_t& capacity() const       { return capacity_; }
+                inline const size_t& used() const           { return used_;     }
+
+                //-Ancillary functions
+                inline void reserve(const size_t& capacity);
+                inline uint8_t* allocate(const size_t& length, const size_t& alignment);
+                inline void reset();
+                inline void release();
+                inline void swap(ValueArena& other);
+
+                /**
+                 * Rounds up an offset to the given alignment
+                 * @param offset The offset
+                 * @param alignment The alignment (power of 2, 0 means 1)
+                 * @return size_t containing the aligned offset
+                 */
+                static inline size_t align(const size_t& offset, const size_t& alignment)
+                {
+                    return (alignment <= 1) ? offset : ((offset + alignment - 1) & ~(alignment - 1));
+                }
+
+            private:
+                //-Fields
+                uint8_t*    block_;     //-Allocated block
+                uint8_t*    data_;      //-Aligned start of the block
+                size_t      capacity_;
+                size_t      used_;
+
+        }; /*class ValueArena*/
+
+        /**
+         * Allocates (zeroed) the block if the current one is smaller, previous allocations are dropped
+         * @param capacity The capacity in bytes
+         */
+        void ValueArena::reserve(const size_t& capacity)
+        {
+            if (capacity > capacity_ || NULL == data_)
+            {
+                release();
+                block_ = new uint8_t[capacity + ALIGNMENT]();
+                data_ = block_ + (ALIGNMENT - (reinterpret_cast<uintptr_t> (block_) % ALIGNMENT)) % ALIGNMENT;
+                capacity_ = capacity;
+            }
+            used_ = 0;
+        }
+
+        /**
+         * Carves a piece of the block
+         * @param length The length in bytes
+         * @param alignment The alignment in bytes (power of 2)
+         * @return The pointer to the piece, NULL if there is no room left
+         */
+        uint8_t* ValueArena::allocate(const size_t& length, const size_t& alignment)
+        {
+            const size_t offset = align(used_, alignment);
+            if (NULL == data_ || offset + length > capacity_)
+            {
+                return NULL;
+            }
+            used_ = offset + length;
+            return data_ + offset;
+        }
+
+        /**
+         * Drops all the allocations, keeps the block
+         */
+        void ValueArena::reset()
+        {
+            used_ = 0;
+        }
+
+        /**
+         * Releases the block
+         */
+        void ValueArena::release()
+        {
+            DeleteArray(block_);
+            data_ = NULL;
+            capacity_ = 0;
+            used_ = 0;
+        }
+
+        /**
+         * Swaps the blocks of two arenas
+         * @param other The other arena
+         */
+        void ValueArena::swap(ValueArena& other)
+        {
+            std::swap(block_, other.block_);
+            std::swap(data_, other.data_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(used_, other.used_);
+        }
+
+    };/*namespace icd*/
+};/*namespace openlib*/
+
+#endif /*OPENLIB_ICD_VALUE_ARENA_H*/
@@ -25,13 +25,42 @@
 //-Library
 #include "openlib/common.h"
 #include "openlib/enum/endianess.h"
+#include "openlib/enum/access_pattern.h"
 #include "openlib/buffer/buffer_handler.h"
+#include "openlib/buffer/stream_framer.h"
+#include "openlib/capture/capture_reader.h"
+#include "openlib/capture/capture_writer.h"
+#include "openlib/capture/struct/capture_format.h"
 #include "openlib/icd/base_parser.h"
 #include "openlib/icd/message_icd.h"
+#include "openlib/icd/message_plan.h"
+#include "openlib/icd/value_arena.h"
+#include "openlib/icd/message_view.h"
+#include "openlib/icd/message_record.h"
+#include "openlib/icd/name_index.h"
+#include "openlib/icd/enum_table.h"
+#include "openlib/icd/text_icd_parser.h"
+#include "openlib/icd/schema.h"
+#include "openlib/icd/schema_writer.h"
+#include "openlib/icd/message_registry.h"
+#include "openlib/icd/column_batch.h"
+#include "openlib/icd/parallel_decoder.h"
+#include "openlib/icd/message_validator.h"
+#include "openlib/icd/text_serializer.h"
+#include "openlib/icd/text_encoder.h"
 #include "openlib/icd/struct/icd_data_entry.h"
+#include "openlib/icd/struct/icd_field.h"
+#include "openlib/icd/struct/schema_format.h"
+#include "openlib/icd/struct/validation_rule.h"
 #include "openlib/icd/enum/data_type.h"
 #include "openlib/icd/enum/parser_error.h"
+#include "openlib/icd/enum/rule_kind.h"
+#include "openlib/icd/enum/text_format.h"
 #include "openlib/non-copyable/non_copyable.h"
 #include "openlib/singleton/singleton.h"
+#include "openlib/thread-pool/thread_pool.h"
+#include "openlib/utils/mapped_file.h"
+#include "openlib/utils/hex_codec.h"
+#include "openlib/utils/utils.h"
 
 #endif /* OPENLIB_H */
@@ -25,6 +25,7 @@
 //-Supporting libraries
 #include <stddef.h>
 #include <stdio.h>
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -33,7 +34,7 @@ namespace openlib
 {
 
     /**
-     * Singleton template class (not thread safe)
+     * Singleton template class (thread safe creation)
      * Usage: class Test: public Singleton<Test>
      * {
      *  friend  Singleton<Test>;
@@ -43,6 +44,10 @@ namespace openlib
      * ...
      * }
      * call instance --> Test().instance().method()
+     *
+     * Double-checked creation: once created, instance() is a single acquire load (no lock), the mutex
+     * only serializes the creation and the cleanup. IMPORTANT: cleanup() must not race with the users
+     * of the instance (the references handed out are left dangling)
      * @tparam T The singleton class to implement
      */
     template < typename T >
@@ -51,25 +56,18 @@ namespace openlib
         public:
             static T& instance() 
             {
-                static SingletonMemGuard guard;
-                mutex_.lock();
-                if (NULL == instance_)
+                T* instance = instance_.load(std::memory_order_acquire);
+                if (NULL == instance)
                 {
-                    instance_ = new T();
+                    instance = create();
                 }
-                mutex_.unlock();
-                return *instance_;
+                return *instance;
             }
 
             static void cleanup()
             {
-                mutex_.lock();
-                if (NULL != instance_)
-                {
-                    delete instance_;
-                    instance_ = nullptr;
-                }
-                mutex_.unlock();
+                std::lock_guard<std::mutex> lock(mutex_);
+                delete instance_.exchange(NULL, std::memory_order_acq_rel);
             }
 
 
@@ -80,13 +78,30 @@ namespace openlib
 
         private:                        
             //-Class fields
-            static T* instance_;
+            static std::atomic<T*> instance_;
             static std::mutex  mutex_;
 
             //-Hide operators
             Singleton(const Singleton&);
             Singleton& operator= (const Singleton);
 
+            /**
+             * Creates the instance (slow path, once per creation)
+             * @return T* containing the instance
+             */
+            static T* create()
+            {
+                static SingletonMemGuard guard;
+                std::lock_guard<std::mutex> lock(mutex_);
+                T* instance = instance_.load(std::memory_order_relaxed);
+                if (NULL == instance)
+                {
+                    instance = new T();
+                    instance_.store(instance, std::memory_order_release);
+                }
+                return instance;
+            }
+
             /**
              * Cleanup MemGuard
              */
@@ -96,17 +111,14 @@ namespace openlib
                     SingletonMemGuard(){};
                     ~SingletonMemGuard()
                     {
-                      mutex_.lock();
-                      delete instance_;
-                      instance_ = nullptr;
-                      mutex_.unlock();
+                      cleanup();
                     }
             };
 
     }; /*class Singleton*/
 
     //-Class Field Initialization
-    template <typename T> T* Singleton<T>::instance_ = NULL;
+    template <typename T> std::atomic<T*> Singleton<T>::instance_(NULL);
     template <typename T> std::mutex Singleton<T>::mutex_;      
 
 }; /*namespace openlib*/
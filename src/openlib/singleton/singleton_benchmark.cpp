@@ -0,0 +1,157 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * Singleton contention benchmark
+ * Threads calling instance() in a loop, against a mutex taken on every call (the previous behaviour)
+ *
+ * Usage: singleton_benchmark [calls_per_thread] [max_threads]
+ * Build: g++ -std=c++17 -O2 -pthread -I<src> singleton_benchmark.cpp -o singleton_benchmark
+ */
+
+//-Supporting libraries
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "singleton.h"
+
+/**
+ * Benchmark singleton
+ */
+class BenchmarkSingleton: public openlib::Singleton<BenchmarkSingleton>
+{
+    friend openlib::Singleton<BenchmarkSingleton>;
+    public:
+        int value() const
+        {
+            return value_;
+        };
+
+    protected:
+        BenchmarkSingleton() : value_(1)
+        {
+        };
+
+        ~BenchmarkSingleton()
+        {
+        };
+
+        int value_;
+};
+
+/**
+ * Mutex on every call
+ */
+class LockedSingleton
+{
+    public:
+        static LockedSingleton& instance()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (NULL == instance_)
+            {
+                instance_ = new LockedSingleton();
+            }
+            return *instance_;
+        }
+
+        int value() const
+        {
+            return value_;
+        };
+
+    private:
+        LockedSingleton() : value_(1)
+        {
+        };
+
+        int value_;
+        static LockedSingleton* instance_;
+        static std::mutex mutex_;
+};
+LockedSingleton* LockedSingleton::instance_ = NULL;
+std::mutex LockedSingleton::mutex_;
+
+/**
+ * Runs the calls on a number of threads
+ * @tparam S The singleton
+ * @param num_threads The number of threads
+ * @param calls_per_thread The calls per thread
+ * @return double containing the calls per second (all the threads)
+ */
+template <typename S>
+static double run(const size_t& num_threads, const size_t& calls_per_thread)
+{
+    std::atomic<bool> start(false);
+    std::atomic<int64_t> total(0);
+    std::vector<std::thread> threads;
+    for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+    {
+        threads.push_back(std::thread([&start, &total, calls_per_thread]()
+        {
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            int64_t sum = 0;
+            for (size_t call = 0; call < calls_per_thread; ++call)
+            {
+                sum += S::instance().value();
+            }
+            total += sum;
+        }));
+    }
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+    {
+        threads[thread_idx].join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (total.load() != (int64_t) (num_threads * calls_per_thread))
+    {
+        fprintf(stderr, "Unexpected total\n");
+        exit(1);
+    }
+    return (double) (num_threads * calls_per_thread) / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t calls_per_thread = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000000;
+    const size_t max_threads = (argc > 2) ? strtoul(argv[2], NULL, 10) : 16;
+    printf("hardware threads: %u, calls per thread: %zu\n", std::thread::hardware_concurrency(), calls_per_thread);
+    printf("%8s %20s %20s\n", "threads", "locked (Mcalls/s)", "instance (Mcalls/s)");
+    for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+    {
+        const double locked = run<LockedSingleton>(num_threads, calls_per_thread);
+        const double lock_free = run<BenchmarkSingleton>(num_threads, calls_per_thread);
+        printf("%8zu %20.1f %20.1f\n", num_threads, locked / 1e6, lock_free / 1e6);
+    }
+    BenchmarkSingleton::cleanup();
+    return 0;
+}
@@ -22,6 +22,8 @@
 //-Supporting libraries
 #include <stdint.h>
 #include <string.h>
+#include <thread>
+#include <vector>
 #include "singleton.h"
 #include "singleton_utest.h"
 #include "CppUTest/TestHarness.h"
@@ -50,4 +52,31 @@ TEST(singleton, Test_Instance)
     CHECK_EQUAL(TestSingleton::instance().add(1, 1), 2);
 }
 
+TEST(singleton, Test_Concurrent)
+{
+    //-Threads racing on the creation get the same instance
+    const size_t num_threads = 8;
+    for (size_t round = 0; round < 20; ++round)
+    {
+        TestSingleton::cleanup();
+        std::vector<TestSingleton*> instances(num_threads, NULL);
+        std::vector<std::thread> threads;
+        for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+        {
+            threads.push_back(std::thread([&instances, thread_idx]() { instances[thread_idx] = &TestSingleton::instance(); }));
+        }
+        for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+        {
+            threads[thread_idx].join();
+        }
+        for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+        {
+            CHECK(instances[0] == instances[thread_idx]);
+        }
+        CHECK(instances[0] == &TestSingleton::instance());
+    }
 
+    //-Created again after a cleanup
+    TestSingleton::cleanup();
+    CHECK_EQUAL(TestSingleton::instance().add(3, 4), 7);
+}
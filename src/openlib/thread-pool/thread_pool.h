@@ -0,0 +1,262 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_THREAD_POOL_H
+#define OPENLIB_THREAD_POOL_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include <stddef.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    /**
+     * Fixed size work stealing thread pool for data parallel jobs: the tasks of a job are split in
+     * contiguous blocks over per-thread queues, each thread runs its own block in order and, once
+     * done, steals from the back of the other queues. The calling thread takes part in the job
+     * IMPORTANT: tasks must not throw, one job at a time
+     */
+    class ThreadPool : public NonCopyable
+    {
+        public:
+            typedef std::function<void (const size_t& task_idx)> Task;
+
+            //-Constructor & Destructor
+            inline explicit ThreadPool(const size_t& num_threads);
+            inline virtual ~ThreadPool();
+
+            //-Accessor
+            inline size_t size() const  { return threads_.size() + 1; }
+
+            //-Ancillary functions
+            inline void run(const size_t& num_tasks, const Task& task);
+
+        private:
+            /**
+             * Task queue of a thread
+             */
+            struct Queue
+            {
+                std::mutex          mutex;
+                std::deque<size_t>  tasks;
+            };
+
+            //-Functions
+            inline void work(const size_t& queue_idx);
+            inline void execute(const size_t& queue_idx);
+            inline bool pop(const size_t& queue_idx, size_t& task_idx);
+            inline bool steal(const size_t& queue_idx, size_t& task_idx);
+
+            //-Fields
+            std::vector<std::thread>    threads_;
+            std::vector<Queue*>         queues_;        //-One per thread, the last one for the caller
+            std::mutex                  mutex_;
+            std::condition_variable     start_;
+            std::condition_variable     done_;
+            const Task*                 task_;
+            std::atomic<size_t>         pending_;       //-Tasks of the job not finished yet
+            size_t                      generation_;    //-Job counter
+            bool                        stop_;
+
+    }; /*class ThreadPool*/
+
+    /**
+     * Constructor
+     * @param num_threads The number of threads (including the caller of run), 0: hardware concurrency
+     */
+    ThreadPool::ThreadPool(const size_t& num_threads) :
+        task_(NULL),
+        pending_(0),
+        generation_(0),
+        stop_(false)
+    {
+        size_t total = num_threads;
+        if (0 == total)
+        {
+            total = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t queue_idx = 0; queue_idx < total; ++queue_idx)
+        {
+            queues_.push_back(new Queue());
+        }
+        for (size_t queue_idx = 0; queue_idx + 1 < total; ++queue_idx)
+        {
+            threads_.push_back(std::thread(&ThreadPool::work, this, queue_idx));
+        }
+    }
+
+    /**
+     * Destructor, joins the threads
+     */
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (size_t thread_idx = 0; thread_idx < threads_.size(); ++thread_idx)
+        {
+            threads_[thread_idx].join();
+        }
+        for (size_t queue_idx = 0; queue_idx < queues_.size(); ++queue_idx)
+        {
+            delete queues_[queue_idx];
+        }
+    }
+
+    /**
+     * Runs a job, returns once all its tasks are done
+     * @param num_tasks The number of tasks
+     * @param task The task, called once per task index [0..num_tasks)
+     */
+    void ThreadPool::run(const size_t& num_tasks, const Task& task)
+    {
+        if (0 == num_tasks)
+        {
+            return;
+        }
+        if (threads_.empty())
+        {
+            for (size_t task_idx = 0; task_idx < num_tasks; ++task_idx)
+            {
+                task(task_idx);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = num_tasks;
+            for (size_t queue_idx = 0; queue_idx < queues_.size(); ++queue_idx)
+            {
+                const size_t begin = num_tasks * queue_idx / queues_.size();
+                const size_t end = num_tasks * (queue_idx + 1) / queues_.size();
+                std::lock_guard<std::mutex> queue_lock(queues_[queue_idx]->mutex);
+                for (size_t task_idx = begin; task_idx < end; ++task_idx)
+                {
+                    queues_[queue_idx]->tasks.push_back(task_idx);
+                }
+            }
+            ++generation_;
+        }
+        start_.notify_all();
+
+        execute(queues_.size() - 1);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return 0 == pending_; });
+        task_ = NULL;
+    }
+
+    /**
+     * Thread loop
+     * @param queue_idx The queue of the thread
+     */
+    void ThreadPool::work(const size_t& queue_idx)
+    {
+        size_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [this, &generation] { return stop_ || generation != generation_; });
+                if (stop_)
+                {
+                    return;
+                }
+                generation = generation_;
+            }
+            execute(queue_idx);
+        }
+    }
+
+    /**
+     * Runs the tasks of a queue, then the stolen ones, until no task is left
+     * @param queue_idx The queue of the thread
+     */
+    void ThreadPool::execute(const size_t& queue_idx)
+    {
+        size_t task_idx = 0;
+        while (pop(queue_idx, task_idx) || steal(queue_idx, task_idx))
+        {
+            (*task_)(task_idx);
+            if (1 == pending_.fetch_sub(1))
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    /**
+     * Takes the next task of a queue (front, the block order)
+     * @param queue_idx The queue
+     * @param task_idx (output) The task index
+     * @return true if taken
+     */
+    bool ThreadPool::pop(const size_t& queue_idx, size_t& task_idx)
+    {
+        Queue& queue = *queues_[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+        task_idx = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * Takes a task from the back of another queue
+     * @param queue_idx The queue of the thief
+     * @param task_idx (output) The task index
+     * @return true if taken
+     */
+    bool ThreadPool::steal(const size_t& queue_idx, size_t& task_idx)
+    {
+        for (size_t offset = 1; offset < queues_.size(); ++offset)
+        {
+            Queue& queue = *queues_[(queue_idx + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task_idx = queue.tasks.back();
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+}; /*namespace openlib*/
+
+#endif /*OPENLIB_THREAD_POOL_H*/
@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "thread_pool.h"
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+
+TEST_GROUP(thread_pool)
+{
+
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+
+	/**
+	 * Runs a job and checks every task ran exactly once
+	 */
+	void check_job(ThreadPool& pool, const size_t& num_tasks)
+	{
+		vector<atomic<size_t> > runs(num_tasks);
+		for (size_t task_idx = 0; task_idx < num_tasks; ++task_idx)
+		{
+			runs[task_idx] = 0;
+		}
+		pool.run(num_tasks, [&runs] (const size_t& task_idx) { ++runs[task_idx]; });
+		for (size_t task_idx = 0; task_idx < num_tasks; ++task_idx)
+		{
+			CHECK_EQUAL(1u, runs[task_idx].load());
+		}
+	}
+
+};
+
+TEST(thread_pool, Test_run)
+{
+	ThreadPool pool(4);
+	CHECK_EQUAL(4u, pool.size());
+	check_job(pool, 0);
+	check_job(pool, 1);
+	check_job(pool, 3);
+	check_job(pool, 1000);
+
+	//-Back to back jobs on the same threads
+	for (size_t job = 0; job < 200; ++job)
+	{
+		check_job(pool, job % 17);
+	}
+}
+
+TEST(thread_pool, Test_unbalanced)
+{
+	//-Tasks of the first block are slow: the other threads steal them
+	ThreadPool pool(3);
+	atomic<size_t> sum(0);
+	pool.run(30, [&sum] (const size_t& task_idx)
+		{
+			volatile size_t spin = 0;
+			for (size_t i = 0; i < ((task_idx < 10) ? 100000u : 10u); ++i)
+			{
+				spin = spin + i;
+			}
+			sum += task_idx;
+		});
+	CHECK_EQUAL(435u, sum.load());
+}
+
+TEST(thread_pool, Test_caller_only)
+{
+	ThreadPool pool(1);
+	CHECK_EQUAL(1u, pool.size());
+	check_job(pool, 100);
+
+	ThreadPool hardware(0);
+	CHECK(hardware.size() >= 1);
+	check_job(hardware, 100);
+}
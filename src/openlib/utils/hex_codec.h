@@ -0,0 +1,281 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_UTILS_HEX_CODEC_H
+#define OPENLIB_UTILS_HEX_CODEC_H
+
+//-Supporting libraries
+#include "openlib/buffer/bit.h"
+#include <algorithm>
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-Namespace/s
+namespace openlib
+{
+    namespace hex_codec
+    {
+        static const uint8_t INVALID_DIGIT = 0xFF;
+
+        /**
+         * Value of the hexadecimal digits, INVALID_DIGIT for any other character
+         * @return const uint8_t* containing the 256 entries table
+         */
+        inline const uint8_t* digit_table()
+        {
+            static const uint8_t DIGITS[256] =
+            {
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                   0,    1,    2,    3,    4,    5,    6,    7,    8,    9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF,   10,   11,   12,   13,   14,   15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF,   10,   11,   12,   13,   14,   15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            };
+            return DIGITS;
+        }
+
+        /**
+         * Converts binary data to hexadecimal digits, 2 per byte (32 bytes at a time with AVX2, 16 with SSE2)
+         * @param data The data
+         * @param data_length The length of the data
+         * @param output The output, at least 2 * data_length characters (not null terminated)
+         * @param upper_case true for A-F, a-f otherwise
+         */
+        inline void encode(const void* data, const size_t& data_length, char* output, const bool& upper_case = false)
+        {
+            const uint8_t* data_ptr = (const uint8_t*) data;
+            const char* digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+            const char letter_offset = upper_case ? 'A' - '0' - 10 : 'a' - '0' - 10;
+            size_t idx = 0;
+
+            #if defined(__AVX2__)
+            const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+            const __m256i nine = _mm256_set1_epi8(9);
+            const __m256i zero = _mm256_set1_epi8('0');
+            const __m256i letter = _mm256_set1_epi8(letter_offset);
+            for (; idx + sizeof(__m256i) <= data_length; idx += sizeof(__m256i))
+            {
+                const __m256i bytes = _mm256_loadu_si256((const __m256i*) (data_ptr + idx));
+                const __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble_mask);
+                const __m256i low = _mm256_and_si256(bytes, nibble_mask);
+                //-Per 128 bits lane: bytes 0-7 / 16-23 and 8-15 / 24-31
+                __m256i first = _mm256_unpacklo_epi8(high, low);
+                __m256i second = _mm256_unpackhi_epi8(high, low);
+                first = _mm256_add_epi8(_mm256_add_epi8(first, zero), _mm256_and_si256(_mm256_cmpgt_epi8(first, nine), letter));
+                second = _mm256_add_epi8(_mm256_add_epi8(second, zero), _mm256_and_si256(_mm256_cmpgt_epi8(second, nine), letter));
+                _mm256_storeu_si256((__m256i*) (output + 2 * idx), _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256((__m256i*) (output + 2 * idx + sizeof(__m256i)), _mm256_permute2x128_si256(first, second, 0x31));
+            }
+            #elif defined(__SSE2__)
+            const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i zero = _mm_set1_epi8('0');
+            const __m128i letter = _mm_set1_epi8(letter_offset);
+            for (; idx + sizeof(__m128i) <= data_length; idx += sizeof(__m128i))
+            {
+                const __m128i bytes = _mm_loadu_si128((const __m128i*) (data_ptr + idx));
+                const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+                const __m128i low = _mm_and_si128(bytes, nibble_mask);
+                __m128i first = _mm_unpacklo_epi8(high, low);
+                __m128i second = _mm_unpackhi_epi8(high, low);
+                first = _mm_add_epi8(_mm_add_epi8(first, zero), _mm_and_si128(_mm_cmpgt_epi8(first, nine), letter));
+                second = _mm_add_epi8(_mm_add_epi8(second, zero), _mm_and_si128(_mm_cmpgt_epi8(second, nine), letter));
+                _mm_storeu_si128((__m128i*) (output + 2 * idx), first);
+                _mm_storeu_si128((__m128i*) (output + 2 * idx + sizeof(__m128i)), second);
+            }
+            #else
+            (void) letter_offset;
+            #endif
+
+            //-Remainder (the whole data without SIMD)
+            for (; idx < data_length; ++idx)
+            {
+                output[2 * idx] = digits[data_ptr[idx] >> 4];
+                output[2 * idx + 1] = digits[data_ptr[idx] & 0x0F];
+            }
+        }
+
+        /**
+         * Converts binary data to a hexadecimal string (i.e. dumps)
+         * @param data The data
+         * @param data_length The length of the data
+         * @param upper_case true for A-F, a-f otherwise
+         * @return std::string containing 2 * data_length digits
+         */
+        inline std::string encode(const void* data, const size_t& data_length, const bool& upper_case = false)
+        {
+            std::string text(2 * data_length, '\0');
+            if (0 != data_length)
+            {
+                encode(data, data_length, &text[0], upper_case);
+            }
+            return text;
+        }
+
+        /**
+         * Converts hexadecimal digits to binary (32 digits at a time with AVX2, 16 with SSE2), no prefix nor
+         * separators: 2 digits per byte
+         * @param text The digits
+         * @param num_bytes The number of bytes to decode (2 * num_bytes digits)
+         * @param output The output, at least num_bytes long
+         * @return size_t containing the position of the first invalid digit, 2 * num_bytes if all valid
+         * (the bytes before the invalid digit are decoded)
+         */
+        inline size_t decode_digits(const char* text, const size_t& num_bytes, void* output)
+        {
+            uint8_t* output_ptr = (uint8_t*) output;
+            const size_t num_digits = 2 * num_bytes;
+            size_t idx = 0;
+
+            #if defined(__AVX2__)
+            const __m256i zero = _mm256_set1_epi8('0');
+            const __m256i letter = _mm256_set1_epi8('a');
+            const __m256i lower_case = _mm256_set1_epi8(0x20);
+            const __m256i nine = _mm256_set1_epi8(9);
+            const __m256i five = _mm256_set1_epi8(5);
+            const __m256i ten = _mm256_set1_epi8(10);
+            const __m256i low_byte = _mm256_set1_epi16(0x00FF);
+            for (; idx + sizeof(__m256i) <= num_digits; idx += sizeof(__m256i))
+            {
+                const __m256i characters = _mm256_loadu_si256((const __m256i*) (text + idx));
+                const __m256i decimal = _mm256_sub_epi8(characters, zero);
+                const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(characters, lower_case), letter);
+                const __m256i is_decimal = _mm256_cmpeq_epi8(_mm256_min_epu8(decimal, nine), decimal);
+                const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, five), alpha);
+                if (-1 != _mm256_movemask_epi8(_mm256_or_si256(is_decimal, is_alpha)))
+                {
+                    break;
+                }
+                const __m256i values = _mm256_or_si256(_mm256_and_si256(is_decimal, decimal), _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, ten)));
+                //-Digit pairs onto 16 bits lanes: high digit on the low byte
+                const __m256i bytes = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(values, low_byte), 4), _mm256_srli_epi16(values, 8));
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+                _mm_storeu_si128((__m128i*) (output_ptr + idx / 2), _mm256_castsi256_si128(packed));
+            }
+            #elif defined(__SSE2__)
+            const __m128i zero = _mm_set1_epi8('0');
+            const __m128i letter = _mm_set1_epi8('a');
+            const __m128i lower_case = _mm_set1_epi8(0x20);
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i five = _mm_set1_epi8(5);
+            const __m128i ten = _mm_set1_epi8(10);
+            const __m128i low_byte = _mm_set1_epi16(0x00FF);
+            for (; idx + sizeof(__m128i) <= num_digits; idx += sizeof(__m128i))
+            {
+                const __m128i characters = _mm_loadu_si128((const __m128i*) (text + idx));
+                const __m128i decimal = _mm_sub_epi8(characters, zero);
+                const __m128i alpha = _mm_sub_epi8(_mm_or_si128(characters, lower_case), letter);
+                const __m128i is_decimal = _mm_cmpeq_epi8(_mm_min_epu8(decimal, nine), decimal);
+                const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, five), alpha);
+                if (0xFFFF != _mm_movemask_epi8(_mm_or_si128(is_decimal, is_alpha)))
+                {
+                    break;
+                }
+                const __m128i values = _mm_or_si128(_mm_and_si128(is_decimal, decimal), _mm_and_si128(is_alpha, _mm_add_epi8(alpha, ten)));
+                //-Digit pairs onto 16 bits lanes: high digit on the low byte
+                const __m128i bytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, low_byte), 4), _mm_srli_epi16(values, 8));
+                _mm_storel_epi64((__m128i*) (output_ptr + idx / 2), _mm_packus_epi16(bytes, bytes));
+            }
+            #endif
+
+            //-Remainder, the block with the invalid digit (the whole text without SIMD)
+            const uint8_t* digits = digit_table();
+            for (; idx < num_digits; idx += 2)
+            {
+                const uint8_t high = digits[(uint8_t) text[idx]];
+                const uint8_t low = digits[(uint8_t) text[idx + 1]];
+                if (INVALID_DIGIT == high || INVALID_DIGIT == low)
+                {
+                    return (INVALID_DIGIT == high) ? idx : idx + 1;
+                }
+                output_ptr[idx / 2] = (uint8_t) ((high << 4) | low);
+            }
+            return num_digits;
+        }
+
+        /**
+         * Converts a hexadecimal text to binary: groups of digits separated by white spaces, each group with
+         * an optional 0x prefix (i.e. "0xDEADBEEF", "de ad be ef", "0x0102 0x0304")
+         * @param text The text
+         * @param text_length The length of the text
+         * @param output The output
+         * @param output_length The length of the output
+         * @param num_bytes (output) The number of bytes decoded
+         * @param error_idx (output) The position of the first character that cannot be decoded: invalid
+         * digit, digit of an incomplete byte or first digit past the output (text_length if none)
+         * @return true if the whole text is decoded
+         */
+        inline bool decode(const char* text, const size_t& text_length, void* output, const size_t& output_length, size_t& num_bytes, size_t& error_idx)
+        {
+            uint8_t* output_ptr = (uint8_t*) output;
+            num_bytes = 0;
+            error_idx = text_length;
+            size_t idx = 0;
+            while (idx < text_length)
+            {
+                if (isspace((unsigned char) text[idx]))
+                {
+                    ++idx;
+                    continue;
+                }
+
+                //-Group
+                if ('0' == text[idx] && idx + 1 < text_length && ('x' == text[idx + 1] || 'X' == text[idx + 1]))
+                {
+                    idx += 2;
+                }
+                const size_t run = std::min((text_length - idx) / 2, output_length - num_bytes);
+                const size_t decoded = decode_digits(text + idx, run, output_ptr + num_bytes);
+                num_bytes += decoded / 2;
+                idx += decoded;
+                const bool at_space = (idx < text_length && isspace((unsigned char) text[idx]));
+                if (0 != decoded % 2 || (idx < text_length && !at_space))
+                {
+                    //-Invalid digit, incomplete byte (its digit) or no room left
+                    error_idx = at_space ? idx - 1 : idx;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }; /*namespace hex_codec*/
+}; /*namespace openlib*/
+
+#endif /*OPENLIB_UTILS_HEX_CODEC_H*/
@@ -0,0 +1,137 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "hex_codec.h"
+#include "string_fnc.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+
+static const size_t HEX_CODEC_LENGTH = 1000;
+
+TEST_GROUP(hex_codec)
+{
+	vector<uint8_t> data;
+
+	void setup()
+	{
+		srand(31);
+		data.resize(HEX_CODEC_LENGTH);
+		for (size_t i = 0; i < data.size(); ++i)
+		{
+			data[i] = (uint8_t) rand();
+		}
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(hex_codec, Test_encode)
+{
+	const uint8_t bytes[] = {0x00, 0x9F, 0xA0, 0xFF, 0x12};
+	STRCMP_EQUAL("009fa0ff12", hex_codec::encode(bytes, sizeof(bytes)).c_str());
+	STRCMP_EQUAL("009FA0FF12", hex_codec::encode(bytes, sizeof(bytes), true).c_str());
+	STRCMP_EQUAL("", hex_codec::encode(bytes, 0).c_str());
+	STRCMP_EQUAL("009fa0", string_fnc::binary_to_hex_str(bytes, 3).c_str());
+
+	//-Every length against the scalar form (SIMD blocks and remainders)
+	for (size_t length = 0; length <= 100; ++length)
+	{
+		const string text = hex_codec::encode(data.data(), length, true);
+		CHECK_EQUAL(2 * length, text.length());
+		for (size_t i = 0; i < length; ++i)
+		{
+			char expected[3];
+			snprintf(expected, sizeof(expected), "%02X", data[i]);
+			CHECK(0 == memcmp(expected, &text[2 * i], 2));
+		}
+	}
+}
+
+TEST(hex_codec, Test_decode_digits)
+{
+	const string text = hex_codec::encode(data.data(), data.size());
+	vector<uint8_t> decoded(data.size());
+	CHECK_EQUAL(text.length(), hex_codec::decode_digits(text.data(), data.size(), decoded.data()));
+	MEMCMP_EQUAL(data.data(), decoded.data(), data.size());
+	const string upper = hex_codec::encode(data.data(), data.size(), true);
+	CHECK_EQUAL(upper.length(), hex_codec::decode_digits(upper.data(), data.size(), decoded.data()));
+	MEMCMP_EQUAL(data.data(), decoded.data(), data.size());
+
+	//-Exact position of an invalid digit, within and around the SIMD blocks
+	const char invalid[] = {'g', 'G', '/', ':', '@', '`', ' ', 'x', '\0', (char) 0x80};
+	for (size_t position = 0; position < 80; ++position)
+	{
+		string corrupted(text, 0, 80);
+		corrupted[position] = invalid[position % sizeof(invalid)];
+		CHECK_EQUAL(position, hex_codec::decode_digits(corrupted.data(), 40, decoded.data()));
+		MEMCMP_EQUAL(data.data(), decoded.data(), position / 2);
+	}
+}
+
+TEST(hex_codec, Test_decode)
+{
+	uint8_t buffer[8];
+	size_t num_bytes = 0;
+	size_t error_idx = 0;
+
+	//-Prefixes and white spaces
+	const char* text = "0xDEADbeef 01\t0X02\n 0x";
+	CHECK(hex_codec::decode(text, strlen(text), buffer, sizeof(buffer), num_bytes, error_idx));
+	CHECK_EQUAL(6u, num_bytes);
+	CHECK_EQUAL(strlen(text), error_idx);
+	const uint8_t expected[] = {0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02};
+	MEMCMP_EQUAL(expected, buffer, sizeof(expected));
+
+	//-Invalid digit, incomplete byte, no room left
+	CHECK(!hex_codec::decode("01 0z", 5, buffer, sizeof(buffer), num_bytes, error_idx));
+	CHECK_EQUAL(1u, num_bytes);
+	CHECK_EQUAL(4u, error_idx);
+	CHECK(!hex_codec::decode("01 2 34", 7, buffer, sizeof(buffer), num_bytes, error_idx));
+	CHECK_EQUAL(1u, num_bytes);
+	CHECK_EQUAL(3u, error_idx);
+	CHECK(!hex_codec::decode("0102a", 5, buffer, sizeof(buffer), num_bytes, error_idx));
+	CHECK_EQUAL(2u, num_bytes);
+	CHECK_EQUAL(4u, error_idx);
+	CHECK(!hex_codec::decode("01020304", 8, buffer, 3, num_bytes, error_idx));
+	CHECK_EQUAL(3u, num_bytes);
+	CHECK_EQUAL(6u, error_idx);
+	CHECK(!hex_codec::decode("0x0x01", 6, buffer, sizeof(buffer), num_bytes, error_idx));
+	CHECK_EQUAL(3u, error_idx);
+
+	//-String helper (the digits past the buffer ignored)
+	memset(buffer, 0, sizeof(buffer));
+	CHECK_EQUAL(2u, string_fnc::hex_str_to_binary("0xABCD", buffer, sizeof(buffer)));
+	CHECK_EQUAL(0xAB, buffer[0]);
+	CHECK_EQUAL(0xCD, buffer[1]);
+	CHECK_EQUAL(2u, string_fnc::hex_str_to_binary("0102 0304", buffer, 2));
+	CHECK_EQUAL(0u, string_fnc::hex_str_to_binary("0102", NULL, 2));
+}
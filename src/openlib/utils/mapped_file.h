@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef OPENLIB_UTILS_MAPPED_FILE_H
+#define OPENLIB_UTILS_MAPPED_FILE_H
+
+//-Supporting libraries
+#include "openlib/non-copyable/non_copyable.h"
+#include "openlib/enum/access_pattern.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#define OPENLIB_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-Namespace/s
+namespace openlib
+{
+    namespace utils
+    {
+        /**
+         * Read only view of a whole file, memory mapped when the platform supports it (read onto
+         * the heap otherwise)
+         */
+        class MappedFile : public NonCopyable
+        {
+            public:
+                //-Constructor & Destructor
+                MappedFile() : data_(NULL), length_(0), mapped_(false) {};
+                virtual ~MappedFile() { close(); };
+
+                //-Accessor
+                inline const uint8_t* data() const  { return data_;         }
+                inline size_t length() const        { return length_;       }
+                inline bool is_open() const         { return NULL != data_; }
+
+                //-Ancillary functions
+                inline bool open(const std::string& path);
+                inline void close();
+                inline bool advise(const AccessPattern& access_pattern, const bool& huge_pages = false);
+
+            protected:
+                //-Fields
+                uint8_t*    data_;
+                size_t      length_;
+                bool        mapped_;    //-Whether data_ is a mapping (heap copy otherwise)
+
+        }; /*class MappedFile*/
+
+        /**
+         * Maps a file (closes the previous one), an empty file opens with a NULL view
+         * @param path The path to the file
+         * @return true on success
+         */
+        bool MappedFile::open(const std::string& path)
+        {
+            close();
+#ifdef OPENLIB_HAS_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                return false;
+            }
+            struct stat file_stat;
+            if (0 != fstat(fd, &file_stat))
+            {
+                ::close(fd);
+                return false;
+            }
+            length_ = (size_t) file_stat.st_size;
+            if (length_ > 0)
+            {
+                void* mapping = mmap(NULL, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (MAP_FAILED == mapping)
+                {
+                    ::close(fd);
+                    length_ = 0;
+                    return false;
+                }
+                data_ = (uint8_t*) mapping;
+                mapped_ = true;
+            }
+            //-The mapping outlives the descriptor
+            ::close(fd);
+            return true;
+#else
+            FILE* file = fopen(path.c_str(), "rb");
+            if (NULL == file)
+            {
+                return false;
+            }
+            fseek(file, 0, SEEK_END);
+            const long file_length = ftell(file);
+            fseek(file, 0, SEEK_SET);
+            if (file_length > 0)
+            {
+                data_ = new uint8_t[file_length];
+                length_ = (size_t) file_length;
+                if (length_ != fread(data_, 1, length_, file))
+                {
+                    fclose(file);
+                    close();
+                    return false;
+                }
+            }
+            fclose(file);
+            return true;
+#endif
+        }
+
+        /**
+         * Hints the kernel on how the view is going to be read (no-op when the file is not mapped)
+         * @param access_pattern The expected access pattern
+         * @param huge_pages Whether to back the mapping with transparent huge pages (best effort, only
+         *                   honoured by some file systems, its failure is not reported)
+         * @return true if the hint was taken
+         */
+        bool MappedFile::advise(const AccessPattern& access_pattern, const bool& huge_pages)
+        {
+#ifdef OPENLIB_HAS_MMAP
+            if (!mapped_)
+            {
+                return true;
+            }
+            int advice = MADV_NORMAL;
+            switch (access_pattern)
+            {
+                case AccessPattern_Normal       : advice = MADV_NORMAL;     break;
+                case AccessPattern_Sequential   : advice = MADV_SEQUENTIAL; break;
+                case AccessPattern_Random       : advice = MADV_RANDOM;     break;
+                case AccessPattern_WillNeed     : advice = MADV_WILLNEED;   break;
+                default:
+                    return false;
+            }
+#ifdef MADV_HUGEPAGE
+            if (huge_pages)
+            {
+                madvise(data_, length_, MADV_HUGEPAGE);
+            }
+#endif
+            return 0 == madvise(data_, length_, advice);
+#else
+            (void) huge_pages;
+            return access_pattern > AccessPattern_Min && access_pattern < AccessPattern_Max;
+#endif
+        }
+
+        /**
+         * Releases the view
+         */
+        void MappedFile::close()
+        {
+#ifdef OPENLIB_HAS_MMAP
+            if (mapped_)
+            {
+                munmap(data_, length_);
+                data_ = NULL;
+            }
+#endif
+            if (NULL != data_)
+            {
+                delete[] data_;
+                data_ = NULL;
+            }
+            length_ = 0;
+            mapped_ = false;
+        }
+
+    }; /*namespace utils*/
+}; /*namespace openlib*/
+
+#endif /*OPENLIB_UTILS_MAPPED_FILE_H*/
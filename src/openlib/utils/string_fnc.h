@@ -23,9 +23,9 @@
 #define OPENLIB_UTILS_STRING_H
 
 //-Supporting libraries
+#include "openlib/utils/hex_codec.h"
+#include <stddef.h>
 #include <stdint.h>
-#include <sstream>
-#include <iomanip>
 #include <string>
 
 //-Namespace/s
@@ -35,32 +35,51 @@ namespace openlib
     {
 
         /**
-         * Converts a hex string to a binary form can have pre-appended 0x...
+         * Converts a hex string to a binary form can have pre-appended 0x... and white spaces between the bytes
+         * (@see hex_codec::decode), the digits past the buffer are ignored
          * @param hex_str The source hex string
          * @param buffer The buffer where to store the converted data
          * @param buffer_length The buffer length
+         * @return size_t containing the number of bytes converted (up to the first invalid digit)
          */
-        inline void hex_str_to_binary(const std::string& hex_str, void* buffer, const size_t& buffer_length)
+        inline size_t hex_str_to_binary(const std::string& hex_str, void* buffer, const size_t& buffer_length)
         {
             //-Safety check
+            size_t num_bytes = 0;
             if (NULL != buffer)
             {
-                uint8_t* buffer_ptr = (uint8_t*) buffer;
-                std::istringstream hex_chars_stream(hex_str);
-                std::string tmp_two_characters;
-                uint32_t value;
-                size_t buffer_idx = 0;
-                while (hex_chars_stream >> std::setw(2) >> tmp_two_characters && buffer_idx < buffer_length)
-                {
-                    if (tmp_two_characters == "0x")
-                    {
-                        continue;
-                    }
-                    std::istringstream ss2 (tmp_two_characters);
-                    ss2 >> std::setbase(16) >> value;
-                    buffer_ptr[buffer_idx++] = (uint8_t) value;
-                }
+                size_t error_idx;
+                hex_codec::decode(hex_str.data(), hex_str.length(), buffer, buffer_length, num_bytes, error_idx);
             }
+            return num_bytes;
+        }
+
+        /**
+         * Converts binary data to a hex string (lower case, no prefix)
+         * @param buffer The binary data
+         * @param buffer_length The buffer length
+         * @return std::string containing 2 digits per byte
+         */
+        inline std::string binary_to_hex_str(const void* buffer, const size_t& buffer_length)
+        {
+            return (NULL == buffer) ? std::string() : hex_codec::encode(buffer, buffer_length);
+        }
+
+        /**
+         * Hashes a string (FNV-1a 64 bits, high bits mixed onto the low ones for power of 2 tables)
+         * @param str The string (not necessarily null terminated)
+         * @param str_length The length of the string
+         * @return uint64_t containing the hash
+         */
+        inline uint64_t hash(const char* str, const size_t& str_length)
+        {
+            uint64_t value = 0xCBF29CE484222325ULL;
+            for (size_t i = 0; i < str_length; ++i)
+            {
+                value ^= (uint8_t) str[i];
+                value *= 0x100000001B3ULL;
+            }
+            return value ^ (value >> 32);
         }
 
     }; /*namespace string_fnc*/
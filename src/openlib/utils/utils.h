@@ -23,8 +23,21 @@
 #define OPENLIB_UTILS__H
 
 //-Supporting libraries
+#include <charconv>
+#include <ctype.h>
+#include <stddef.h>
 #include <stdint.h>
-#include <sstream>
+#include <string.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//-Constant expression conversions (std::from_chars/std::to_chars are constexpr from C++23)
+#if defined(__cpp_lib_constexpr_charconv)
+#define OPENLIB_CHARCONV_CONSTEXPR constexpr
+#else
+#define OPENLIB_CHARCONV_CONSTEXPR
+#endif
 
 //-Namespace/s
 namespace openlib
@@ -32,19 +45,127 @@ namespace openlib
     namespace utils
     {
         /**
-         * Converts a hex string to a value
-         * @tparam T2
-         * @tparam T1
-         * @param in
-         * @return
+         * Parses a decimal integer (negative only for signed types), the whole text
+         * @tparam T Integral type
+         * @param begin The first character
+         * @param end Past the last character
+         * @param value (output) The value (untouched if not valid)
+         * @return true if valid and within the range of T
+         */
+        template <typename T>
+        inline OPENLIB_CHARCONV_CONSTEXPR bool parse_int(const char* begin, const char* end, T& value)
+        {
+            T parsed = 0;
+            const std::from_chars_result result = std::from_chars(begin, end, parsed);
+            if (std::errc() != result.ec || end != result.ptr)
+            {
+                return false;
+            }
+            value = parsed;
+            return true;
+        }
+
+        /**
+         * Parses a hexadecimal integer with an optional 0x prefix, the whole text. Signed types take the bit
+         * pattern (i.e. "FF" is -1 for int8_t)
+         * @tparam T Integral type
+         * @param begin The first character
+         * @param end Past the last character
+         * @param value (output) The value (untouched if not valid)
+         * @return true if valid and within the width of T
+         */
+        template <typename T>
+        inline OPENLIB_CHARCONV_CONSTEXPR bool parse_hex(const char* begin, const char* end, T& value)
+        {
+            if (end - begin > 2 && '0' == begin[0] && ('x' == begin[1] || 'X' == begin[1]))
+            {
+                begin += 2;
+            }
+            typename std::make_unsigned<T>::type bits = 0;
+            const std::from_chars_result result = std::from_chars(begin, end, bits, 16);
+            if (std::errc() != result.ec || end != result.ptr)
+            {
+                return false;
+            }
+            value = (T) bits;
+            return true;
+        }
+
+        /**
+         * Formats an integer
+         * @tparam T Integral type
+         * @param output The output (not null terminated)
+         * @param output_length The length of the output
+         * @param value The value
+         * @param base The base [2..36], no prefix
+         * @return size_t containing the number of characters written, 0 if it does not fit
+         */
+        template <typename T>
+        inline OPENLIB_CHARCONV_CONSTEXPR size_t format_int(char* output, const size_t& output_length, const T& value, const int& base = 10)
+        {
+            const std::to_chars_result result = std::to_chars(output, output + output_length, value, base);
+            return (std::errc() == result.ec) ? (size_t) (result.ptr - output) : 0;
+        }
+
+        template <typename T>
+        inline bool parse_int(const std::string& text, T& value)           { return parse_int(text.data(), text.data() + text.length(), value);    }
+        template <typename T>
+        inline bool parse_hex(const std::string& text, T& value)           { return parse_hex(text.data(), text.data() + text.length(), value);    }
+
+        /**
+         * Formats an integer onto a string
+         * @tparam T Integral type
+         * @param value The value
+         * @param base The base [2..36], no prefix
+         * @return std::string containing the value
+         */
+        template <typename T>
+        inline std::string format_int(const T& value, const int& base = 10)
+        {
+            char output[72];
+            return std::string(output, format_int(output, sizeof(output), value, base));
+        }
+
+        /**
+         * Converts the leading hex number of a string to a value (allocation free), as read from a std::hex
+         * stream: leading white spaces, a sign and a 0x prefix are accepted and parsing stops at the first
+         * character that is not a hex digit (i.e. "12 34" and "12zz" are 0x12), a minus negates the value,
+         * the bits beyond T2 are dropped
+         * @tparam T2 The value type
+         * @tparam T1 The string type (std::string, const char*)
+         * @param in The hex string
+         * @return T2 containing the value, 0 if there is no hex number, all ones if it overflows 64 bits
          */
         template<typename T2, typename T1>
         inline T2 convert(const T1 &in) {
+            const std::string_view text(in);
+            const char* begin = text.data();
+            const char* end = text.data() + text.length();
+            while (begin != end && isspace((unsigned char) *begin))
+            {
+                ++begin;
+            }
+            const bool negative = (begin != end && '-' == *begin);
+            if (begin != end && ('-' == *begin || '+' == *begin))
+            {
+                ++begin;
+            }
+            if (end - begin > 2 && '0' == begin[0] && ('x' == begin[1] || 'X' == begin[1]))
+            {
+                begin += 2;
+            }
+            uint64_t tmp = 0;
+            const std::from_chars_result result = std::from_chars(begin, end, tmp, 16);
+            if (std::errc::result_out_of_range == result.ec)
+            {
+                tmp = UINT64_MAX;
+            }
+            else if (std::errc() != result.ec)
+            {
+                return T2();
+            }
+            tmp = negative ? (0 - tmp) : tmp;
             T2 out;
-            uint64_t tmp;
-            std::stringstream ss;
-            ss << std::hex << in;
-            ss >> tmp;
             memcpy(&out, &tmp, sizeof(T2));
             return out;
         }
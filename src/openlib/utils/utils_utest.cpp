@@ -0,0 +1,115 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "utils.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+
+TEST_GROUP(utils)
+{
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(utils, Test_parse_int)
+{
+	int16_t value = 7;
+	CHECK(utils::parse_int(string("-32768"), value));
+	CHECK_EQUAL(-32768, value);
+	CHECK(utils::parse_int(string("32767"), value));
+	CHECK_EQUAL(32767, value);
+
+	//-Overflow, sign, trailing characters and empty text leave the value untouched
+	CHECK(!utils::parse_int(string("32768"), value));
+	CHECK(!utils::parse_int(string("12 "), value));
+	CHECK(!utils::parse_int(string("+1"), value));
+	CHECK(!utils::parse_int(string(""), value));
+	CHECK_EQUAL(32767, value);
+	uint8_t byte = 0;
+	CHECK(!utils::parse_int(string("-1"), byte));
+	CHECK(!utils::parse_int(string("256"), byte));
+	uint64_t wide = 0;
+	CHECK(utils::parse_int(string("18446744073709551615"), wide));
+	CHECK_EQUAL(UINT64_MAX, wide);
+	CHECK(!utils::parse_int(string("18446744073709551616"), wide));
+}
+
+TEST(utils, Test_parse_hex)
+{
+	uint32_t value = 0;
+	CHECK(utils::parse_hex(string("0xDEADbeef"), value));
+	CHECK_EQUAL(0xDEADBEEFu, value);
+	CHECK(utils::parse_hex(string("1f"), value));
+	CHECK_EQUAL(0x1Fu, value);
+	CHECK(!utils::parse_hex(string("0x100000000"), value));
+	CHECK(!utils::parse_hex(string("0x"), value));
+	CHECK(!utils::parse_hex(string("-1"), value));
+	CHECK(!utils::parse_hex(string("0xg"), value));
+	CHECK_EQUAL(0x1Fu, value);
+
+	//-Bit pattern of signed types
+	int8_t signed_value = 0;
+	CHECK(utils::parse_hex(string("FF"), signed_value));
+	CHECK_EQUAL(-1, signed_value);
+	CHECK(!utils::parse_hex(string("100"), signed_value));
+}
+
+TEST(utils, Test_format_int)
+{
+	char output[8];
+	CHECK_EQUAL(6u, utils::format_int(output, sizeof(output), (int32_t) -12345));
+	CHECK(0 == memcmp("-12345", output, 6));
+	CHECK_EQUAL(2u, utils::format_int(output, sizeof(output), (uint8_t) 0xAB, 16));
+	CHECK(0 == memcmp("ab", output, 2));
+	CHECK_EQUAL(0u, utils::format_int(output, 3, 1234));
+	STRCMP_EQUAL("-9223372036854775808", utils::format_int(INT64_MIN).c_str());
+	STRCMP_EQUAL("101", utils::format_int(5, 2).c_str());
+}
+
+TEST(utils, Test_convert)
+{
+	CHECK_EQUAL(0xABu, utils::convert<uint8_t>(string("AB")));
+	CHECK_EQUAL(-1, utils::convert<int8_t>(string("0xff")));
+	CHECK_EQUAL(0x1234, utils::convert<int16_t>(string(" 0x1234\n")));
+	CHECK_EQUAL(-2, utils::convert<int32_t>("-2"));
+	CHECK_EQUAL(0x34u, utils::convert<uint8_t>(string("1234")));
+	CHECK_EQUAL(0u, utils::convert<uint32_t>(string("xyz")));
+
+	//-Leading number, as read from a hex stream
+	CHECK_EQUAL(0x12u, utils::convert<uint32_t>(string("12 34")));
+	CHECK_EQUAL(0x12u, utils::convert<uint32_t>("12zz"));
+	CHECK_EQUAL(0x1Fu, utils::convert<uint32_t>("+1f"));
+	CHECK_EQUAL(-16, utils::convert<int32_t>(" -0x10"));
+	CHECK_EQUAL(0u, utils::convert<uint32_t>("0xg"));
+	CHECK_EQUAL(UINT64_MAX, utils::convert<uint64_t>("ffffffffffffffffff"));
+}
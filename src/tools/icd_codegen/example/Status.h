@@ -0,0 +1,106 @@
+/**
+ * Generated by icd_codegen from example.icd, do not edit
+ */
+#ifndef ICD_GENERATED_STATUS_H
+#define ICD_GENERATED_STATUS_H
+
+//-Supporting libraries
+#include "openlib/buffer/buffer_handler.h"
+#include "openlib/icd/struct/icd_field.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//-Namespace/s
+namespace icd_generated
+{
+    /**
+     * Status message
+     */
+    struct Status
+    {
+        //-Layout
+        typedef openlib::icd::ICDField<0, 0, 8, openlib::Endianess_BigEndian, uint8_t> id_field;
+        typedef openlib::icd::ICDField<1, 0, 16, openlib::Endianess_LittleEndian, int16_t> count_field;
+        typedef openlib::icd::ICDField<3, 0, 3, openlib::Endianess_BigEndian, uint8_t> flags_field;
+        typedef openlib::icd::ICDField<3, 3, 5, openlib::Endianess_BigEndian, int8_t> delta_field;
+        typedef openlib::icd::ICDField<4, 0, 20, openlib::Endianess_BigEndian, uint32_t> range_field;
+        typedef openlib::icd::ICDField<6, 4, 4, openlib::Endianess_BigEndian, uint32_t> mode_field;
+        static const size_t LENGTH = 11;
+
+        //-mode values
+        static const uint32_t mode_IDLE = 0;
+        static const uint32_t mode_RUN = 1;
+        static const uint32_t mode_FAULT = 2;
+        static const uint32_t mode_STOP = 9;
+
+        //-Values
+        uint8_t id;
+        int16_t count;
+        uint8_t flags;
+        int8_t delta;
+        uint32_t range;
+        uint32_t mode;
+        uint8_t payload[4];
+
+    }; /*struct Status*/
+
+    /**
+     * Decodes a Status message
+     * @param buffer The buffer from where to decode
+     * @param buffer_length The length of the buffer
+     * @param message (output) The message
+     * @return int containing the error code (@see openlib::buffer::Error, 0: SUCCESSS)
+     */
+    inline int decode(const void* buffer, const size_t buffer_length, Status& message)
+    {
+        if (NULL == buffer)
+        {
+            return openlib::buffer::ERROR_NULL_PARAMETER;
+        }
+        if (buffer_length < Status::LENGTH)
+        {
+            return openlib::buffer::ERROR_NOT_ENOUGH_DATA;
+        }
+        const uint8_t* buffer_ptr = (const uint8_t*) buffer;
+        message.id = openlib::buffer::extract_field<Status::id_field>(buffer_ptr);
+        message.count = openlib::buffer::extract_field<Status::count_field>(buffer_ptr);
+        message.flags = openlib::buffer::extract_field<Status::flags_field>(buffer_ptr);
+        message.delta = openlib::buffer::extract_field<Status::delta_field>(buffer_ptr);
+        message.range = openlib::buffer::extract_field<Status::range_field>(buffer_ptr);
+        message.mode = openlib::buffer::extract_field<Status::mode_field>(buffer_ptr);
+        memcpy(message.payload, buffer_ptr + 7, sizeof(message.payload));
+        return openlib::buffer::SUCCESS;
+    }
+
+    /**
+     * Encodes a Status message, bits not covered by a field are untouched
+     * @param message The message
+     * @param buffer The buffer where to encode
+     * @param buffer_length The length of the buffer
+     * @return int containing the error code (@see openlib::buffer::Error, 0: SUCCESSS)
+     */
+    inline int encode(const Status& message, void* buffer, const size_t buffer_length)
+    {
+        if (NULL == buffer)
+        {
+            return openlib::buffer::ERROR_NULL_PARAMETER;
+        }
+        if (buffer_length < Status::LENGTH)
+        {
+            return openlib::buffer::ERROR_NOT_ENOUGH_DATA;
+        }
+        uint8_t* buffer_ptr = (uint8_t*) buffer;
+        openlib::buffer::insert_field<Status::id_field>(buffer_ptr, message.id);
+        openlib::buffer::insert_field<Status::count_field>(buffer_ptr, message.count);
+        openlib::buffer::insert_field<Status::flags_field>(buffer_ptr, message.flags);
+        openlib::buffer::insert_field<Status::delta_field>(buffer_ptr, message.delta);
+        openlib::buffer::insert_field<Status::range_field>(buffer_ptr, message.range);
+        openlib::buffer::insert_field<Status::mode_field>(buffer_ptr, message.mode);
+        memcpy(buffer_ptr + 7, message.payload, sizeof(message.payload));
+        return openlib::buffer::SUCCESS;
+    }
+
+}; /*namespace icd_generated*/
+
+#endif /*ICD_GENERATED_STATUS_H*/
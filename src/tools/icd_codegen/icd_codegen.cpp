@@ -0,0 +1,90 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * ICD to C++ code generator
+ * Reads a declarative ICD definition and emits, per message, a header with a plain struct plus inlined
+ * encode/decode functions built on the compile time field kernels (@see openlib::icd::ICDField)
+ *
+ * Usage: icd_codegen <definition.icd> <output_directory> [namespace]
+ *
+ * Definition format (whitespace separated, '#' starts a comment):
+ *   message <Name>
+ *       field <name> <data_type> <byte_offset> <bit_offset> <num_bits> <BE|LE>
+ *           enum <value> <label>
+ *   end
+ */
+
+//-Supporting libraries
+#include "icd_codegen.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    using namespace openlib::codegen;
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <definition.icd> <output_directory> [namespace]" << std::endl;
+        return 1;
+    }
+    const std::string source = argv[1];
+    const std::string output_directory = argv[2];
+    const std::string name_space = (argc > 3) ? argv[3] : "icd_generated";
+    if (!is_identifier(name_space))
+    {
+        std::cerr << "Invalid namespace '" << name_space << "'" << std::endl;
+        return 1;
+    }
+
+    //-Read the definitions
+    std::ifstream input(source.c_str());
+    if (!input)
+    {
+        std::cerr << "Cannot open '" << source << "'" << std::endl;
+        return 1;
+    }
+    std::vector<MessageDefinition> messages;
+    std::string error;
+    if (!read_definitions(input, messages, error))
+    {
+        std::cerr << source << ": " << error << std::endl;
+        return 1;
+    }
+
+    //-One header per message
+    for (size_t i = 0; i < messages.size(); ++i)
+    {
+        const std::string file_name = output_directory + "/" + messages[i].name + ".h";
+        std::ofstream output(file_name.c_str());
+        if (!output)
+        {
+            std::cerr << "Cannot write '" << file_name << "'" << std::endl;
+            return 1;
+        }
+        write_header(messages[i], name_space, source, output);
+        std::cout << "Generated " << file_name << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,487 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * ICD to C++ code generator (@see icd_codegen.cpp)
+ */
+#ifndef OPENLIB_TOOLS_ICD_CODEGEN_H
+#define OPENLIB_TOOLS_ICD_CODEGEN_H
+
+//-Supporting libraries
+#include "openlib/common.h"
+#include "openlib/enum/endianess.h"
+#include "openlib/icd/enum/data_type.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//-Namespace/s
+namespace openlib
+{
+    namespace codegen
+    {
+        /**
+         * Enumeration entry of a field
+         */
+        struct EnumDefinition
+        {
+            uint32_t    value;
+            std::string label;
+        };
+
+        /**
+         * Field definition
+         */
+        struct FieldDefinition
+        {
+            std::string                 name;
+            openlib::icd::DataType      data_type;
+            size_t                      byte_offset;
+            size_t                      bit_offset;
+            size_t                      num_bits;
+            openlib::Endianess          endianess;
+            std::vector<EnumDefinition> enum_entries;
+        };
+
+        /**
+         * Message definition
+         */
+        struct MessageDefinition
+        {
+            std::string                     name;
+            std::vector<FieldDefinition>    fields;
+        };
+
+        /**
+         * Whether a string is a valid C++ identifier
+         * @param value The string
+         * @return true if valid
+         */
+        inline bool is_identifier(const std::string& value)
+        {
+            if (value.empty() || (!isalpha((unsigned char) value[0]) && '_' != value[0]))
+            {
+                return false;
+            }
+            for (size_t i = 1; i < value.length(); ++i)
+            {
+                if (!isalnum((unsigned char) value[i]) && '_' != value[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Parses an unsigned integer token
+         * @param token The token
+         * @param value (output) The value
+         * @return true if valid
+         */
+        inline bool parse_size(const std::string& token, size_t& value)
+        {
+            char* end = NULL;
+            const unsigned long long parsed = strtoull(token.c_str(), &end, 0);
+            if (token.empty() || '-' == token[0] || '\0' != *end)
+            {
+                return false;
+            }
+            value = (size_t) parsed;
+            return true;
+        }
+
+        /**
+         * C++ value type of a field
+         * @param field The field definition
+         * @return std::string containing the type
+         */
+        inline std::string value_type(const FieldDefinition& field)
+        {
+            using namespace openlib::icd;
+            switch (field.data_type)
+            {
+                case DataType_uint8  : return "uint8_t";
+                case DataType_int8   : return "int8_t";
+                case DataType_uint16 : return "uint16_t";
+                case DataType_int16  : return "int16_t";
+                case DataType_uint32 : return "uint32_t";
+                case DataType_int32  : return "int32_t";
+                case DataType_enum   : return "uint32_t";   //-Zero extended, as the runtime
+                case DataType_ascii  : return "char";
+                case DataType_binary : return "uint8_t";
+                default:
+                    return "";
+            }
+        }
+
+        /**
+         * Number of bits of the value type of an integral field
+         * @param field The field definition
+         * @return size_t containing the number of bits, 0 for byte arrays
+         */
+        inline size_t value_bits(const FieldDefinition& field)
+        {
+            using namespace openlib::icd;
+            switch (field.data_type)
+            {
+                case DataType_uint8  :
+                case DataType_int8   : return 8;
+                case DataType_uint16 :
+                case DataType_int16  : return 16;
+                case DataType_uint32 :
+                case DataType_int32  :
+                case DataType_enum   : return 32;
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * Reads the message definitions
+         * @param input The input stream
+         * @param messages (output) The message definitions
+         * @param error (output) The error description
+         * @return true on success
+         */
+        inline bool read_definitions(std::istream& input, std::vector<MessageDefinition>& messages, std::string& error)
+        {
+            std::string line;
+            size_t line_number = 0;
+            MessageDefinition* message = NULL;
+            while (std::getline(input, line))
+            {
+                ++line_number;
+                std::ostringstream where;
+                where << "line " << line_number << ": ";
+
+                //-Tokenize (comments stripped)
+                const size_t comment = line.find('#');
+                if (std::string::npos != comment)
+                {
+                    line.erase(comment);
+                }
+                std::istringstream line_stream(line);
+                std::vector<std::string> tokens;
+                std::string token;
+                while (line_stream >> token)
+                {
+                    tokens.push_back(token);
+                }
+                if (tokens.empty())
+                {
+                    continue;
+                }
+
+                if ("message" == tokens[0])
+                {
+                    if (NULL != message || 2 != tokens.size() || !is_identifier(tokens[1]))
+                    {
+                        error = where.str() + "expected 'message <Name>' outside a message";
+                        return false;
+                    }
+                    messages.push_back(MessageDefinition());
+                    message = &messages.back();
+                    message->name = tokens[1];
+                }
+                else if ("field" == tokens[0])
+                {
+                    FieldDefinition field;
+                    if (NULL == message || 7 != tokens.size() || !is_identifier(tokens[1]))
+                    {
+                        error = where.str() + "expected 'field <name> <data_type> <byte_offset> <bit_offset> <num_bits> <BE|LE>' within a message";
+                        return false;
+                    }
+                    field.name = tokens[1];
+                    field.data_type = openlib::icd::data_type_from_string(tokens[2]);
+                    if (openlib::icd::DataType_Undefined == field.data_type)
+                    {
+                        error = where.str() + "unknown data type '" + tokens[2] + "'";
+                        return false;
+                    }
+                    if (!parse_size(tokens[3], field.byte_offset) || !parse_size(tokens[4], field.bit_offset) || !parse_size(tokens[5], field.num_bits))
+                    {
+                        error = where.str() + "invalid offset/number of bits";
+                        return false;
+                    }
+                    if ("BE" == tokens[6])
+                    {
+                        field.endianess = openlib::Endianess_BigEndian;
+                    }
+                    else if ("LE" == tokens[6])
+                    {
+                        field.endianess = openlib::Endianess_LittleEndian;
+                    }
+                    else
+                    {
+                        error = where.str() + "endianess must be BE or LE";
+                        return false;
+                    }
+
+                    //-Layout checks (same as ICDField)
+                    field.byte_offset += BIT2BYTE(field.bit_offset);
+                    field.bit_offset %= 8;
+                    const size_t bits = value_bits(field);
+                    if (0 == field.num_bits || (0 != bits && field.num_bits > bits))
+                    {
+                        error = where.str() + "the number of bits does not fit the data type";
+                        return false;
+                    }
+                    if (0 == bits && 0 != field.num_bits % 8)
+                    {
+                        error = where.str() + "byte arrays must span whole bytes";
+                        return false;
+                    }
+                    if (0 != bits && openlib::Endianess_LittleEndian == field.endianess && field.num_bits > 8 && 0 != field.num_bits % 8)
+                    {
+                        error = where.str() + "little-endian fields must span whole bytes";
+                        return false;
+                    }
+                    for (size_t i = 0; i < message->fields.size(); ++i)
+                    {
+                        if (message->fields[i].name == field.name)
+                        {
+                            error = where.str() + "duplicated field '" + field.name + "'";
+                            return false;
+                        }
+                    }
+                    message->fields.push_back(field);
+                }
+                else if ("enum" == tokens[0])
+                {
+                    if (NULL == message || message->fields.empty() || openlib::icd::DataType_enum != message->fields.back().data_type ||
+                        3 != tokens.size() || !is_identifier(tokens[2]))
+                    {
+                        error = where.str() + "expected 'enum <value> <label>' after an enum field";
+                        return false;
+                    }
+                    //-Values are held by the field bits (zero extended)
+                    size_t value = 0;
+                    if (!parse_size(tokens[1], value) || 0 != (value >> message->fields.back().num_bits))
+                    {
+                        error = where.str() + "invalid enum value '" + tokens[1] + "' for the field";
+                        return false;
+                    }
+                    EnumDefinition entry;
+                    entry.value = (uint32_t) value;
+                    entry.label = tokens[2];
+                    message->fields.back().enum_entries.push_back(entry);
+                }
+                else if ("end" == tokens[0])
+                {
+                    if (NULL == message || 1 != tokens.size())
+                    {
+                        error = where.str() + "unexpected 'end'";
+                        return false;
+                    }
+                    message = NULL;
+                }
+                else
+                {
+                    error = where.str() + "unknown keyword '" + tokens[0] + "'";
+                    return false;
+                }
+            }
+
+            if (NULL != message)
+            {
+                error = "missing 'end' of message '" + message->name + "'";
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Writes the header of a message
+         * @param message The message definition
+         * @param name_space The namespace of the generated code
+         * @param source The definition file name (for reference)
+         * @param output The output stream
+         */
+        inline void write_header(const MessageDefinition& message, const std::string& name_space, const std::string& source, std::ostream& output)
+        {
+            std::string guard = name_space + "_" + message.name + "_H";
+            std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+            //-Message length
+            size_t length = 0;
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                length = std::max(length, field.byte_offset + (field.bit_offset + field.num_bits + 7) / 8);
+            }
+
+            output << "/**\n"
+                   << " * Generated by icd_codegen from " << source << ", do not edit\n"
+                   << " */\n"
+                   << "#ifndef " << guard << "\n"
+                   << "#define " << guard << "\n\n"
+                   << "//-Supporting libraries\n"
+                   << "#include \"openlib/buffer/buffer_handler.h\"\n"
+                   << "#include \"openlib/icd/struct/icd_field.h\"\n"
+                   << "#include <stddef.h>\n"
+                   << "#include <stdint.h>\n"
+                   << "#include <string.h>\n\n"
+                   << "//-Namespace/s\n"
+                   << "namespace " << name_space << "\n"
+                   << "{\n";
+
+            //-Struct
+            output << "    /**\n"
+                   << "     * " << message.name << " message\n"
+                   << "     */\n"
+                   << "    struct " << message.name << "\n"
+                   << "    {\n"
+                   << "        //-Layout\n";
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                if (0 != value_bits(field))
+                {
+                    output << "        typedef openlib::icd::ICDField<" << field.byte_offset << ", " << field.bit_offset << ", " << field.num_bits << ", "
+                           << ((openlib::Endianess_BigEndian == field.endianess) ? "openlib::Endianess_BigEndian" : "openlib::Endianess_LittleEndian") << ", "
+                           << value_type(field) << "> " << field.name << "_field;\n";
+                }
+            }
+            output << "        static const size_t LENGTH = " << length << ";\n";
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                if (!field.enum_entries.empty())
+                {
+                    output << "\n        //-" << field.name << " values\n";
+                    for (size_t j = 0; j < field.enum_entries.size(); ++j)
+                    {
+                        output << "        static const " << value_type(field) << " " << field.name << "_" << field.enum_entries[j].label << " = " << field.enum_entries[j].value << ";\n";
+                    }
+                }
+            }
+            output << "\n        //-Values\n";
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                output << "        " << value_type(field) << " " << field.name;
+                if (0 == value_bits(field))
+                {
+                    output << "[" << BIT2BYTE(field.num_bits) << "]";
+                }
+                output << ";\n";
+            }
+            output << "\n"
+                   << "    }; /*struct " << message.name << "*/\n\n";
+
+            //-Decode
+            output << "    /**\n"
+                   << "     * Decodes a " << message.name << " message\n"
+                   << "     * @param buffer The buffer from where to decode\n"
+                   << "     * @param buffer_length The length of the buffer\n"
+                   << "     * @param message (output) The message\n"
+                   << "     * @return int containing the error code (@see openlib::buffer::Error, 0: SUCCESSS)\n"
+                   << "     */\n"
+                   << "    inline int decode(const void* buffer, const size_t buffer_length, " << message.name << "& message)\n"
+                   << "    {\n"
+                   << "        if (NULL == buffer)\n"
+                   << "        {\n"
+                   << "            return openlib::buffer::ERROR_NULL_PARAMETER;\n"
+                   << "        }\n"
+                   << "        if (buffer_length < " << message.name << "::LENGTH)\n"
+                   << "        {\n"
+                   << "            return openlib::buffer::ERROR_NOT_ENOUGH_DATA;\n"
+                   << "        }\n"
+                   << "        const uint8_t* buffer_ptr = (const uint8_t*) buffer;\n";
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                if (0 != value_bits(field))
+                {
+                    output << "        message." << field.name << " = openlib::buffer::extract_field<" << message.name << "::" << field.name << "_field>(buffer_ptr);\n";
+                }
+                else if (0 == field.bit_offset)
+                {
+                    output << "        memcpy(message." << field.name << ", buffer_ptr + " << field.byte_offset << ", sizeof(message." << field.name << "));\n";
+                }
+                else
+                {
+                    output << "        for (size_t i = 0; i < sizeof(message." << field.name << "); ++i)\n"
+                           << "        {\n"
+                           << "            message." << field.name << "[i] = (" << value_type(field) << ") openlib::buffer::extract_raw(buffer_ptr, buffer_length, "
+                           << (BYTE2BIT(field.byte_offset) + field.bit_offset) << " + BYTE2BIT(i), 8);\n"
+                           << "        }\n";
+                }
+            }
+            output << "        return openlib::buffer::SUCCESS;\n"
+                   << "    }\n\n";
+
+            //-Encode
+            output << "    /**\n"
+                   << "     * Encodes a " << message.name << " message, bits not covered by a field are untouched\n"
+                   << "     * @param message The message\n"
+                   << "     * @param buffer The buffer where to encode\n"
+                   << "     * @param buffer_length The length of the buffer\n"
+                   << "     * @return int containing the error code (@see openlib::buffer::Error, 0: SUCCESSS)\n"
+                   << "     */\n"
+                   << "    inline int encode(const " << message.name << "& message, void* buffer, const size_t buffer_length)\n"
+                   << "    {\n"
+                   << "        if (NULL == buffer)\n"
+                   << "        {\n"
+                   << "            return openlib::buffer::ERROR_NULL_PARAMETER;\n"
+                   << "        }\n"
+                   << "        if (buffer_length < " << message.name << "::LENGTH)\n"
+                   << "        {\n"
+                   << "            return openlib::buffer::ERROR_NOT_ENOUGH_DATA;\n"
+                   << "        }\n"
+                   << "        uint8_t* buffer_ptr = (uint8_t*) buffer;\n";
+            for (size_t i = 0; i < message.fields.size(); ++i)
+            {
+                const FieldDefinition& field = message.fields[i];
+                if (0 != value_bits(field))
+                {
+                    output << "        openlib::buffer::insert_field<" << message.name << "::" << field.name << "_field>(buffer_ptr, message." << field.name << ");\n";
+                }
+                else if (0 == field.bit_offset)
+                {
+                    output << "        memcpy(buffer_ptr + " << field.byte_offset << ", message." << field.name << ", sizeof(message." << field.name << "));\n";
+                }
+                else
+                {
+                    output << "        for (size_t i = 0; i < sizeof(message." << field.name << "); ++i)\n"
+                           << "        {\n"
+                           << "            openlib::buffer::insert_raw(buffer_ptr, buffer_length, " << (BYTE2BIT(field.byte_offset) + field.bit_offset)
+                           << " + BYTE2BIT(i), 8, (uint8_t) message." << field.name << "[i]);\n"
+                           << "        }\n";
+                }
+            }
+            output << "        return openlib::buffer::SUCCESS;\n"
+                   << "    }\n\n"
+                   << "}; /*namespace " << name_space << "*/\n\n"
+                   << "#endif /*" << guard << "*/\n";
+        }
+
+    }; /*namespace codegen*/
+}; /*namespace openlib*/
+
+#endif /*OPENLIB_TOOLS_ICD_CODEGEN_H*/
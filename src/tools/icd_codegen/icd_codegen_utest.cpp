@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ * Copyright (c) 2022 Javier I. Acosta M.
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//-Supporting libraries
+#include "icd_codegen.h"
+#include "example/Status.h"
+#include "openlib/icd/message_icd.h"
+#include "openlib/icd/text_icd_parser.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+//-Used namespaces
+using namespace std;
+using namespace openlib;
+using namespace openlib::icd;
+using namespace openlib::codegen;
+
+static const size_t CODEGEN_MESSAGES = 500;
+
+/**
+ * Reads a file next to this one
+ * @param name The file name
+ * @return std::string containing the file, empty on error
+ */
+static string read_sibling(const string& name)
+{
+	const string path = __FILE__;
+	const size_t separator = path.find_last_of('/');
+	ifstream input(((string::npos == separator) ? name : path.substr(0, separator + 1) + name).c_str());
+	ostringstream content;
+	content << input.rdbuf();
+	return content.str();
+}
+
+TEST_GROUP(icd_codegen)
+{
+	vector<MessageDefinition> messages;
+	string definition;
+
+	void setup()
+	{
+		definition = read_sibling("example.icd");
+		istringstream input(definition);
+		string error;
+		CHECK(read_definitions(input, messages, error));
+		CHECK_EQUAL(1u, messages.size());
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(icd_codegen, Test_generated)
+{
+	//-The checked in header is the generator output of example.icd
+	ostringstream output;
+	write_header(messages[0], "icd_generated", "example.icd", output);
+	const string expected = read_sibling("example/Status.h");
+	CHECK(!expected.empty());
+	STRCMP_EQUAL(expected.c_str(), output.str().c_str());
+}
+
+TEST(icd_codegen, Test_decode)
+{
+	//-Same fields onto the runtime ICD (message/end lines dropped)
+	istringstream lines(definition);
+	string line;
+	string text;
+	while (getline(lines, line))
+	{
+		const size_t first = line.find_first_not_of(" \t");
+		if (string::npos != first && 0 != line.compare(first, 7, "message") && 0 != line.compare(first, 3, "end") && '#' != line[first])
+		{
+			text += line + "\n";
+		}
+	}
+	MessageICD message;
+	TextICDParser parser;
+	CHECK_EQUAL(ParserError_None, parser.parse(text, message));
+	CHECK_EQUAL(ParserError_None, message.compile());
+	CHECK_EQUAL(messages[0].fields.size(), message.size());
+	const DataDescriptor* id = message.field(message.find("id"));
+	const DataDescriptor* count = message.field(message.find("count"));
+	const DataDescriptor* flags = message.field(message.find("flags"));
+	const DataDescriptor* delta = message.field(message.find("delta"));
+	const DataDescriptor* range = message.field(message.find("range"));
+	const DataDescriptor* mode = message.field(message.find("mode"));
+	const DataDescriptor* payload = message.field(message.find("payload"));
+
+	//-Generated and runtime decode of the same bytes, enumerations with the top bit set included
+	srand(41);
+	for (size_t i = 0; i < CODEGEN_MESSAGES; ++i)
+	{
+		uint8_t buffer[icd_generated::Status::LENGTH];
+		for (size_t j = 0; j < sizeof(buffer); ++j)
+		{
+			buffer[j] = (uint8_t) rand();
+		}
+		if (0 == i)
+		{
+			buffer[6] = (uint8_t) ((buffer[6] & 0xF0) | icd_generated::Status::mode_STOP);
+		}
+		icd_generated::Status status;
+		CHECK_EQUAL(openlib::buffer::SUCCESS, icd_generated::decode(buffer, sizeof(buffer), status));
+		CHECK_EQUAL(ParserError_None, message.decode(buffer, sizeof(buffer)));
+
+		uint8_t value_u8 = 0;
+		int16_t value_i16 = 0;
+		int8_t value_i8 = 0;
+		uint32_t value_u32 = 0;
+		int value_enum = 0;
+		memcpy(&value_u8, id->data(), sizeof(value_u8));
+		CHECK_EQUAL(status.id, value_u8);
+		memcpy(&value_i16, count->data(), sizeof(value_i16));
+		CHECK_EQUAL(status.count, value_i16);
+		memcpy(&value_u8, flags->data(), sizeof(value_u8));
+		CHECK_EQUAL(status.flags, value_u8);
+		memcpy(&value_i8, delta->data(), sizeof(value_i8));
+		CHECK_EQUAL(status.delta, value_i8);
+		memcpy(&value_u32, range->data(), sizeof(value_u32));
+		CHECK_EQUAL(status.range, value_u32);
+		memcpy(&value_enum, mode->data(), sizeof(value_enum));
+		CHECK_EQUAL(status.mode, (uint32_t) value_enum);
+		MEMCMP_EQUAL(status.payload, payload->data(), sizeof(status.payload));
+	}
+	const uint32_t stop = icd_generated::Status::mode_STOP;
+	CHECK_EQUAL(9u, stop);
+}
+
+TEST(icd_codegen, Test_errors)
+{
+	//-Enumeration values are held by the field bits
+	vector<MessageDefinition> invalid;
+	string error;
+	istringstream negative("message M\n field mode enum 0 0 4 BE\n enum -1 LOST\nend\n");
+	CHECK(!read_definitions(negative, invalid, error));
+	invalid.clear();
+	istringstream wide("message M\n field mode enum 0 0 4 BE\n enum 16 LOST\nend\n");
+	CHECK(!read_definitions(wide, invalid, error));
+	invalid.clear();
+	istringstream top("message M\n field mode enum 0 0 4 BE\n enum 0xF LOST\nend\n");
+	CHECK(read_definitions(top, invalid, error));
+}